@@ -0,0 +1,56 @@
+// AlignedAllocator.h - STL allocator with explicit alignment (for SIMD-friendly columns)
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+template <typename T, size_t Alignment>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+    T *allocate(size_t n)
+    {
+        if (n == 0)
+            return nullptr;
+
+        void *p = nullptr;
+#ifdef _WIN32
+        p = _aligned_malloc(n * sizeof(T), Alignment);
+#else
+        if (posix_memalign(&p, Alignment, n * sizeof(T)) != 0)
+            p = nullptr;
+#endif
+        if (!p)
+            throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t)
+    {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        free(p);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const { return false; }
+};
@@ -1,7 +1,9 @@
 // DrawingWindow.cpp
 #include "DrawingWindow.h"
+#include "FigureRendering.h"
 #include "FigureCallback.h"
 #include <iostream>
+#include <algorithm> // Para std::min y std::max
 
 DrawingWindow::DrawingWindow(const WindowConfig &config, const std::string &name)
     : Window(config), figureComplete(false), isDrawing(false), figureName(name), currentColor(1.0f, 1.0f, 0.0f) // Default yellow
@@ -125,14 +127,25 @@ LRESULT DrawingWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM
         auto *renderer = GetRenderer();
         if (renderer)
         {
-            // Asegurar que el contexto OpenGL esté activo
-            wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
-
-            renderer->Render();
-            DrawLines();
-            DrawColorPicker();
-            // DrawRainbowBox() removed - rainbow functionality now only in color grid
-            renderer->SwapBuffers();
+            uint64_t sceneVersion = GetSceneVersion();
+            // Sin cambios desde el último frame no se dibuja ni se intercambian buffers:
+            // la composición del escritorio conserva la última imagen presentada
+            if (frameTracker.ShouldRender(sceneVersion))
+            {
+                FrameRecorder recorder = BeginFrameStats();
+
+                // Asegurar que el contexto OpenGL esté activo
+                renderer->MakeCurrent();
+
+                renderer->Render();
+                DrawLines();
+                DrawColorPicker();
+                // DrawRainbowBox() removed - rainbow functionality now only in color grid
+                EndFrameStats(recorder);
+                DrawStatsOverlay();
+                renderer->SwapBuffers();
+                frameTracker.MarkRendered(sceneVersion);
+            }
         }
 
         EndPaint(GetWindowHandle(), &ps);
@@ -150,11 +163,12 @@ LRESULT DrawingWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM
             if (renderer)
             {
                 // Asegurar que el contexto OpenGL esté activo
-                wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+                renderer->MakeCurrent();
                 glViewport(0, 0, width, height);
             }
         }
 
+        frameTracker.Invalidate();
         InvalidateRect(GetWindowHandle(), nullptr, FALSE);
         return 0;
     }
@@ -169,7 +183,7 @@ void DrawingWindow::OnMouseClick(int x, int y)
         return;
 
     HomogenVector glPoint = ScreenToOpenGL(x, y);
-    points.push_back(glPoint);
+    sketch.AddPoint(glPoint);
 
     std::wcout << L"Point added: (" << glPoint.x << L", " << glPoint.y << L")" << std::endl;
 
@@ -194,6 +208,7 @@ HomogenVector DrawingWindow::ScreenToOpenGL(int screenX, int screenY)
 
 void DrawingWindow::CheckFigureComplete()
 {
+    const auto &points = sketch.GetPoints();
     if (points.size() < 3)
         return;
 
@@ -213,6 +228,11 @@ void DrawingWindow::CheckFigureComplete()
     }
 }
 
+uint64_t DrawingWindow::GetSceneVersion() const
+{
+    return (std::max)(sketch.GetVersion(), paletteVersion.Get());
+}
+
 void DrawingWindow::DrawLines()
 {
     auto *renderer = GetRenderer();
@@ -220,40 +240,16 @@ void DrawingWindow::DrawLines()
         return;
 
     // Asegurar que el contexto OpenGL esté activo
-    wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
-
-    if (points.size() < 2)
-        return;
+    renderer->MakeCurrent();
 
     // Usar el color actual seleccionado
-    glColor3f(currentColor.r, currentColor.g, currentColor.b);
-    glLineWidth(2.0f);
-
-    glBegin(GL_LINE_STRIP);
-    for (const auto &point : points)
-    {
-        float glX, glY;
-        point.ToOpenGL(glX, glY);
-        glVertex2f(glX, glY);
-    }
-    glEnd();
-
-    // Dibujar puntos
-    glColor3f(currentColor.r, currentColor.g, currentColor.b);
-    glPointSize(5.0f);
-    glBegin(GL_POINTS);
-    for (const auto &point : points)
-    {
-        float glX, glY;
-        point.ToOpenGL(glX, glY);
-        glVertex2f(glX, glY);
-    }
-    glEnd();
+    RenderFigure(*GetRenderBackend(), *GetFigureBuffers(), sketch, currentColor, 2.0f, 5.0f);
 }
 
 void DrawingWindow::OnSaveButtonClick()
 {
     std::wcout << L"*** SAVE BUTTON CLICKED! ***" << std::endl;
+    const auto &points = sketch.GetPoints();
     std::wcout << L"Figure saved with " << points.size() << L" points:" << std::endl;
     for (size_t i = 0; i < points.size(); ++i)
     {
@@ -262,16 +258,16 @@ void DrawingWindow::OnSaveButtonClick()
     std::wcout << L"Figure color: (" << currentColor.r << L", " << currentColor.g << L", " << currentColor.b << L")" << std::endl;
 
     // Crear figura y notificar al callback
-    auto figure = std::make_shared<Figure>(figureName);
+    Figure figure(figureName);
     for (const auto &point : points)
     {
-        figure->AddPoint(point);
+        figure.AddPoint(point);
     }
-    figure->SetComplete(true);
-    figure->SetColor(currentColor);
+    figure.SetComplete(true);
+    figure.SetColor(currentColor);
 
     // Notificar que la figura está completa
-    FigureManager::NotifyFigureComplete(figure);
+    FigureManager::NotifyFigureComplete(std::move(figure));
 
     // Cerrar la ventana de dibujo
     PostMessage(GetWindowHandle(), WM_CLOSE, 0, 0);
@@ -280,6 +276,7 @@ void DrawingWindow::OnSaveButtonClick()
 void DrawingWindow::OnColorButtonClick(const Color &color)
 {
     currentColor = color;
+    paletteVersion.Touch();
 
     // Check if the selected color is the rainbow color from the grid
     Color rainbowColor = GetRainbowColor(0.0f);
@@ -304,76 +301,23 @@ void DrawingWindow::DrawColorPicker()
         return;
 
     // Asegurar que el contexto OpenGL esté activo
-    wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+    renderer->MakeCurrent();
 
 
     // Get window dimensions for coordinate conversion
     RECT rect;
     GetClientRect(GetWindowHandle(), &rect);
 
-    // Draw color buttons backgrounds (synchronized with Windows buttons)
-    int buttonSize = 25;
-    int margin = 5;
-    int startX = rect.right - (5 * buttonSize + 6 * margin) - 1;
-    int startY = rect.bottom - (4 * buttonSize + 5 * margin) - 150;
-
-    for (size_t i = 0; i < colorButtons.size() && i < colors.size(); ++i)
-    {
-        Color buttonColor = colors[i];
-
-        // Calculate position for this color button
-        int row = i / 5;
-        int col = i % 5;
-        int x = startX + col * (buttonSize + margin);
-        int y = startY + row * (buttonSize + margin);
-
-        // Convert button coordinates to OpenGL
-        float glX = (2.0f * x / rect.right) - 1.0f;
-        float glY = 1.0f - (2.0f * y / rect.bottom);
-        float glWidth = (2.0f * buttonSize / rect.right);
-        float glHeight = (2.0f * buttonSize / rect.bottom);
-
-        // Draw filled rectangle
-        glColor3f(buttonColor.r, buttonColor.g, buttonColor.b);
-        glBegin(GL_QUADS);
-        glVertex2f(glX, glY);
-        glVertex2f(glX + glWidth, glY);
-        glVertex2f(glX + glWidth, glY - glHeight);
-        glVertex2f(glX, glY - glHeight);
-        glEnd();
-
-        // Draw black border if not selected color
-        if (buttonColor.r != currentColor.r || buttonColor.g != currentColor.g || buttonColor.b != currentColor.b)
-        {
-            glColor3f(0.0f, 0.0f, 0.0f);
-            glBegin(GL_LINE_LOOP);
-            glVertex2f(glX, glY);
-            glVertex2f(glX + glWidth, glY);
-            glVertex2f(glX + glWidth, glY - glHeight);
-            glVertex2f(glX, glY - glHeight);
-            glEnd();
-        }
-        else
-        {
-            // Draw white border for selected color
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glLineWidth(3.0f);
-            glBegin(GL_LINE_LOOP);
-            glVertex2f(glX, glY);
-            glVertex2f(glX + glWidth, glY);
-            glVertex2f(glX + glWidth, glY - glHeight);
-            glVertex2f(glX, glY - glHeight);
-            glEnd();
-        }
-    }
+    RenderColorPicker(*GetRenderBackend(), colors, colorButtons.size(), currentColor, rect.right, rect.bottom);
 }
 
 
 void DrawingWindow::ClearDrawing()
 {
-    points.clear();
+    sketch.Clear();
     figureComplete = false;
     currentColor = Color(1.0f, 1.0f, 0.0f); // Reset to default yellow
+    paletteVersion.Touch();
     saveButton->Hide();
     instructionLabel->SetText(L"Dibuja tu figura");
     InvalidateRect(GetWindowHandle(), nullptr, FALSE);
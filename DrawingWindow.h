@@ -13,7 +13,7 @@
 class DrawingWindow : public Window
 {
 private:
-    std::vector<HomogenVector> points;
+    Figure sketch; // Puntos en curso; su buffer de vértices se actualiza solo al añadir puntos
     std::unique_ptr<Button> saveButton;
     std::unique_ptr<Label> instructionLabel;
     std::vector<Color> colors;
@@ -23,6 +23,7 @@ private:
 
     // Color picker functionality
     Color currentColor;
+    SceneVersion paletteVersion; // Selección de la paleta
     std::vector<std::unique_ptr<Button>> colorButtons;
 
     void OnMouseClick(int x, int y);
@@ -33,6 +34,9 @@ private:
     void DrawColorPicker();
     HomogenVector ScreenToOpenGL(int screenX, int screenY);
 
+protected:
+    uint64_t GetSceneVersion() const override;
+
 public:
     DrawingWindow(const WindowConfig& config, const std::string& name = "Figure");
     ~DrawingWindow() = default;
@@ -40,7 +44,7 @@ public:
     bool Create() override;
     LRESULT HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) override;
 
-    std::vector<HomogenVector> GetPoints() const { return points; }
+    const PointList &GetPoints() const { return sketch.GetPoints(); }
     Color GetCurrentColor() const { return currentColor; }
     void ClearDrawing();
     void SetFigureName(const std::string& name) { figureName = name; }
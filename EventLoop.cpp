@@ -0,0 +1,50 @@
+// EventLoop.cpp
+#include "EventLoop.h"
+#include "FrameScheduler.h"
+#include "GLContextManager.h"
+#include "Window.h"
+#include <vector>
+
+int EventLoop::Run()
+{
+    FrameScheduler &scheduler = FrameScheduler::Main();
+    std::vector<FrameTarget> targets;
+    MSG msg = {};
+
+    while (Window::GetLiveWindowCount() > 0)
+    {
+        // Dormir hasta que llegue un mensaje o toque el próximo frame
+        int64_t waitMicroseconds = scheduler.GetWaitMicroseconds();
+        DWORD timeout = waitMicroseconds == FrameScheduler::WAIT_FOREVER
+                            ? INFINITE
+                            : static_cast<DWORD>((waitMicroseconds + 999) / 1000);
+        if (timeout > 0)
+        {
+            MsgWaitForMultipleObjectsEx(0, nullptr, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        }
+
+        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            if (msg.message == WM_QUIT)
+                return static_cast<int>(msg.wParam);
+
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+
+        // Solo se dibuja lo que pidió un frame desde el último tick
+        if (scheduler.TakeDueFrame(targets))
+        {
+            for (FrameTarget target : targets)
+            {
+                auto *window = static_cast<Window *>(const_cast<void *>(target));
+                RedrawWindow(window->GetWindowHandle(), nullptr, nullptr, RDW_INVALIDATE | RDW_UPDATENOW);
+            }
+
+            // Cambios de contexto de este frame (con un contexto por ventana: uno por ventana dibujada)
+            GLContextManager::Main().EndFrame();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+// EventLoop.h - Event-driven message loop: blocks while idle, draws at the FrameScheduler's pace
+#pragma once
+#include <windows.h>
+
+class EventLoop
+{
+public:
+    // Procesa mensajes hasta WM_QUIT o hasta que no quede ninguna ventana abierta.
+    // Sin mensajes ni frames pendientes el hilo queda bloqueado (sin consumo de CPU).
+    static int Run();
+};
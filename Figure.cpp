@@ -1,25 +1,424 @@
 // Figure.cpp
 #include "Figure.h"
+#include "TransformKernels.h"
+#include "FrameStats.h"
+#include "SceneVersion.h"
+#include <atomic>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> nextFigureId(1);
+}
+
+// ---------------------------------------------------------------------------
+// SharedPointData
+// ---------------------------------------------------------------------------
+
+Figure::PointData *Figure::SharedPointData::NewBlock(const PointData *source)
+{
+    void *memory = AllocatePointBlock(sizeof(PointData));
+    try
+    {
+        return source ? new (memory) PointData(*source) : new (memory) PointData();
+    }
+    catch (...)
+    {
+        FreePointBlock(memory, sizeof(PointData));
+        throw;
+    }
+}
+
+Figure::SharedPointData::SharedPointData(const SharedPointData &other) : block(other.block)
+{
+    // Quien copia ya tiene una referencia: el bloque no puede desaparecer mientras tanto
+    if (block)
+        block->owners.fetch_add(1, std::memory_order_relaxed);
+}
+
+Figure::SharedPointData &Figure::SharedPointData::operator=(const SharedPointData &other)
+{
+    if (other.block)
+        other.block->owners.fetch_add(1, std::memory_order_relaxed);
+    Release();
+    block = other.block;
+    return *this;
+}
+
+Figure::SharedPointData &Figure::SharedPointData::operator=(SharedPointData &&other)
+{
+    if (this != &other)
+    {
+        Release();
+        block = other.block;
+        other.block = nullptr;
+    }
+    return *this;
+}
+
+void Figure::SharedPointData::Release()
+{
+    if (block && block->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        block->~PointData();
+        FreePointBlock(block, sizeof(PointData));
+    }
+    block = nullptr;
+}
+
+const Figure::PointData &Figure::SharedPointData::Read() const
+{
+    static const PointData empty;
+    return block ? *block : empty;
+}
+
+bool Figure::SharedPointData::IsUnique() const
+{
+    return block && block->owners.load(std::memory_order_acquire) == 1;
+}
+
+Figure::PointData &Figure::SharedPointData::Write()
+{
+    if (!block)
+        block = NewBlock(nullptr);
+    else if (!IsUnique())
+    {
+        PointData *copy = NewBlock(block);
+        Release();
+        block = copy;
+    }
+    return *block;
+}
+
+void Figure::SharedPointData::Reset()
+{
+    Release();
+}
+
+// ---------------------------------------------------------------------------
+// Figure
+// ---------------------------------------------------------------------------
 
 Figure::Figure(const std::string& figureName)
-    : name(figureName), isComplete(false), figureColor(1.0f, 1.0f, 0.0f) // Default yellow
+    : id(nextFigureId++), pointsVersion(NextSceneVersion()), version(pointsVersion), storageMode(PointStorageMode::Interleaved), name(figureName), isComplete(false),
+      figureColor(1.0f, 1.0f, 0.0f), // Default yellow
+      modelKind(TransformKind::Translation), sumX(0.0), sumY(0.0), transformedStatsVersion(0)
+{
+}
+
+void Figure::MarkPointsChanged()
+{
+    pointsVersion = NextSceneVersion();
+    version = pointsVersion;
+    transformed.dirty = true;
+    interleaved.dirty = true;
+}
+
+void Figure::SetColor(const Color& color)
+{
+    figureColor = color;
+    version = NextSceneVersion();
+}
+
+void Figure::IncludeInStats(const HomogenVector& point)
 {
+    float glX, glY;
+    point.ToOpenGL(glX, glY);
+    bounds.Include(glX, glY);
+    sumX += glX;
+    sumY += glY;
+}
+
+void Figure::RecomputeStats()
+{
+    bounds = FigureBounds();
+    sumX = 0.0;
+    sumY = 0.0;
+    size_t count = GetPointCount();
+    for (size_t i = 0; i < count; ++i)
+    {
+        IncludeInStats(GetPoint(i));
+    }
 }
 
 void Figure::AddPoint(const HomogenVector& point)
 {
-    points.push_back(point);
+    PointData &stored = data.Write();
+    if (storageMode == PointStorageMode::Columnar)
+        stored.columns.Add(point);
+    else
+    {
+        if (stored.points.capacity() == 0)
+            stored.points.reserve(POINT_LIST_MIN_CAPACITY);
+        stored.points.push_back(point);
+    }
+    IncludeInStats(point);
+    MarkPointsChanged();
 }
 
 void Figure::AddPoint(float x, float y)
 {
-    points.emplace_back(x, y, 1);
+    AddPoint(HomogenVector(x, y, 1));
+}
+
+void Figure::AddPoints(const HomogenVector* newPoints, size_t count)
+{
+    if (count == 0)
+        return;
+
+    PointData &stored = data.Write();
+    if (storageMode == PointStorageMode::Columnar)
+    {
+        stored.columns.Reserve(stored.columns.Size() + count);
+        for (size_t i = 0; i < count; ++i)
+            stored.columns.Add(newPoints[i]);
+    }
+    else
+    {
+        stored.points.insert(stored.points.end(), newPoints, newPoints + count);
+    }
+    for (size_t i = 0; i < count; ++i)
+        IncludeInStats(newPoints[i]);
+    MarkPointsChanged();
+}
+
+const PointList& Figure::GetPoints() const
+{
+    if (storageMode == PointStorageMode::Interleaved)
+        return data.Read().points;
+
+    if (interleaved.dirty)
+    {
+        data.Read().columns.ToInterleaved(interleaved.points);
+        interleaved.dirty = false;
+    }
+    return interleaved.points;
+}
+
+HomogenVector Figure::GetPoint(size_t index) const
+{
+    if (storageMode == PointStorageMode::Columnar)
+        return data.Read().columns.Get(index);
+    return data.Read().points[index];
+}
+
+void Figure::WriteOpenGLVertices(float* xy) const
+{
+    if (storageMode == PointStorageMode::Columnar)
+    {
+        data.Read().columns.ToOpenGL(xy);
+        return;
+    }
+
+    const PointList &points = data.Read().points;
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i].ToOpenGL(xy[i * 2], xy[i * 2 + 1]);
+}
+
+size_t Figure::GetPointCount() const
+{
+    if (storageMode == PointStorageMode::Columnar)
+        return data.Read().columns.Size();
+    return data.Read().points.size();
+}
+
+void Figure::SetStorageMode(PointStorageMode mode)
+{
+    if (mode == storageMode)
+        return;
+
+    PointData &stored = data.Write();
+    if (mode == PointStorageMode::Columnar)
+    {
+        stored.columns.FromInterleaved(stored.points);
+        PointList().swap(stored.points);
+    }
+    else
+    {
+        stored.columns.ToInterleaved(stored.points);
+        stored.columns.Clear();
+        stored.columns.ShrinkToFit();
+    }
+    PointList().swap(interleaved.points);
+
+    storageMode = mode;
+    MarkPointsChanged();
+}
+
+size_t Figure::GetStorageBytes() const
+{
+    if (storageMode == PointStorageMode::Columnar)
+        return data.Read().columns.GetStorageBytes();
+    return data.Read().points.capacity() * sizeof(HomogenVector);
+}
+
+void Figure::ApplyTransform(const TransformMatrix& transform)
+{
+    ComposeTransform(transform, transform.GetKind());
+}
+
+void Figure::ComposeTransform(const TransformMatrix& transform, TransformKind kind)
+{
+    // La nueva transformación se aplica después de las anteriores
+    modelMatrix = transform * modelMatrix;
+    modelKind = WidestTransformKind(modelKind, kind);
+    transformed.dirty = true;
+    version = NextSceneVersion();
+}
+
+void Figure::ResetTransform()
+{
+    modelMatrix = TransformMatrix::Identity();
+    modelKind = TransformKind::Translation;
+    transformed.points.clear();
+    transformed.dirty = true;
+    version = NextSceneVersion();
+}
+
+const PointList& Figure::GetTransformedPoints() const
+{
+    if (modelMatrix.IsIdentity())
+        return GetPoints();
+
+    if (transformed.dirty)
+    {
+        ScopedTransformTimer timer;
+        const PointColumns &columns = data.Read().columns;
+        PointList &transformedPoints = transformed.points;
+        if (storageMode == PointStorageMode::Columnar)
+        {
+            // Leer solo las columnas necesarias (sin w cuando todos valen 1 y la matriz es afín)
+            size_t count = columns.Size();
+            bool writeW = columns.HasW() || !modelMatrix.IsAffine();
+            FloatColumn outX(count), outY(count), outW(writeW ? count : 0);
+            TransformColumnsParallel(modelMatrix, modelKind, columns.X(), columns.Y(), columns.W(),
+                                     outX.data(), outY.data(), writeW ? outW.data() : nullptr, count);
+
+            transformedPoints.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                transformedPoints[i].x = outX[i];
+                transformedPoints[i].y = outY[i];
+                transformedPoints[i].w = writeW ? outW[i] : 1.0f;
+            }
+        }
+        else
+        {
+            const PointList &points = data.Read().points;
+            transformedPoints.resize(points.size());
+            TransformPointsParallel(modelMatrix, modelKind, points.data(), transformedPoints.data(), points.size());
+        }
+        transformed.dirty = false;
+    }
+    return transformed.points;
+}
+
+void Figure::BakeTransform()
+{
+    if (modelMatrix.IsIdentity())
+        return;
+
+    ScopedTransformTimer timer;
+    PointData &stored = data.Write();
+    PointColumns &columns = stored.columns;
+    if (storageMode == PointStorageMode::Columnar)
+    {
+        // Una proyectiva cambia w: la columna tiene que existir para guardarlo
+        float *ws = modelMatrix.IsAffine() ? columns.W() : columns.EnsureW();
+        TransformColumnsParallel(modelMatrix, modelKind, columns.X(), columns.Y(), ws, columns.X(), columns.Y(), ws, columns.Size());
+    }
+    else
+        TransformPointsParallel(modelMatrix, modelKind, stored.points.data(), stored.points.data(), stored.points.size());
+
+    ResetTransform();
+    RecomputeStats();
+    MarkPointsChanged();
 }
 
 void Figure::Clear()
 {
-    points.clear();
+    if (data.IsUnique())
+    {
+        PointData &stored = data.Write();
+        stored.points.clear();
+        stored.columns.Clear();
+    }
+    else
+    {
+        data.Reset(); // Sin copiar lo que se va a borrar
+    }
     isComplete = false;
     figureColor = Color(1.0f, 1.0f, 0.0f); // Reset to default yellow
+    ResetTransform();
+    RecomputeStats();
+    MarkPointsChanged();
+}
+
+HomogenVector Figure::GetCentroid() const
+{
+    size_t count = GetPointCount();
+    if (count == 0)
+        return HomogenVector(0.0f, 0.0f);
+    return HomogenVector(static_cast<float>(sumX / count), static_cast<float>(sumY / count));
 }
 
+void Figure::UpdateTransformedStats() const
+{
+    if (transformedStatsVersion == version)
+        return;
+
+    transformedBounds = FigureBounds();
+    double transformedSumX = 0.0, transformedSumY = 0.0;
+    const PointList &points = GetTransformedPoints();
+    for (const auto &point : points)
+    {
+        float glX, glY;
+        point.ToOpenGL(glX, glY);
+        transformedBounds.Include(glX, glY);
+        transformedSumX += glX;
+        transformedSumY += glY;
+    }
+    if (points.empty())
+        transformedCentroid = HomogenVector(0.0f, 0.0f);
+    else
+        transformedCentroid = HomogenVector(static_cast<float>(transformedSumX / points.size()),
+                                            static_cast<float>(transformedSumY / points.size()));
+    transformedStatsVersion = version;
+}
+
+HomogenVector Figure::GetTransformedCentroid() const
+{
+    // Con w' que depende del punto, la media ya no conmuta con la transformación
+    if (!modelMatrix.IsAffine())
+    {
+        UpdateTransformedStats();
+        return transformedCentroid;
+    }
+
+    // Afín: la media de los puntos transformados es la transformación de la media
+    HomogenVector centroid = modelMatrix.Apply(GetCentroid());
+    float glX, glY;
+    centroid.ToOpenGL(glX, glY);
+    return HomogenVector(glX, glY);
+}
+
+FigureBounds Figure::GetTransformedBounds() const
+{
+    if (bounds.IsEmpty() || modelMatrix.IsIdentity())
+        return bounds;
+
+    const float (&m)[3][3] = modelMatrix.m;
+    bool axisAligned = m[0][1] == 0.0f && m[1][0] == 0.0f &&
+                       m[2][0] == 0.0f && m[2][1] == 0.0f && m[2][2] == 1.0f;
+    if (axisAligned)
+    {
+        // Traslación y escala: las esquinas transformadas siguen siendo la caja exacta
+        FigureBounds result;
+        result.Include(m[0][0] * bounds.minX + m[0][2], m[1][1] * bounds.minY + m[1][2]);
+        result.Include(m[0][0] * bounds.maxX + m[0][2], m[1][1] * bounds.maxY + m[1][2]);
+        return result;
+    }
+
+    UpdateTransformedStats();
+    return transformedBounds;
+}
@@ -1,33 +1,200 @@
 // Figure.h - Figure class for storing and managing geometric figures
 #pragma once
 #include "HomogenVector.h"
+#include "TransformMatrix.h"
+#include "PointColumns.h"
+#include "PointPool.h"
 #include "Color.h"
+#include "SceneVersion.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 
+// Interleaved: vector<HomogenVector> (x, y, w juntos). Columnar: columnas x / y / w separadas.
+enum class PointStorageMode
+{
+    Interleaved,
+    Columnar
+};
+
+// Las figuras importadas o cargadas de una biblioteca con al menos tantos puntos se guardan por
+// columnas: 8 bytes por punto en vez de 12, y las transformaciones y las subidas de vértices leen
+// solo x e y
+const size_t COLUMNAR_STORAGE_MIN_POINTS = 64 * 1024;
+
+// Caja envolvente en coordenadas OpenGL (x/w, y/w). Vacía mientras no haya puntos.
+struct FigureBounds
+{
+    float minX = (std::numeric_limits<float>::max)();
+    float minY = (std::numeric_limits<float>::max)();
+    float maxX = (std::numeric_limits<float>::lowest)();
+    float maxY = (std::numeric_limits<float>::lowest)();
+
+    bool IsEmpty() const { return minX > maxX; }
+    float GetWidth() const { return IsEmpty() ? 0.0f : maxX - minX; }
+    float GetHeight() const { return IsEmpty() ? 0.0f : maxY - minY; }
+    float GetCenterX() const { return (minX + maxX) / 2.0f; }
+    float GetCenterY() const { return (minY + maxY) / 2.0f; }
+
+    void Include(float x, float y)
+    {
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+};
+
 class Figure
 {
 private:
-    std::vector<HomogenVector> points;
+    uint64_t id;
+    uint64_t pointsVersion; // Cambia cuando cambian los puntos almacenados
+    uint64_t version;       // Cambia con los puntos, la transformación o el color
+
+    // Puntos almacenados. Las copias de una Figure comparten este bloque (copiar una figura es
+    // O(1) en puntos) y quien va a modificarlo se hace antes su propia copia si otra figura
+    // también lo tiene (copy-on-write), así que una copia es una versión inmutable de la figura.
+    struct PointData
+    {
+        PointList points;     // Modo Interleaved
+        PointColumns columns; // Modo Columnar
+        std::atomic<uint32_t> owners;
+
+        PointData() : owners(1) {}
+        PointData(const PointData &other) : points(other.points), columns(other.columns), owners(1) {}
+    };
+
+    // Referencia contada a un PointData. El contador va dentro del bloque, que sale del PointPool:
+    // sin bloque de control aparte, y una figura vacía no tiene bloque. Las copias pueden vivir en
+    // otros hilos (snapshots de render): soltar una es release y Write mira el contador con acquire,
+    // así que lo que otro hilo leyó del bloque antes de soltarlo ocurre antes de que se modifique.
+    class SharedPointData
+    {
+    private:
+        PointData *block;
+
+        static PointData *NewBlock(const PointData *source); // nullptr: bloque vacío
+        void Release();
+
+    public:
+        SharedPointData() : block(nullptr) {}
+        SharedPointData(const SharedPointData &other);
+        SharedPointData(SharedPointData &&other) : block(other.block) { other.block = nullptr; }
+        SharedPointData &operator=(const SharedPointData &other);
+        SharedPointData &operator=(SharedPointData &&other);
+        ~SharedPointData() { Release(); }
+
+        const PointData &Read() const; // Un PointData vacío si no hay bloque
+        PointData &Write();            // Antes de cualquier cambio: copia propia si está compartido
+        bool IsUnique() const;
+        void Reset(); // Suelta el bloque sin copiarlo: la figura queda sin puntos
+        bool operator==(const SharedPointData &other) const { return block == other.block; }
+    };
+    SharedPointData data;
+    PointStorageMode storageMode;
     std::string name;
     bool isComplete;
     Color figureColor;
 
+    // Transformación acumulada; los puntos originales no se tocan hasta BakeTransform()
+    TransformMatrix modelMatrix;
+    TransformKind modelKind; // Forma acumulada de las transformaciones aplicadas: elige el kernel
+    void ComposeTransform(const TransformMatrix &transform, TransformKind kind);
+    // Puntos derivados bajo demanda; no se copian con la figura, la copia los recalcula si los usa
+    struct DerivedPoints
+    {
+        PointList points;
+        bool dirty = true;
+
+        DerivedPoints() = default;
+        DerivedPoints(const DerivedPoints &) {}
+        DerivedPoints(DerivedPoints &&) = default;
+        DerivedPoints &operator=(const DerivedPoints &)
+        {
+            PointList().swap(points);
+            dirty = true;
+            return *this;
+        }
+        DerivedPoints &operator=(DerivedPoints &&) = default;
+    };
+    mutable DerivedPoints transformed;
+    mutable DerivedPoints interleaved; // Copia entrelazada de las columnas en modo Columnar
+
+    // Estadísticas de los puntos sin transformar, mantenidas en AddPoint (O(1))
+    FigureBounds bounds;
+    double sumX, sumY; // Para el centroide
+    // Caja transformada exacta cuando la transformación rota, y centroide transformado cuando es
+    // proyectiva: se calculan juntos de los puntos transformados, una vez por versión
+    mutable FigureBounds transformedBounds;
+    mutable HomogenVector transformedCentroid;
+    mutable uint64_t transformedStatsVersion;
+
+    void MarkPointsChanged();
+    void IncludeInStats(const HomogenVector &point);
+    void RecomputeStats();
+    void UpdateTransformedStats() const;
+
 public:
     Figure(const std::string &figureName = "Figure");
 
     void AddPoint(const HomogenVector &point);
     void AddPoint(float x, float y);
+    void AddPoints(const HomogenVector *newPoints, size_t count); // Una sola versión nueva para todos
     void SetComplete(bool complete) { isComplete = complete; }
-    void SetColor(const Color &color) { figureColor = color; }
+    void SetColor(const Color &color);
 
-    std::vector<HomogenVector> &GetPoints() { return points; }
-    std::string GetName() const { return name; }
+    const PointList &GetPoints() const; // En modo Columnar construye (una vez por versión) una copia entrelazada
+    HomogenVector GetPoint(size_t index) const;
+    // GetPointCount() pares (x/w, y/w) en xy, para subirlos como vértices; en modo Columnar se
+    // leen las columnas directamente, sin la copia entrelazada
+    void WriteOpenGLVertices(float *xy) const;
+    const std::string &GetName() const { return name; }
     bool IsComplete() const { return isComplete; }
-    size_t GetPointCount() const { return points.size(); }
+    size_t GetPointCount() const;
     Color GetColor() const { return figureColor; }
 
+    // Almacenamiento de puntos: cambiar de modo convierte los datos existentes
+    void SetStorageMode(PointStorageMode mode);
+    PointStorageMode GetStorageMode() const { return storageMode; }
+    const PointColumns &GetColumns() const { return data.Read().columns; } // Solo en modo Columnar
+    size_t GetStorageBytes() const;
+
+    // Transformaciones: O(1) por operación, los puntos se calculan al dibujar/exportar
+    void ApplyTransform(const TransformMatrix &transform);
+    // Translate2D, Scale2D, Rotate2D, ... (Transforms2D.h): la forma la da el tipo, y los puntos se
+    // transforman con el kernel de la composición (una traslación sola, sumas; una escala, productos)
+    template <typename Transform>
+    void ApplyTransform(const Transform &transform) { ComposeTransform(transform.ToMatrix(), Transform::Kind()); }
+    void ResetTransform();
+    const TransformMatrix &GetTransform() const { return modelMatrix; }
+    TransformKind GetTransformKind() const { return modelKind; }
+    const PointList &GetTransformedPoints() const;
+    void BakeTransform();
+
+    // Caja y centroide (media de los puntos) en O(1). Transformados: la caja es exacta; con
+    // traslaciones y escalas se obtiene de las esquinas y con rotaciones se recalcula una vez por
+    // versión. El centroide transformado es O(1) con transformaciones afines (la media de los
+    // puntos transformados es la transformada de la media); con una proyectiva no lo es, y se
+    // recalcula una vez por versión.
+    const FigureBounds &GetBounds() const { return bounds; }
+    FigureBounds GetTransformedBounds() const;
+    HomogenVector GetCentroid() const;
+    HomogenVector GetTransformedCentroid() const;
+
+    // Identificador único y versiones, para cachés externas (buffers de GPU, etc.).
+    // Las versiones salen de NextSceneVersion(): crecen con cualquier cambio de cualquier figura.
+    uint64_t GetId() const { return id; }
+    uint64_t GetPointsVersion() const { return pointsVersion; }
+    uint64_t GetVersion() const { return version; }
+    // Nueva versión sin cambiar el contenido (p. ej. al restaurar una copia anterior)
+    void TouchVersion() { version = NextSceneVersion(); }
+    // true si esta figura y other comparten los puntos almacenados (ninguna los cambió tras copiarse)
+    bool SharesPointsWith(const Figure &other) const { return data == other.data; }
+
     void Clear();
     void SetName(const std::string &newName) { name = newName; }
 };
-
@@ -0,0 +1,123 @@
+// FigureBufferCache.cpp
+#include "FigureBufferCache.h"
+
+FigureBufferCache::FigureBufferCache(IVertexBufferBackend &vertexBackend)
+    : backend(vertexBackend), bufferCount(0), uploadCount(0)
+{
+}
+
+FigureBufferCache::~FigureBufferCache()
+{
+    Clear();
+}
+
+FigureBuffer FigureBufferCache::Prepare(const Figure &figure)
+{
+    std::vector<Entry> &versions = entries[figure.GetId()];
+    uint64_t pointsVersion = figure.GetPointsVersion();
+
+    Entry *entry = nullptr;
+    Entry *reusable = nullptr;
+    for (auto &candidate : versions)
+    {
+        if (candidate.pointsVersion == pointsVersion)
+        {
+            entry = &candidate;
+            break;
+        }
+        if (!candidate.used && !reusable)
+            reusable = &candidate;
+    }
+
+    if (!entry)
+    {
+        if (reusable)
+            entry = reusable;
+        else
+        {
+            versions.push_back(Entry());
+            entry = &versions.back();
+            entry->figureBuffer.buffer = backend.CreateBuffer();
+            bufferCount++;
+        }
+
+        size_t count = figure.GetPointCount();
+        uploadScratch.resize(count * 2);
+        figure.WriteOpenGLVertices(uploadScratch.data());
+
+        backend.UploadVertices(entry->figureBuffer.buffer, uploadScratch.data(), count);
+        entry->figureBuffer.count = count;
+        entry->pointsVersion = pointsVersion;
+        uploadCount++;
+    }
+
+    entry->used = true;
+    return entry->figureBuffer;
+}
+
+void FigureBufferCache::DrawLineStrip(const FigureBuffer &figureBuffer)
+{
+    if (figureBuffer.count >= 2)
+        backend.DrawBuffer(figureBuffer.buffer, VertexPrimitive::LineStrip, 0, figureBuffer.count);
+}
+
+void FigureBufferCache::DrawPoints(const FigureBuffer &figureBuffer)
+{
+    if (figureBuffer.count > 0)
+        backend.DrawBuffer(figureBuffer.buffer, VertexPrimitive::Points, 0, figureBuffer.count);
+}
+
+void FigureBufferCache::Sweep()
+{
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        std::vector<Entry> &versions = it->second;
+        for (size_t i = 0; i < versions.size();)
+        {
+            if (!versions[i].used)
+            {
+                backend.DestroyBuffer(versions[i].figureBuffer.buffer);
+                bufferCount--;
+                versions[i] = versions.back();
+                versions.pop_back();
+            }
+            else
+            {
+                versions[i].used = false;
+                ++i;
+            }
+        }
+
+        if (versions.empty())
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+void FigureBufferCache::Release(uint64_t figureId)
+{
+    auto it = entries.find(figureId);
+    if (it == entries.end())
+        return;
+
+    for (const auto &entry : it->second)
+    {
+        backend.DestroyBuffer(entry.figureBuffer.buffer);
+        bufferCount--;
+    }
+    entries.erase(it);
+}
+
+void FigureBufferCache::Clear()
+{
+    for (auto &versions : entries)
+    {
+        for (const auto &entry : versions.second)
+        {
+            backend.DestroyBuffer(entry.figureBuffer.buffer);
+        }
+    }
+    entries.clear();
+    bufferCount = 0;
+}
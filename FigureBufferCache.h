@@ -0,0 +1,57 @@
+// FigureBufferCache.h - One retained vertex buffer per Figure, re-uploaded only when its points change
+#pragma once
+#include "IVertexBufferBackend.h"
+#include "Figure.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct FigureBuffer
+{
+    VertexBufferId buffer = 0;
+    size_t count = 0;
+};
+
+class FigureBufferCache
+{
+private:
+    struct Entry
+    {
+        FigureBuffer figureBuffer;
+        uint64_t pointsVersion = 0;
+        bool used = false;
+    };
+
+    IVertexBufferBackend &backend;
+    // Clave: Figure::GetId(). Las copias conservan el id, así que puede haber varias versiones de
+    // la misma figura en un frame (p. ej. una anterior al lado de la actual): una entrada por
+    // versión de puntos, casi siempre solo una
+    std::unordered_map<uint64_t, std::vector<Entry>> entries;
+    size_t bufferCount;
+    std::vector<float> uploadScratch;
+    uint64_t uploadCount;
+
+public:
+    explicit FigureBufferCache(IVertexBufferBackend &vertexBackend);
+    ~FigureBufferCache();
+
+    FigureBufferCache(const FigureBufferCache &) = delete;
+    FigureBufferCache &operator=(const FigureBufferCache &) = delete;
+
+    // Buffer con los puntos sin transformar de figure (la transformación va en la matriz de
+    // modelo al dibujar). Solo se suben datos si no hay ya un buffer con su GetPointsVersion();
+    // si cambió, se reutiliza uno de la misma figura que no se haya usado en este frame.
+    FigureBuffer Prepare(const Figure &figure);
+
+    // Dibuja la línea y los puntos de la figura desde el mismo buffer
+    void DrawLineStrip(const FigureBuffer &figureBuffer);
+    void DrawPoints(const FigureBuffer &figureBuffer);
+
+    // Libera los buffers de figuras que no pasaron por Prepare() desde el último Sweep()
+    void Sweep();
+    void Release(uint64_t figureId);
+    void Clear();
+
+    size_t GetBufferCount() const { return bufferCount; }
+    uint64_t GetUploadCount() const { return uploadCount; }
+};
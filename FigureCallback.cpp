@@ -8,11 +8,11 @@ void FigureManager::SetGlobalCallback(FigureCallback callback)
     globalCallback = callback;
 }
 
-void FigureManager::NotifyFigureComplete(std::shared_ptr<Figure> figure)
+void FigureManager::NotifyFigureComplete(Figure &&figure)
 {
     if (globalCallback)
     {
-        globalCallback(figure);
+        globalCallback(std::move(figure));
     }
 }
 
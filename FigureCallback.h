@@ -2,9 +2,9 @@
 #pragma once
 #include "Figure.h"
 #include <functional>
-#include <memory>
 
-using FigureCallback = std::function<void(std::shared_ptr<Figure>)>;
+// La figura se entrega por valor (movida): quien la recibe la guarda en su FigureStore
+using FigureCallback = std::function<void(Figure &&)>;
 
 class FigureManager
 {
@@ -13,6 +13,6 @@ private:
 
 public:
     static void SetGlobalCallback(FigureCallback callback);
-    static void NotifyFigureComplete(std::shared_ptr<Figure> figure);
+    static void NotifyFigureComplete(Figure &&figure);
 };
 
@@ -0,0 +1,103 @@
+// FigureExporter.cpp
+#include "FigureExporter.h"
+#include "SoftwareRenderBackend.h"
+#include "FigureRendering.h"
+#include "FigureBufferCache.h"
+#include "ThumbnailGrid.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+namespace
+{
+    std::string MakePath(const std::string &pathPrefix, size_t index, ImageFormat format)
+    {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%05zu", index);
+        return pathPrefix + number + GetImageExtension(format);
+    }
+}
+
+size_t ExportFigureImages(const FigureListView &figures, const std::string &pathPrefix,
+                          const ExportOptions &options)
+{
+    std::atomic<size_t> written(0);
+
+    ParallelFor(figures.Size(), 1, [&](size_t begin, size_t end)
+                {
+        // Cada hilo rasteriza en su propio framebuffer, sin repartir bandas otra vez
+        SoftwareRenderBackend backend(options.width, options.height);
+        backend.SetParallelRasterization(false);
+        FigureBufferCache buffers(backend.GetVertexBuffers());
+        ThumbnailGrid grid(backend.GetVertexBuffers());
+        std::vector<const Figure *> single(1);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Figure *figure = figures.Get(i);
+            if (!figure)
+                continue;
+
+            backend.Clear(options.background.r, options.background.g, options.background.b);
+            if (options.mode == ExportMode::FullSize)
+            {
+                RenderFigure(backend, buffers, *figure, figure->GetColor(), 3.0f, 6.0f);
+                buffers.Release(figure->GetId());
+            }
+            else
+            {
+                // Grid de una sola celda: la misma escala y centrado que las miniaturas
+                single[0] = figure;
+                RenderThumbnailGrid(backend, grid, single);
+            }
+
+            const auto &pixels = backend.GetPixels();
+            if (WriteImage(MakePath(pathPrefix, i, options.format), pixels.data(), options.width, options.height, options.format))
+                written++;
+        } });
+
+    return written;
+}
+
+size_t GetThumbnailSheetCount(size_t figureCount)
+{
+    const size_t perSheet = GRID_MAX_COLUMNS * GRID_MAX_ROWS;
+    return (figureCount + perSheet - 1) / perSheet;
+}
+
+size_t ExportThumbnailSheets(const FigureListView &figures, const std::string &pathPrefix,
+                             const ExportOptions &options)
+{
+    const size_t perSheet = GRID_MAX_COLUMNS * GRID_MAX_ROWS;
+    size_t sheetCount = GetThumbnailSheetCount(figures.Size());
+    std::atomic<size_t> written(0);
+
+    ParallelFor(sheetCount, 1, [&](size_t begin, size_t end)
+                {
+        SoftwareRenderBackend backend(options.width, options.height);
+        backend.SetParallelRasterization(false);
+        ThumbnailGrid grid(backend.GetVertexBuffers());
+        std::vector<const Figure *> sheet;
+
+        for (size_t s = begin; s < end; ++s)
+        {
+            size_t first = s * perSheet;
+            size_t last = (std::min)(first + perSheet, figures.Size());
+            sheet.clear();
+            for (size_t i = first; i < last; ++i)
+            {
+                if (const Figure *figure = figures.Get(i))
+                    sheet.push_back(figure);
+            }
+
+            backend.Clear(options.background.r, options.background.g, options.background.b);
+            RenderThumbnailGrid(backend, grid, sheet);
+
+            const auto &pixels = backend.GetPixels();
+            if (WriteImage(MakePath(pathPrefix, s, options.format), pixels.data(), options.width, options.height, options.format))
+                written++;
+        } });
+
+    return written;
+}
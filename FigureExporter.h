@@ -0,0 +1,37 @@
+// FigureExporter.h - Headless batch export of figures to image files (software rasterizer, no window)
+#pragma once
+#include "Figure.h"
+#include "FigureStore.h"
+#include "Color.h"
+#include "ImageWriter.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class ExportMode
+{
+    FullSize, // Como en FigureViewerWindow: transformación acumulada, sin recentrar
+    Thumbnail // Como una celda de MainWindow: centrada y escalada para caber
+};
+
+struct ExportOptions
+{
+    int width = 256;
+    int height = 256;
+    ImageFormat format = ImageFormat::PNG;
+    ExportMode mode = ExportMode::Thumbnail;
+    Color background = Color(0.2f, 0.3f, 0.4f); // Mismo fondo que las ventanas
+};
+
+// Una imagen por figura: <pathPrefix><índice><extensión>, p. ej. "out/figure_00042.png".
+// Las figuras se reparten entre hilos (un framebuffer por hilo) y cada imagen se escribe al
+// terminarla. Los elementos vacíos (handles borrados) se saltan. Devuelve el número de imágenes escritas.
+size_t ExportFigureImages(const FigureListView &figures, const std::string &pathPrefix,
+                          const ExportOptions &options);
+
+// Hojas de miniaturas con el grid de MainWindow (GridLayout, hasta 9 figuras por hoja):
+// <pathPrefix><hoja><extensión>. options.mode no se usa. Devuelve el número de hojas escritas;
+// GetThumbnailSheetCount dice cuántas tendrían que ser.
+size_t GetThumbnailSheetCount(size_t figureCount);
+size_t ExportThumbnailSheets(const FigureListView &figures, const std::string &pathPrefix,
+                             const ExportOptions &options);
@@ -0,0 +1,43 @@
+// FigureHistory.cpp
+#include "FigureHistory.h"
+#include <utility>
+
+void FigureHistory::Record(FigureHandle handle, const Figure &figure)
+{
+    if (maxEntries == 0)
+        return;
+    if (entries.size() == maxEntries)
+        entries.pop_front();
+
+    entries.push_back(Entry{handle, figure});
+}
+
+bool FigureHistory::Undo(FigureStore &store, FigureHandle handle)
+{
+    Figure *current = store.Get(handle);
+    if (!current)
+        return false;
+
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+        if (it->handle != handle)
+            continue;
+
+        *current = std::move(it->figure);
+        // La versión guardada es anterior a lo último dibujado: sin esto podría saltarse el frame
+        current->TouchVersion();
+        entries.erase(std::next(it).base());
+        return true;
+    }
+    return false;
+}
+
+const Figure *FigureHistory::FindPrevious(FigureHandle handle) const
+{
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+        if (it->handle == handle)
+            return &it->figure;
+    }
+    return nullptr;
+}
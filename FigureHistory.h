@@ -0,0 +1,35 @@
+// FigureHistory.h - Bounded undo history of figure versions, cheap because figure copies share their points
+#pragma once
+#include "Figure.h"
+#include "FigureStore.h"
+#include <cstddef>
+#include <deque>
+
+// Versiones anteriores de las figuras de un FigureStore, para deshacer y comparar. Guardar una
+// versión es copiar la Figure, que comparte los puntos con la original hasta que una de las dos
+// los cambie: lo que se copia es la transformación, el color y el nombre.
+class FigureHistory
+{
+private:
+    struct Entry
+    {
+        FigureHandle handle;
+        Figure figure;
+    };
+
+    std::deque<Entry> entries; // La más reciente al final
+    size_t maxEntries;
+
+public:
+    explicit FigureHistory(size_t maxEntries = 64) : maxEntries(maxEntries) {}
+
+    // Guarda figure tal como está ahora; pasado el máximo se olvida la versión más antigua
+    void Record(FigureHandle handle, const Figure &figure);
+    // Devuelve la figura de handle en store a su última versión guardada. false si no hay ninguna
+    bool Undo(FigureStore &store, FigureHandle handle);
+    // Última versión guardada de handle, para compararla con la actual; nullptr si no hay
+    const Figure *FindPrevious(FigureHandle handle) const;
+
+    size_t GetCount() const { return entries.size(); }
+    void Clear() { entries.clear(); }
+};
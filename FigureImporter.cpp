@@ -0,0 +1,988 @@
+// FigureImporter.cpp
+#include "FigureImporter.h"
+#include "TextStream.h"
+#include "Transforms2D.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    const size_t POINT_BATCH_SIZE = 1024; // Puntos que se acumulan antes de pasarlos a la Figure
+    const int CURVE_SEGMENTS = 16;        // Segmentos por curva de Bézier
+    const double ARC_SEGMENT_RADIANS = 3.14159265358979323846 / 16.0;
+    const int MAX_WKT_NESTING = 8;        // GEOMETRYCOLLECTION dentro de GEOMETRYCOLLECTION...
+
+    void ReportError(ImportResult &result, size_t line, size_t column, const char *message)
+    {
+        result.errorCount++;
+        if (result.errors.size() < MAX_REPORTED_IMPORT_ERRORS)
+        {
+            ImportError error;
+            error.line = line;
+            error.column = column;
+            error.message = message;
+            result.errors.push_back(error);
+        }
+    }
+
+    void ReportError(ImportResult &result, const TextStream &stream, const char *message)
+    {
+        ReportError(result, stream.GetLine(), stream.GetColumn(), message);
+    }
+
+    const char *const OUT_OF_RANGE_MESSAGE = "coordinate out of range";
+
+    // Los puntos se guardan como float: 1e39 se lee bien como double pero pasa a ser infinito,
+    // y un solo infinito estropea los límites y la normalización de toda la importación
+    bool FitsInFloat(double value)
+    {
+        return std::isfinite(static_cast<float>(value));
+    }
+
+    // ReadNumber de una coordenada que además cabe en un float. outOfRange distingue "no hay
+    // número" de "número fuera de rango" (que sí se consume); line y column dicen dónde empieza
+    bool ReadCoordinateValue(TextStream &stream, double &value, bool &outOfRange, size_t &line, size_t &column)
+    {
+        line = stream.GetLine();
+        column = stream.GetColumn();
+        outOfRange = false;
+        if (!stream.ReadNumber(value))
+            return false;
+        outOfRange = !FitsInFloat(value);
+        return !outOfRange;
+    }
+
+    // Construye las figuras de una importación. Los puntos pasan por un lote fijo y llegan a la
+    // Figure de POINT_BATCH_SIZE en POINT_BATCH_SIZE (una versión nueva por lote, no por punto).
+    class FigureSink
+    {
+    private:
+        FigureStore &store;
+        std::vector<FigureHandle> &handles;
+        const ImportOptions &options;
+        std::string prefix;
+        ImportResult &result;
+        size_t firstHandle; // Las figuras de esta importación son handles[firstHandle..]
+        bool rejectedPoint; // Add() recibió un punto que no cabe en float (calculado, no leído)
+
+        Figure current;
+        bool open;
+        size_t pointCount;
+        HomogenVector first, last;
+        HomogenVector batch[POINT_BATCH_SIZE];
+        size_t batchCount;
+
+        void Flush()
+        {
+            if (pointCount >= COLUMNAR_STORAGE_MIN_POINTS && current.GetStorageMode() != PointStorageMode::Columnar)
+                current.SetStorageMode(PointStorageMode::Columnar);
+            current.AddPoints(batch, batchCount);
+            batchCount = 0;
+        }
+
+    public:
+        FigureSink(FigureStore &figureStore, std::vector<FigureHandle> &figureHandles,
+                   const ImportOptions &importOptions, const std::string &namePrefix, ImportResult &importResult)
+            : store(figureStore), handles(figureHandles), options(importOptions), prefix(namePrefix),
+              result(importResult), firstHandle(figureHandles.size()), rejectedPoint(false), open(false), pointCount(0), batchCount(0)
+        {
+        }
+
+        bool IsOpen() const { return open; }
+        // true (una vez) si Add() descartó algún punto desde la última llamada
+        bool TakeRejectedPoint()
+        {
+            bool rejected = rejectedPoint;
+            rejectedPoint = false;
+            return rejected;
+        }
+        size_t GetHandleCount() const { return handles.size(); }
+
+        void Begin()
+        {
+            Discard();
+            current = Figure(prefix + "_" + std::to_string(result.figureCount + 1));
+            open = true;
+        }
+
+        // Los parsers ya rechazan los números fuera de rango; aquí solo pueden llegar puntos
+        // calculados (un relativo o una curva que se sale), que no se añaden
+        void Add(double x, double y, double w = 1.0)
+        {
+            HomogenVector point(static_cast<float>(x), static_cast<float>(y), static_cast<float>(w));
+            if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.w))
+            {
+                rejectedPoint = true;
+                return;
+            }
+            if (pointCount == 0)
+                first = point;
+            last = point;
+            pointCount++;
+
+            batch[batchCount++] = point;
+            if (batchCount == POINT_BATCH_SIZE)
+                Flush();
+        }
+
+        // Termina la figura abierta; sin puntos no se añade nada
+        void End(bool closed)
+        {
+            if (!open)
+                return;
+            Flush();
+            if (pointCount > 0)
+            {
+                current.SetColor(options.color);
+                current.SetComplete(closed);
+                handles.push_back(store.Add(std::move(current)));
+                result.figureCount++;
+                result.pointCount += pointCount;
+            }
+            open = false;
+            pointCount = 0;
+        }
+
+        // Cerrada si acaba donde empieza (como las figuras de DrawingWindow)
+        void EndDetectClosed()
+        {
+            End(pointCount >= 3 && first.x == last.x && first.y == last.y && first.w == last.w);
+        }
+
+        void Discard()
+        {
+            open = false;
+            pointCount = 0;
+            batchCount = 0;
+        }
+
+        // Quita lo añadido desde handleCount (una geometría WKT con errores se descarta entera)
+        void RollBack(size_t handleCount)
+        {
+            Discard();
+            while (handles.size() > handleCount)
+            {
+                const Figure *figure = store.Get(handles.back());
+                if (figure)
+                {
+                    result.figureCount--;
+                    result.pointCount -= figure->GetPointCount();
+                }
+                store.Remove(handles.back());
+                handles.pop_back();
+            }
+        }
+
+        // Una sola escala para todas las figuras importadas: conservan su posición relativa
+        void Normalize(bool flipY)
+        {
+            FigureBounds bounds;
+            for (size_t i = firstHandle; i < handles.size(); ++i)
+            {
+                const FigureBounds &figureBounds = store.Get(handles[i])->GetBounds();
+                if (figureBounds.IsEmpty())
+                    continue;
+                bounds.Include(figureBounds.minX, figureBounds.minY);
+                bounds.Include(figureBounds.maxX, figureBounds.maxY);
+            }
+            if (bounds.IsEmpty())
+                return;
+
+            // En double: con coordenadas cerca de FLT_MAX el ancho o la suma del centro no caben en float
+            double largestSide = (std::max)(static_cast<double>(bounds.maxX) - bounds.minX,
+                                            static_cast<double>(bounds.maxY) - bounds.minY);
+            float scale = largestSide > 0.0 ? static_cast<float>(2.0 / largestSide) : 1.0f;
+            float centerX = static_cast<float>((static_cast<double>(bounds.minX) + bounds.maxX) / 2.0);
+            float centerY = static_cast<float>((static_cast<double>(bounds.minY) + bounds.maxY) / 2.0);
+            ScaleTranslate2D fit = Scale2D(scale, flipY ? -scale : scale) * Translate2D(-centerX, -centerY);
+
+            for (size_t i = firstHandle; i < handles.size(); ++i)
+            {
+                Figure *figure = store.Get(handles[i]);
+                figure->ApplyTransform(fit);
+                figure->BakeTransform();
+            }
+        }
+    };
+
+    // ---------------------------------------------------------------- CSV
+
+    void ImportCsv(TextStream &stream, FigureSink &sink, ImportResult &result)
+    {
+        bool headerAllowed = true; // Solo la primera línea con contenido puede ser una cabecera
+
+        while (!stream.AtEnd())
+        {
+            stream.SkipInlineSpaces();
+            int c = stream.Peek();
+            if (c == '\n' || c == TextStream::END)
+            {
+                // Línea en blanco: termina la figura
+                stream.Get();
+                sink.EndDetectClosed();
+                continue;
+            }
+            if (c == '#')
+            {
+                stream.SkipLine();
+                continue;
+            }
+
+            double values[3];
+            int count = 0;
+            bool malformed = false;
+            bool outOfRange = false;
+            size_t numberLine, numberColumn;
+            for (;;)
+            {
+                if (count == 3 || !ReadCoordinateValue(stream, values[count], outOfRange, numberLine, numberColumn))
+                {
+                    malformed = true;
+                    break;
+                }
+                count++;
+
+                stream.SkipInlineSpaces();
+                c = stream.Peek();
+                if (c == ',' || c == ';')
+                {
+                    stream.Get();
+                    stream.SkipInlineSpaces();
+                    c = stream.Peek();
+                }
+                if (c == '\n' || c == TextStream::END)
+                    break;
+            }
+
+            if (outOfRange)
+            {
+                ReportError(result, numberLine, numberColumn, OUT_OF_RANGE_MESSAGE);
+                headerAllowed = false;
+                stream.SkipLine();
+                continue;
+            }
+            if (malformed || count < 2)
+            {
+                if (!headerAllowed)
+                    ReportError(result, stream, "expected x,y or x,y,w");
+                headerAllowed = false;
+                stream.SkipLine();
+                continue;
+            }
+
+            headerAllowed = false;
+            stream.Get(); // '\n'
+            if (!sink.IsOpen())
+                sink.Begin();
+            sink.Add(values[0], values[1], count == 3 ? values[2] : 1.0);
+        }
+        sink.EndDetectClosed();
+    }
+
+    // ---------------------------------------------------------------- WKT
+
+    // Letras seguidas, en mayúsculas (como mucho capacity - 1)
+    size_t ReadWord(TextStream &stream, char *word, size_t capacity)
+    {
+        size_t length = 0;
+        while (std::isalpha(stream.Peek()))
+        {
+            char c = static_cast<char>(std::toupper(stream.Get()));
+            if (length + 1 < capacity)
+                word[length++] = c;
+        }
+        word[length] = '\0';
+        return length;
+    }
+
+    class WktParser
+    {
+    private:
+        TextStream &stream;
+        FigureSink &sink;
+        ImportResult &result;
+        int dimensions; // Números por coordenada (2, 3 con Z o M, 4 con ZM); solo se usan x e y
+
+        bool Fail(const char *message)
+        {
+            ReportError(result, stream, message);
+            return false;
+        }
+
+        bool Expect(int c, const char *message)
+        {
+            stream.SkipSpaces();
+            return stream.Accept(c) ? true : Fail(message);
+        }
+
+        bool ReadCoordinate(bool allowParentheses)
+        {
+            stream.SkipSpaces();
+            bool parenthesized = allowParentheses && stream.Accept('(');
+
+            double values[4];
+            for (int i = 0; i < dimensions; ++i)
+            {
+                stream.SkipSpaces();
+                bool outOfRange;
+                size_t line, column;
+                if (ReadCoordinateValue(stream, values[i], outOfRange, line, column))
+                    continue;
+                // Z y M no se guardan: basta con que sean números
+                if (outOfRange && i >= 2)
+                    continue;
+                if (!outOfRange)
+                    return Fail("expected a coordinate");
+                ReportError(result, line, column, OUT_OF_RANGE_MESSAGE);
+                return false;
+            }
+            sink.Add(values[0], values[1]);
+            return parenthesized ? Expect(')', "expected ')' after coordinate") : true;
+        }
+
+        // ( x y, x y, ... ) en una figura; allowParentheses para MULTIPOINT ((x y), (x y))
+        bool ReadSequence(bool allowParentheses)
+        {
+            if (!Expect('(', "expected '('"))
+                return false;
+            do
+            {
+                if (!ReadCoordinate(allowParentheses))
+                    return false;
+                stream.SkipSpaces();
+            } while (stream.Accept(','));
+            return Expect(')', "expected ',' or ')'");
+        }
+
+        // level 1: una secuencia = una figura; level > 1: lista de elementos de level - 1
+        bool ReadNested(int level, bool rings)
+        {
+            if (level == 1)
+            {
+                sink.Begin();
+                if (!ReadSequence(false))
+                    return false;
+                if (rings)
+                    sink.End(true);
+                else
+                    sink.EndDetectClosed();
+                return true;
+            }
+
+            if (!Expect('(', "expected '('"))
+                return false;
+            do
+            {
+                if (!ReadNested(level - 1, rings))
+                    return false;
+                stream.SkipSpaces();
+            } while (stream.Accept(','));
+            return Expect(')', "expected ',' or ')'");
+        }
+
+    public:
+        WktParser(TextStream &textStream, FigureSink &figureSink, ImportResult &importResult)
+            : stream(textStream), sink(figureSink), result(importResult), dimensions(2)
+        {
+        }
+
+        bool ReadGeometry(int depth)
+        {
+            stream.SkipSpaces();
+            char word[24];
+            if (ReadWord(stream, word, sizeof(word)) == 0)
+                return Fail("expected a geometry type");
+
+            // EWKT: SRID=4326;POINT(...)
+            if (std::strcmp(word, "SRID") == 0)
+            {
+                while (stream.Peek() != ';' && stream.Peek() != '\n' && !stream.AtEnd())
+                    stream.Get();
+                if (!stream.Accept(';'))
+                    return Fail("expected ';' after SRID");
+                return ReadGeometry(depth);
+            }
+
+            std::string type = word;
+            dimensions = 2;
+            // Sufijo de dimensión, pegado (POINTZ) o separado (POINT Z)
+            for (const char *suffix : {"ZM", "Z", "M"})
+            {
+                size_t length = std::strlen(suffix);
+                if (type.size() > length && type.compare(type.size() - length, length, suffix) == 0)
+                {
+                    type.resize(type.size() - length);
+                    dimensions = 2 + static_cast<int>(length);
+                    break;
+                }
+            }
+
+            stream.SkipInlineSpaces();
+            if (std::isalpha(stream.Peek()))
+            {
+                ReadWord(stream, word, sizeof(word));
+                if (std::strcmp(word, "ZM") == 0)
+                    dimensions = 4;
+                else if (std::strcmp(word, "Z") == 0 || std::strcmp(word, "M") == 0)
+                    dimensions = 3;
+                else if (std::strcmp(word, "EMPTY") == 0)
+                    return true;
+                else
+                    return Fail("unexpected word after geometry type");
+
+                stream.SkipInlineSpaces();
+                if (std::isalpha(stream.Peek()))
+                {
+                    ReadWord(stream, word, sizeof(word));
+                    return std::strcmp(word, "EMPTY") == 0 ? true : Fail("expected EMPTY or '('");
+                }
+            }
+
+            if (type == "POINT" || type == "MULTIPOINT")
+            {
+                sink.Begin();
+                if (!ReadSequence(type == "MULTIPOINT"))
+                    return false;
+                sink.End(false);
+                return true;
+            }
+            if (type == "LINESTRING")
+                return ReadNested(1, false);
+            if (type == "MULTILINESTRING")
+                return ReadNested(2, false);
+            if (type == "POLYGON")
+                return ReadNested(2, true);
+            if (type == "MULTIPOLYGON")
+                return ReadNested(3, true);
+            if (type == "GEOMETRYCOLLECTION")
+            {
+                if (depth >= MAX_WKT_NESTING)
+                    return Fail("geometry collections nested too deeply");
+                if (!Expect('(', "expected '('"))
+                    return false;
+                do
+                {
+                    if (!ReadGeometry(depth + 1))
+                        return false;
+                    stream.SkipSpaces();
+                } while (stream.Accept(','));
+                return Expect(')', "expected ',' or ')'");
+            }
+            return Fail("unsupported geometry type");
+        }
+    };
+
+    void ImportWkt(TextStream &stream, FigureSink &sink, ImportResult &result)
+    {
+        WktParser parser(stream, sink, result);
+        for (;;)
+        {
+            stream.SkipSpaces();
+            while (stream.Accept(';'))
+                stream.SkipSpaces();
+            if (stream.AtEnd())
+                break;
+
+            size_t handleCount = sink.GetHandleCount();
+            if (!parser.ReadGeometry(0))
+            {
+                // Sin la geometría a medias; se sigue en la línea siguiente
+                sink.RollBack(handleCount);
+                stream.SkipLine();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------- SVG
+
+    class SvgPathParser
+    {
+    private:
+        TextStream &stream;
+        FigureSink &sink;
+        ImportResult &result;
+        int terminator; // Comilla del atributo d, o TextStream::END
+
+        double currentX, currentY;
+        double startX, startY;     // Inicio del subtrayecto (Z vuelve aquí)
+        double controlX, controlY; // Último punto de control, para S y T
+        char previousCommand;
+        bool outOfRange; // El último ReadNumbers falló por un número que no cabe en float
+        size_t outOfRangeLine, outOfRangeColumn;
+
+        void SkipSeparators()
+        {
+            stream.SkipSpacesAndCommas();
+        }
+
+        bool ReadNumbers(double *values, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                SkipSeparators();
+                if (!ReadCoordinateValue(stream, values[i], outOfRange, outOfRangeLine, outOfRangeColumn))
+                    return false;
+            }
+            return true;
+        }
+
+        // Las banderas de A pueden ir pegadas: "a1 1 0 00 1 1"
+        bool ReadFlag(bool &flag)
+        {
+            SkipSeparators();
+            int c = stream.Peek();
+            if (c != '0' && c != '1')
+                return false;
+            flag = stream.Get() == '1';
+            return true;
+        }
+
+        void EnsureSubpath()
+        {
+            if (!sink.IsOpen())
+            {
+                sink.Begin();
+                sink.Add(currentX, currentY);
+            }
+        }
+
+        void LineTo(double x, double y)
+        {
+            EnsureSubpath();
+            sink.Add(x, y);
+            currentX = x;
+            currentY = y;
+        }
+
+        void CubicTo(double x1, double y1, double x2, double y2, double x, double y)
+        {
+            EnsureSubpath();
+            for (int i = 1; i <= CURVE_SEGMENTS; ++i)
+            {
+                double t = static_cast<double>(i) / CURVE_SEGMENTS;
+                double u = 1.0 - t;
+                double a = u * u * u, b = 3.0 * u * u * t, c = 3.0 * u * t * t, d = t * t * t;
+                sink.Add(a * currentX + b * x1 + c * x2 + d * x, a * currentY + b * y1 + c * y2 + d * y);
+            }
+            controlX = x2;
+            controlY = y2;
+            currentX = x;
+            currentY = y;
+        }
+
+        void QuadraticTo(double x1, double y1, double x, double y)
+        {
+            EnsureSubpath();
+            for (int i = 1; i <= CURVE_SEGMENTS; ++i)
+            {
+                double t = static_cast<double>(i) / CURVE_SEGMENTS;
+                double u = 1.0 - t;
+                double a = u * u, b = 2.0 * u * t, c = t * t;
+                sink.Add(a * currentX + b * x1 + c * x, a * currentY + b * y1 + c * y);
+            }
+            controlX = x1;
+            controlY = y1;
+            currentX = x;
+            currentY = y;
+        }
+
+        // Arco elíptico de la especificación SVG (conversión de extremos a centro, F.6.5)
+        void ArcTo(double rx, double ry, double rotationDegrees, bool largeArc, bool sweep, double x, double y)
+        {
+            rx = std::fabs(rx);
+            ry = std::fabs(ry);
+            if (rx == 0.0 || ry == 0.0 || (x == currentX && y == currentY))
+            {
+                LineTo(x, y);
+                return;
+            }
+
+            const double PI = 3.14159265358979323846;
+            double phi = rotationDegrees * PI / 180.0;
+            double cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+            double dx = (currentX - x) / 2.0, dy = (currentY - y) / 2.0;
+            double x1p = cosPhi * dx + sinPhi * dy;
+            double y1p = -sinPhi * dx + cosPhi * dy;
+
+            // Radios demasiado pequeños para unir los extremos: se agrandan lo justo
+            double lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+            if (lambda > 1.0)
+            {
+                double factor = std::sqrt(lambda);
+                rx *= factor;
+                ry *= factor;
+            }
+
+            double numerator = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p;
+            double denominator = rx * rx * y1p * y1p + ry * ry * x1p * x1p;
+            double coefficient = std::sqrt((std::max)(0.0, numerator / denominator));
+            if (largeArc == sweep)
+                coefficient = -coefficient;
+            double cxp = coefficient * rx * y1p / ry;
+            double cyp = -coefficient * ry * x1p / rx;
+            double cx = cosPhi * cxp - sinPhi * cyp + (currentX + x) / 2.0;
+            double cy = sinPhi * cxp + cosPhi * cyp + (currentY + y) / 2.0;
+
+            double startAngle = std::atan2((y1p - cyp) / ry, (x1p - cxp) / rx);
+            double endAngle = std::atan2((-y1p - cyp) / ry, (-x1p - cxp) / rx);
+            double delta = endAngle - startAngle;
+            if (sweep && delta < 0.0)
+                delta += 2.0 * PI;
+            else if (!sweep && delta > 0.0)
+                delta -= 2.0 * PI;
+
+            EnsureSubpath();
+            int segments = (std::max)(1, static_cast<int>(std::ceil(std::fabs(delta) / ARC_SEGMENT_RADIANS)));
+            for (int i = 1; i < segments; ++i)
+            {
+                double angle = startAngle + delta * i / segments;
+                double ex = rx * std::cos(angle), ey = ry * std::sin(angle);
+                sink.Add(cosPhi * ex - sinPhi * ey + cx, sinPhi * ex + cosPhi * ey + cy);
+            }
+            sink.Add(x, y); // Exacto, sin error de redondeo
+            currentX = x;
+            currentY = y;
+        }
+
+        void ClosePath()
+        {
+            if (sink.IsOpen())
+            {
+                if (currentX != startX || currentY != startY)
+                    sink.Add(startX, startY);
+                sink.End(true);
+            }
+            currentX = startX;
+            currentY = startY;
+        }
+
+        // Un grupo de parámetros de command; false si falta o sobra algo
+        bool Execute(char command)
+        {
+            bool relative = std::islower(static_cast<unsigned char>(command)) != 0;
+            double baseX = relative ? currentX : 0.0;
+            double baseY = relative ? currentY : 0.0;
+            char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+            char previous = previousCommand;
+            previousCommand = upper;
+            double v[7];
+
+            switch (upper)
+            {
+            case 'M':
+                if (!ReadNumbers(v, 2))
+                    return false;
+                sink.End(false);
+                currentX = startX = baseX + v[0];
+                currentY = startY = baseY + v[1];
+                sink.Begin();
+                sink.Add(currentX, currentY);
+                return true;
+            case 'L':
+                if (!ReadNumbers(v, 2))
+                    return false;
+                LineTo(baseX + v[0], baseY + v[1]);
+                return true;
+            case 'H':
+                if (!ReadNumbers(v, 1))
+                    return false;
+                LineTo(baseX + v[0], currentY);
+                return true;
+            case 'V':
+                if (!ReadNumbers(v, 1))
+                    return false;
+                LineTo(currentX, baseY + v[0]);
+                return true;
+            case 'C':
+                if (!ReadNumbers(v, 6))
+                    return false;
+                CubicTo(baseX + v[0], baseY + v[1], baseX + v[2], baseY + v[3], baseX + v[4], baseY + v[5]);
+                return true;
+            case 'S':
+            {
+                if (!ReadNumbers(v, 4))
+                    return false;
+                bool reflect = previous == 'C' || previous == 'S';
+                double x1 = reflect ? 2.0 * currentX - controlX : currentX;
+                double y1 = reflect ? 2.0 * currentY - controlY : currentY;
+                CubicTo(x1, y1, baseX + v[0], baseY + v[1], baseX + v[2], baseY + v[3]);
+                return true;
+            }
+            case 'Q':
+                if (!ReadNumbers(v, 4))
+                    return false;
+                QuadraticTo(baseX + v[0], baseY + v[1], baseX + v[2], baseY + v[3]);
+                return true;
+            case 'T':
+            {
+                if (!ReadNumbers(v, 2))
+                    return false;
+                bool reflect = previous == 'Q' || previous == 'T';
+                double x1 = reflect ? 2.0 * currentX - controlX : currentX;
+                double y1 = reflect ? 2.0 * currentY - controlY : currentY;
+                QuadraticTo(x1, y1, baseX + v[0], baseY + v[1]);
+                return true;
+            }
+            case 'A':
+            {
+                bool largeArc, sweep;
+                if (!ReadNumbers(v, 3) || !ReadFlag(largeArc) || !ReadFlag(sweep) || !ReadNumbers(v + 3, 2))
+                    return false;
+                ArcTo(v[0], v[1], v[2], largeArc, sweep, baseX + v[3], baseY + v[4]);
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        bool IsTerminator(int c) const
+        {
+            return c == terminator || c == TextStream::END;
+        }
+
+    public:
+        SvgPathParser(TextStream &textStream, FigureSink &figureSink, ImportResult &importResult, int endCharacter)
+            : stream(textStream), sink(figureSink), result(importResult), terminator(endCharacter),
+              currentX(0.0), currentY(0.0), startX(0.0), startY(0.0), controlX(0.0), controlY(0.0), previousCommand(0),
+              outOfRange(false), outOfRangeLine(0), outOfRangeColumn(0)
+        {
+        }
+
+        // Hasta el terminador (consumido). Con un error se informa y se salta el resto del trayecto
+        void Parse()
+        {
+            char command = 0;
+            for (;;)
+            {
+                SkipSeparators();
+                int c = stream.Peek();
+                if (IsTerminator(c))
+                    break;
+                size_t segmentLine = stream.GetLine(); // Comando o primer número del grupo
+                size_t segmentColumn = stream.GetColumn();
+
+                if (std::isalpha(c))
+                {
+                    command = static_cast<char>(stream.Get());
+                    if (command == 'Z' || command == 'z')
+                    {
+                        ClosePath();
+                        previousCommand = 'Z';
+                        continue;
+                    }
+                    if (!std::strchr("MmLlHhVvCcSsQqTtAa", command))
+                    {
+                        ReportError(result, stream.GetLine(), stream.GetColumn() - 1, "unknown path command");
+                        break;
+                    }
+                }
+                else if (command == 0 || command == 'Z' || command == 'z')
+                {
+                    ReportError(result, stream, "expected a path command");
+                    break;
+                }
+
+                if (!Execute(command))
+                {
+                    if (outOfRange)
+                        ReportError(result, outOfRangeLine, outOfRangeColumn, OUT_OF_RANGE_MESSAGE);
+                    else
+                        ReportError(result, stream, "expected a number");
+                    break;
+                }
+                // Números válidos, pero el punto calculado (relativo, curva) se sale del float
+                if (sink.TakeRejectedPoint())
+                {
+                    ReportError(result, segmentLine, segmentColumn, OUT_OF_RANGE_MESSAGE);
+                    break;
+                }
+                // Tras M, las parejas siguientes son L
+                if (command == 'M')
+                    command = 'L';
+                else if (command == 'm')
+                    command = 'l';
+            }
+
+            // Lo anterior al error se queda; lo que falte hasta el terminador se salta
+            sink.End(false);
+            while (!IsTerminator(stream.Peek()))
+                stream.Get();
+            if (terminator != TextStream::END && !stream.Accept(terminator))
+                ReportError(result, stream, "unterminated path data");
+        }
+    };
+
+    // <!-- ... --> ya pasado el "<!--"
+    void SkipXmlComment(TextStream &stream)
+    {
+        int dashes = 0;
+        for (int c = stream.Get(); c != TextStream::END; c = stream.Get())
+        {
+            if (c == '>' && dashes >= 2)
+                return;
+            dashes = c == '-' ? dashes + 1 : 0;
+        }
+    }
+
+    // Busca <path ... d="..."> sin construir el árbol: solo se mira el nombre de cada etiqueta
+    // y los atributos de las que son path
+    void ImportSvgDocument(TextStream &stream, FigureSink &sink, ImportResult &result)
+    {
+        while (!stream.AtEnd())
+        {
+            if (stream.Get() != '<')
+                continue;
+            if (stream.Peek() == '!' && stream.PeekAt(1) == '-' && stream.PeekAt(2) == '-')
+            {
+                SkipXmlComment(stream);
+                continue;
+            }
+
+            char name[16];
+            size_t length = 0;
+            for (int c = stream.Peek(); std::isalnum(c) || c == ':' || c == '-' || c == '_'; c = stream.Peek())
+            {
+                char lower = static_cast<char>(std::tolower(stream.Get()));
+                if (length + 1 < sizeof(name))
+                    name[length++] = lower;
+            }
+            name[length] = '\0';
+            if (std::strcmp(name, "path") != 0 && std::strcmp(name, "svg:path") != 0)
+                continue;
+
+            for (;;)
+            {
+                stream.SkipSpaces();
+                int c = stream.Peek();
+                if (c == '>' || c == '/' || c == TextStream::END)
+                    break;
+
+                char attribute[8];
+                size_t attributeLength = 0;
+                while (!stream.AtEnd() && stream.Peek() != '=' && !std::isspace(stream.Peek()) && stream.Peek() != '>')
+                {
+                    char a = static_cast<char>(stream.Get());
+                    if (attributeLength + 1 < sizeof(attribute))
+                        attribute[attributeLength++] = a;
+                }
+                attribute[attributeLength] = '\0';
+
+                stream.SkipSpaces();
+                if (!stream.Accept('='))
+                    continue; // Atributo sin valor
+                stream.SkipSpaces();
+                int quote = stream.Get();
+                if (quote != '"' && quote != '\'')
+                {
+                    ReportError(result, stream, "expected a quoted attribute value");
+                    break;
+                }
+
+                if (std::strcmp(attribute, "d") == 0)
+                {
+                    SvgPathParser(stream, sink, result, quote).Parse();
+                }
+                else
+                {
+                    while (!stream.AtEnd() && stream.Get() != quote)
+                    {
+                    }
+                }
+            }
+        }
+    }
+
+    void ImportSvg(TextStream &stream, FigureSink &sink, ImportResult &result)
+    {
+        stream.SkipSpaces();
+        if (stream.Peek() == '<')
+            ImportSvgDocument(stream, sink, result);
+        else
+            SvgPathParser(stream, sink, result, TextStream::END).Parse();
+    }
+
+    std::string GetFileStem(const std::string &path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        size_t start = slash == std::string::npos ? 0 : slash + 1;
+        size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos || dot < start)
+            dot = path.size();
+        return path.substr(start, dot - start);
+    }
+}
+
+bool GetImportFormat(const std::string &path, ImportFormat &format)
+{
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos)
+        return false;
+
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    if (extension == "csv" || extension == "txt")
+        format = ImportFormat::CSV;
+    else if (extension == "wkt")
+        format = ImportFormat::WKT;
+    else if (extension == "svg" || extension == "path")
+        format = ImportFormat::SVG;
+    else
+        return false;
+    return true;
+}
+
+ImportResult ImportFigures(std::istream &input, ImportFormat format, const ImportOptions &options,
+                           FigureStore &store, std::vector<FigureHandle> &handles)
+{
+    ImportResult result;
+    TextStream stream(input);
+    FigureSink sink(store, handles, options, options.namePrefix.empty() ? "Import" : options.namePrefix, result);
+
+    switch (format)
+    {
+    case ImportFormat::CSV:
+        ImportCsv(stream, sink, result);
+        break;
+    case ImportFormat::WKT:
+        ImportWkt(stream, sink, result);
+        break;
+    case ImportFormat::SVG:
+        ImportSvg(stream, sink, result);
+        break;
+    }
+
+    if (options.normalize)
+        sink.Normalize(format == ImportFormat::SVG);
+    result.bytesRead = stream.GetOffset();
+    return result;
+}
+
+ImportResult ImportFigureFile(const std::string &path, const ImportOptions &options,
+                              FigureStore &store, std::vector<FigureHandle> &handles)
+{
+    ImportFormat format;
+    if (!GetImportFormat(path, format))
+    {
+        ImportResult result;
+        ReportError(result, 0, 0, "unknown file extension");
+        return result;
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        ImportResult result;
+        ReportError(result, 0, 0, "cannot open file");
+        return result;
+    }
+
+    ImportOptions fileOptions = options;
+    if (fileOptions.namePrefix.empty())
+        fileOptions.namePrefix = GetFileStem(path);
+    return ImportFigures(input, format, fileOptions, store, handles);
+}
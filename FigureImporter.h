@@ -0,0 +1,59 @@
+// FigureImporter.h - Streaming import of external point data (CSV, WKT, SVG path) into a FigureStore
+#pragma once
+#include "Figure.h"
+#include "FigureStore.h"
+#include "Color.h"
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+enum class ImportFormat
+{
+    CSV, // x,y[,w] por línea (también ';', tabulador o espacios); una línea en blanco separa figuras
+    WKT, // POINT, LINESTRING, POLYGON, MULTI*, GEOMETRYCOLLECTION; una figura por línea o anillo
+    SVG  // Datos de <path d="..."> (o un archivo con solo esos datos); una figura por subtrayecto
+};
+
+// Por la extensión (.csv/.txt, .wkt, .svg/.path). false si no se reconoce
+bool GetImportFormat(const std::string &path, ImportFormat &format);
+
+struct ImportOptions
+{
+    std::string namePrefix; // Figuras <namePrefix>_<n>; vacío: nombre del archivo (o "Import")
+    Color color = YELLOW;
+    // Ajustar todo lo importado (con una sola escala, sin deformar) a [-1, 1], el espacio que
+    // supone HomogenVector::FromOpenGL. En SVG además se invierte el eje y (crece hacia abajo).
+    bool normalize = true;
+};
+
+const size_t MAX_REPORTED_IMPORT_ERRORS = 32;
+
+// Posición del primer carácter problemático (línea y columna desde 1; 0 si no hay posición)
+struct ImportError
+{
+    size_t line = 0;
+    size_t column = 0;
+    std::string message;
+};
+
+struct ImportResult
+{
+    size_t figureCount = 0;
+    size_t pointCount = 0;
+    uint64_t bytesRead = 0;
+    size_t errorCount = 0;            // Todos los errores
+    std::vector<ImportError> errors;  // Los primeros MAX_REPORTED_IMPORT_ERRORS
+
+    bool Succeeded() const { return errorCount == 0; }
+};
+
+// Lee input por bloques (memoria acotada aparte de los puntos importados) y añade las figuras
+// a store y sus handles a handles. Lo mal formado se informa y se salta: la línea en CSV, la
+// geometría en WKT y el resto del trayecto en SVG.
+ImportResult ImportFigures(std::istream &input, ImportFormat format, const ImportOptions &options,
+                           FigureStore &store, std::vector<FigureHandle> &handles);
+
+// Formato por la extensión; un error sin posición si no se puede abrir o no se reconoce
+ImportResult ImportFigureFile(const std::string &path, const ImportOptions &options,
+                              FigureStore &store, std::vector<FigureHandle> &handles);
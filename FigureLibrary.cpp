@@ -0,0 +1,326 @@
+// FigureLibrary.cpp
+#include "FigureLibrary.h"
+#include <algorithm>
+#include <cstdio>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const size_t WRITE_CHUNK_POINTS = 1024; // Puntos entrelazados por escritura en modo Columnar
+
+    // a + b * c <= limit sin desbordar
+    bool FitsWithin(uint64_t a, uint64_t b, uint64_t c, uint64_t limit)
+    {
+        if (a > limit)
+            return false;
+        return c == 0 || b <= (limit - a) / c;
+    }
+
+    // Pasa a disco lo ya escrito en path (cerrado): sin esto, tras un corte de luz el renombrado
+    // puede haber llegado al disco y los datos no, y quedaría un archivo vacío
+    bool SyncToDisk(const std::string &path)
+    {
+#ifdef _WIN32
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+        bool ok = FlushFileBuffers(handle) != 0;
+        return CloseHandle(handle) != 0 && ok;
+#else
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return false;
+        bool ok = fsync(descriptor) == 0;
+        return close(descriptor) == 0 && ok;
+#endif
+    }
+
+    // El renombrado en sí (la entrada del directorio). En Windows ya lo hace MOVEFILE_WRITE_THROUGH
+    void SyncDirectoryOf(const std::string &path)
+    {
+#ifndef _WIN32
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int descriptor = open(directory.c_str(), O_RDONLY);
+        if (descriptor >= 0)
+        {
+            fsync(descriptor);
+            close(descriptor);
+        }
+#else
+        (void)path;
+#endif
+    }
+
+    // Sustituye target por source de una vez: o queda el archivo viejo o el nuevo entero
+    bool MoveOverExisting(const std::string &source, const std::string &target)
+    {
+#ifdef _WIN32
+        return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+    }
+}
+
+Figure FigureView::ToFigure() const
+{
+    Figure figure(GetName());
+    if (pointCount >= COLUMNAR_STORAGE_MIN_POINTS)
+        figure.SetStorageMode(PointStorageMode::Columnar);
+    figure.AddPoints(points, pointCount);
+    figure.SetColor(color);
+    figure.SetComplete(complete);
+    if (!transform.IsIdentity())
+        figure.ApplyTransform(transform);
+    return figure;
+}
+
+FigureLibrary::FigureLibrary() : header(nullptr), records(nullptr), points(nullptr), names(nullptr) {}
+
+bool FigureLibrary::Open(const std::string &path)
+{
+    Close();
+    if (!file.Open(path))
+        return false;
+
+    const uint8_t *data = file.GetData();
+    uint64_t size = file.GetSize();
+    if (size < sizeof(FigureLibraryHeader))
+    {
+        Close();
+        return false;
+    }
+
+    const FigureLibraryHeader *candidate = reinterpret_cast<const FigureLibraryHeader *>(data);
+    bool valid = candidate->magic == FIGURE_LIBRARY_MAGIC &&
+                 candidate->version == FIGURE_LIBRARY_VERSION &&
+                 candidate->headerSize == sizeof(FigureLibraryHeader) &&
+                 candidate->recordSize == sizeof(FigureLibraryRecord) &&
+                 candidate->pointsOffset % alignof(HomogenVector) == 0 &&
+                 candidate->tableOffset % alignof(FigureLibraryRecord) == 0 &&
+                 FitsWithin(candidate->pointsOffset, candidate->pointCount, sizeof(HomogenVector), size) &&
+                 FitsWithin(candidate->tableOffset, candidate->figureCount, sizeof(FigureLibraryRecord), size) &&
+                 FitsWithin(candidate->namesOffset, candidate->namesSize, 1, size);
+    if (!valid)
+    {
+        Close();
+        return false;
+    }
+
+    header = candidate;
+    points = reinterpret_cast<const HomogenVector *>(data + header->pointsOffset);
+    records = reinterpret_cast<const FigureLibraryRecord *>(data + header->tableOffset);
+    names = reinterpret_cast<const char *>(data + header->namesOffset);
+    return true;
+}
+
+void FigureLibrary::Close()
+{
+    file.Close();
+    header = nullptr;
+    records = nullptr;
+    points = nullptr;
+    names = nullptr;
+}
+
+bool FigureLibrary::GetFigure(size_t index, FigureView &view) const
+{
+    if (!header || index >= header->figureCount)
+        return false;
+
+    const FigureLibraryRecord &record = records[index];
+    if (!FitsWithin(record.firstPoint, record.pointCount, 1, header->pointCount) ||
+        !FitsWithin(record.nameOffset, record.nameLength, 1, header->namesSize))
+        return false;
+
+    view.name = names + record.nameOffset;
+    view.nameLength = record.nameLength;
+    view.points = points + record.firstPoint;
+    view.pointCount = static_cast<size_t>(record.pointCount);
+    view.color = Color(record.color[0], record.color[1], record.color[2]);
+    view.bounds.minX = record.bounds[0];
+    view.bounds.minY = record.bounds[1];
+    view.bounds.maxX = record.bounds[2];
+    view.bounds.maxY = record.bounds[3];
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+            view.transform.m[row][col] = record.transform[row * 3 + col];
+    }
+    view.complete = (record.flags & FIGURE_RECORD_COMPLETE) != 0;
+    return true;
+}
+
+FigureLibraryWriter::FigureLibraryWriter() : pointCount(0), failed(false) {}
+
+void FigureLibraryWriter::WritePadding(size_t alignment)
+{
+    static const char zeros[FIGURE_LIBRARY_ALIGNMENT] = {};
+    size_t position = static_cast<size_t>(file.tellp());
+    size_t padding = (alignment - position % alignment) % alignment;
+    file.write(zeros, padding);
+}
+
+bool FigureLibraryWriter::Open(const std::string &path)
+{
+    records.clear();
+    names.clear();
+    pointCount = 0;
+    failed = false;
+    filePath = path;
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    // Cabecera a cero (magic inválido) hasta Finish()
+    FigureLibraryHeader placeholder = {};
+    file.write(reinterpret_cast<const char *>(&placeholder), sizeof(placeholder));
+    WritePadding(FIGURE_LIBRARY_ALIGNMENT);
+    failed = !file;
+    return !failed;
+}
+
+bool FigureLibraryWriter::Add(const Figure &figure)
+{
+    if (failed || !file.is_open())
+        return false;
+
+    size_t figurePointCount = figure.GetPointCount();
+    const std::string &name = figure.GetName();
+    const FigureBounds &bounds = figure.GetBounds();
+    const TransformMatrix &transform = figure.GetTransform();
+    Color color = figure.GetColor();
+
+    FigureLibraryRecord record = {};
+    record.firstPoint = pointCount;
+    record.pointCount = figurePointCount;
+    record.nameOffset = names.size();
+    record.nameLength = static_cast<uint32_t>(name.size());
+    record.flags = figure.IsComplete() ? FIGURE_RECORD_COMPLETE : 0;
+    record.color[0] = color.r;
+    record.color[1] = color.g;
+    record.color[2] = color.b;
+    record.bounds[0] = bounds.minX;
+    record.bounds[1] = bounds.minY;
+    record.bounds[2] = bounds.maxX;
+    record.bounds[3] = bounds.maxY;
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+            record.transform[row * 3 + col] = transform.m[row][col];
+    }
+
+    if (figure.GetStorageMode() == PointStorageMode::Interleaved)
+    {
+        const PointList &figurePoints = figure.GetPoints();
+        file.write(reinterpret_cast<const char *>(figurePoints.data()), figurePointCount * sizeof(HomogenVector));
+    }
+    else
+    {
+        // Por columnas: se entrelazan por tramos en vez de crear la copia entera
+        HomogenVector chunk[WRITE_CHUNK_POINTS];
+        for (size_t first = 0; first < figurePointCount && file; first += WRITE_CHUNK_POINTS)
+        {
+            size_t count = (std::min)(figurePointCount - first, WRITE_CHUNK_POINTS);
+            for (size_t i = 0; i < count; ++i)
+                chunk[i] = figure.GetPoint(first + i);
+            file.write(reinterpret_cast<const char *>(chunk), count * sizeof(HomogenVector));
+        }
+    }
+    if (!file)
+    {
+        failed = true;
+        return false;
+    }
+
+    records.push_back(record);
+    names += name;
+    pointCount += figurePointCount;
+    return true;
+}
+
+bool FigureLibraryWriter::Finish()
+{
+    if (!file.is_open())
+        return false;
+
+    if (!failed)
+    {
+        FigureLibraryHeader header = {};
+        header.magic = FIGURE_LIBRARY_MAGIC;
+        header.version = FIGURE_LIBRARY_VERSION;
+        header.headerSize = sizeof(FigureLibraryHeader);
+        header.recordSize = sizeof(FigureLibraryRecord);
+        header.figureCount = records.size();
+        header.pointsOffset = FIGURE_LIBRARY_ALIGNMENT;
+        header.pointCount = pointCount;
+
+        WritePadding(alignof(FigureLibraryRecord));
+        header.tableOffset = static_cast<uint64_t>(file.tellp());
+        file.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(FigureLibraryRecord));
+        header.namesOffset = static_cast<uint64_t>(file.tellp());
+        header.namesSize = names.size();
+        file.write(names.data(), names.size());
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        failed = !file;
+    }
+
+    // Lo último escrito puede seguir en el buffer: un fallo al volcarlo solo se ve al cerrar
+    file.close();
+    if (file.fail())
+        failed = true;
+    if (!failed && !SyncToDisk(filePath))
+        failed = true;
+    records.clear();
+    names.clear();
+    return !failed;
+}
+
+bool WriteFigureLibrary(const std::string &path, const FigureListView &figures)
+{
+    // Se escribe al lado y solo se cambia por el original si todo fue bien: un fallo a medias
+    // (disco lleno, cierre forzado) no puede dejar path truncado
+    std::string temporaryPath = path + ".tmp";
+    FigureLibraryWriter writer;
+    if (!writer.Open(temporaryPath))
+        return false;
+
+    for (size_t i = 0; i < figures.Size(); ++i)
+    {
+        const Figure *figure = figures.Get(i);
+        if (figure && !writer.Add(*figure))
+            break; // Finish() informa del fallo
+    }
+    if (!writer.Finish() || !MoveOverExisting(temporaryPath, path))
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    SyncDirectoryOf(path);
+    return true;
+}
+
+bool ReadFigureLibrary(const std::string &path, FigureStore &store, std::vector<FigureHandle> &handles)
+{
+    FigureLibrary library;
+    if (!library.Open(path))
+        return false;
+
+    for (size_t i = 0; i < library.GetFigureCount(); ++i)
+    {
+        FigureView view;
+        if (!library.GetFigure(i, view))
+            return false;
+        handles.push_back(store.Add(view.ToFigure()));
+    }
+    return true;
+}
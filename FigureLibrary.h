@@ -0,0 +1,135 @@
+// FigureLibrary.h - Versioned binary container for a whole figure library, read through a memory mapping
+#pragma once
+#include "Figure.h"
+#include "FigureStore.h"
+#include "MappedFile.h"
+#include "Color.h"
+#include "TransformMatrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Formato (little-endian, versión 1):
+//   [cabecera 64 B] [puntos: HomogenVector (x, y, w) seguidos, alineados a 64 B]
+//   [tabla: un FigureLibraryRecord por figura] [nombres: UTF-8 sin terminador]
+// La cabecera guarda dónde empieza cada sección, así que el escritor puede ir volcando los
+// puntos según llegan y dejar la tabla y los nombres para el final.
+const uint32_t FIGURE_LIBRARY_MAGIC = 0x42494C46; // "FLIB"
+const uint32_t FIGURE_LIBRARY_VERSION = 1;
+const size_t FIGURE_LIBRARY_ALIGNMENT = 64;
+
+const uint32_t FIGURE_RECORD_COMPLETE = 1;
+
+struct FigureLibraryHeader
+{
+    uint32_t magic;   // 0 mientras el archivo está a medio escribir
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint64_t figureCount;
+    uint64_t pointsOffset; // Bytes desde el principio del archivo
+    uint64_t pointCount;
+    uint64_t tableOffset;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+};
+
+struct FigureLibraryRecord
+{
+    uint64_t firstPoint; // Índice en la sección de puntos
+    uint64_t pointCount;
+    uint64_t nameOffset; // Bytes desde el principio de la sección de nombres
+    uint32_t nameLength;
+    uint32_t flags;      // FIGURE_RECORD_*
+    float color[3];
+    float bounds[4];     // Figure::GetBounds(): minX, minY, maxX, maxY (sin transformar)
+    float transform[9];  // TransformMatrix::m fila a fila
+};
+
+static_assert(sizeof(FigureLibraryHeader) == 64, "La cabecera es parte del formato");
+static_assert(sizeof(FigureLibraryRecord) == 96, "El registro es parte del formato");
+static_assert(sizeof(HomogenVector) == 3 * sizeof(float), "Los puntos se guardan tal cual");
+
+// Una figura de la biblioteca, leída de las páginas mapeadas sin copiar nada. Vale mientras
+// la FigureLibrary siga abierta.
+struct FigureView
+{
+    const char *name = nullptr;
+    size_t nameLength = 0;
+    const HomogenVector *points = nullptr;
+    size_t pointCount = 0;
+    Color color;
+    FigureBounds bounds;
+    TransformMatrix transform;
+    bool complete = false;
+
+    std::string GetName() const { return std::string(name, nameLength); }
+    // Copia editable (los puntos pasan al PointPool)
+    Figure ToFigure() const;
+};
+
+// Biblioteca abierta: Open() solo mapea el archivo y comprueba la cabecera, así que no depende
+// del tamaño; lo que cuesta es lo que se lea después. Cada registro se comprueba al leerlo con
+// GetFigure().
+class FigureLibrary
+{
+private:
+    MappedFile file;
+    const FigureLibraryHeader *header;
+    const FigureLibraryRecord *records;
+    const HomogenVector *points;
+    const char *names;
+
+public:
+    FigureLibrary();
+
+    FigureLibrary(const FigureLibrary &) = delete;
+    FigureLibrary &operator=(const FigureLibrary &) = delete;
+
+    // false si no se puede mapear, no es una biblioteca, es de otra versión o está truncada
+    bool Open(const std::string &path);
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+
+    size_t GetFigureCount() const { return header ? static_cast<size_t>(header->figureCount) : 0; }
+    size_t GetPointCount() const { return header ? static_cast<size_t>(header->pointCount) : 0; }
+    // false si index no existe o el registro apunta fuera de sus secciones
+    bool GetFigure(size_t index, FigureView &view) const;
+};
+
+// Escribe una biblioteca figura a figura: los puntos van directos al archivo y en memoria solo
+// quedan los registros y los nombres. Hasta Finish() la cabecera no es válida, así que un
+// archivo a medias nunca se abre como biblioteca.
+class FigureLibraryWriter
+{
+private:
+    std::ofstream file;
+    std::string filePath;
+    std::vector<FigureLibraryRecord> records;
+    std::string names;
+    uint64_t pointCount;
+    bool failed;
+
+    void WritePadding(size_t alignment);
+
+public:
+    FigureLibraryWriter();
+
+    // false si no se puede crear el archivo
+    bool Open(const std::string &path);
+    bool Add(const Figure &figure);
+    // Escribe la tabla, los nombres y la cabecera, cierra y pasa el archivo a disco (fsync /
+    // FlushFileBuffers). false si falló alguna escritura, el cierre o el volcado
+    bool Finish();
+
+    size_t GetFigureCount() const { return records.size(); }
+};
+
+// Atajos: toda la lista de un FigureStore, y todas las figuras de un archivo añadidas a un store.
+// WriteFigureLibrary escribe en path + ".tmp" y lo renombra a path solo tras un Finish() correcto.
+// ReadFigureLibrary copia todos los puntos al store (PointPool): cuesta lo que ocupa el archivo;
+// para leer sin copiar, FigureLibrary y FigureView.
+bool WriteFigureLibrary(const std::string &path, const FigureListView &figures);
+bool ReadFigureLibrary(const std::string &path, FigureStore &store, std::vector<FigureHandle> &handles);
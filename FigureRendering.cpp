@@ -0,0 +1,184 @@
+// FigureRendering.cpp
+#include "FigureRendering.h"
+#include <algorithm>
+
+void RenderFigure(IRenderBackend &backend, FigureBufferCache &buffers, const Figure &figure,
+                  const Color &color, float lineWidth, float pointSize)
+{
+    FigureBuffer buffer = buffers.Prepare(figure);
+    if (buffer.count < 2)
+        return;
+
+    // La transformación acumulada va en la matriz de modelo: mover o rotar no vuelve a subir vértices
+    backend.SetModelMatrix(figure.GetTransform());
+
+    // Línea y puntos desde el mismo buffer
+    backend.SetColor(color);
+    backend.SetLineWidth(lineWidth);
+    buffers.DrawLineStrip(buffer);
+
+    backend.SetPointSize(pointSize);
+    buffers.DrawPoints(buffer);
+
+    backend.SetModelMatrix(TransformMatrix::Identity());
+}
+
+void RenderThumbnailGrid(IRenderBackend &backend, ThumbnailGrid &grid, const FigureListView &figures,
+                         size_t firstVisibleRow)
+{
+    // Solo la página visible: recalcula celdas o sube vértices si cambió alguna figura visible
+    grid.Update(figures, firstVisibleRow);
+
+    const auto &instances = grid.GetInstances();
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        const auto &instance = instances[i];
+        if (instance.count < 2)
+            continue;
+
+        // Celda y transformación de la figura en la matriz de modelo
+        backend.SetModelMatrix(instance.model);
+
+        // Usar el color original de la figura
+        backend.SetColor(figures.Get(instance.figureIndex)->GetColor());
+
+        // Dibujar línea y puntos de la figura desde el buffer compartido
+        backend.SetLineWidth(2.0f);
+        grid.DrawLineStrip(instance);
+        backend.SetPointSize(4.0f);
+        grid.DrawPoints(instance);
+    }
+
+    backend.SetModelMatrix(TransformMatrix::Identity());
+}
+
+void RenderColorPicker(IRenderBackend &backend, const std::vector<Color> &colors, size_t buttonCount,
+                       const Color &selected, int clientWidth, int clientHeight)
+{
+    // Draw color buttons backgrounds (synchronized with Windows buttons)
+    int buttonSize = 25;
+    int margin = 5;
+    int startX = clientWidth - (5 * buttonSize + 6 * margin) - 1;
+    int startY = clientHeight - (4 * buttonSize + 5 * margin) - 150;
+
+    // Todos los botones en un lote: rellenos, bordes finos y el borde grueso en tres llamadas
+    PrimitiveBatch batch;
+    for (size_t i = 0; i < buttonCount && i < colors.size(); ++i)
+    {
+        Color buttonColor = colors[i];
+
+        // Calculate position for this color button
+        int row = static_cast<int>(i) / 5;
+        int col = static_cast<int>(i) % 5;
+        int x = startX + col * (buttonSize + margin);
+        int y = startY + row * (buttonSize + margin);
+
+        // Convert button coordinates to OpenGL
+        float glX = (2.0f * x / clientWidth) - 1.0f;
+        float glY = 1.0f - (2.0f * y / clientHeight);
+        float glWidth = (2.0f * buttonSize / clientWidth);
+        float glHeight = (2.0f * buttonSize / clientHeight);
+
+        // Draw filled rectangle
+        batch.AddQuad(glX, glY, glX + glWidth, glY - glHeight, buttonColor);
+
+        const float border[8] = {glX, glY, glX + glWidth, glY, glX + glWidth, glY - glHeight, glX, glY - glHeight};
+
+        // Draw black border if not selected color
+        if (buttonColor.r != selected.r || buttonColor.g != selected.g || buttonColor.b != selected.b)
+        {
+            batch.AddLineLoop(border, 4, Color(0.0f, 0.0f, 0.0f), 1.0f);
+        }
+        else
+        {
+            // Draw white border for selected color
+            batch.AddLineLoop(border, 4, Color(1.0f, 1.0f, 1.0f), 3.0f);
+        }
+    }
+
+    batch.Build();
+    backend.DrawBatch(batch);
+}
+
+void RenderPivot(IRenderBackend &backend, float pivotX, float pivotY)
+{
+    const Color red(1.0f, 0.0f, 0.0f);
+    float size = 0.02f;
+    const float box[8] = {pivotX - size, pivotY - size, pivotX + size, pivotY - size,
+                          pivotX + size, pivotY + size, pivotX - size, pivotY + size};
+
+    PrimitiveBatch batch;
+    batch.AddPoint(pivotX, pivotY, red, 8.0f);
+    batch.AddLineLoop(box, 4, red, 2.0f);
+    batch.Build();
+    backend.DrawBatch(batch);
+}
+
+void RenderFrameStatsOverlay(IRenderBackend &backend, const FrameStatsSummary &stats, int clientWidth, int clientHeight)
+{
+    if (clientWidth <= 0 || clientHeight <= 0)
+        return;
+
+    const double FRAME_BUDGET_MICROSECONDS = 1000000.0 / 60.0;
+    const int SHOWN_BUCKETS = 22; // Hasta ~2 s
+    int barWidth = 6;
+    int histogramHeight = 60;
+    int margin = 10;
+    int panelWidth = SHOWN_BUCKETS * barWidth + 2 * margin;
+    int panelHeight = histogramHeight + 3 * margin + 2 * barWidth * 2;
+
+    // Píxeles (origen arriba a la izquierda) a coordenadas OpenGL
+    auto toGLX = [clientWidth](int x) { return (2.0f * x / clientWidth) - 1.0f; };
+    auto toGLY = [clientHeight](int y) { return 1.0f - (2.0f * y / clientHeight); };
+
+    int panelLeft = margin;
+    int panelTop = clientHeight - margin - panelHeight;
+
+    PrimitiveBatch batch;
+    batch.AddQuad(toGLX(panelLeft), toGLY(panelTop), toGLX(panelLeft + panelWidth), toGLY(panelTop + panelHeight),
+                  Color(0.0f, 0.0f, 0.0f));
+
+    // Histograma del tiempo de dibujo
+    const HistogramSummary &paint = stats.paintMicroseconds;
+    uint32_t tallest = 1;
+    for (int i = 0; i < SHOWN_BUCKETS; ++i)
+    {
+        tallest = (std::max)(tallest, paint.buckets[i]);
+    }
+
+    int baseline = panelTop + margin + histogramHeight;
+    int budgetBucket = RollingHistogram::GetBucketIndex(FRAME_BUDGET_MICROSECONDS);
+    for (int i = 0; i < SHOWN_BUCKETS; ++i)
+    {
+        if (paint.buckets[i] == 0)
+            continue;
+        int x = panelLeft + margin + i * barWidth;
+        int height = (std::max)(1, static_cast<int>(histogramHeight * paint.buckets[i] / tallest));
+        Color barColor = i < budgetBucket ? Color(0.2f, 0.9f, 0.2f) : Color(0.9f, 0.2f, 0.2f);
+        batch.AddQuad(toGLX(x), toGLY(baseline - height), toGLX(x + barWidth - 1), toGLY(baseline), barColor);
+    }
+
+    int budgetX = panelLeft + margin + budgetBucket * barWidth;
+    batch.AddLine(toGLX(budgetX), toGLY(baseline - histogramHeight), toGLX(budgetX), toGLY(baseline),
+                  Color(1.0f, 0.0f, 0.0f), 1.0f);
+
+    // Mediana y percentil 95 como fracción del presupuesto (la barra entera = un frame de 60 Hz)
+    const double values[2] = {paint.p50, paint.p95};
+    int barsLeft = panelLeft + margin;
+    int barsWidth = panelWidth - 2 * margin;
+    for (int i = 0; i < 2; ++i)
+    {
+        int top = baseline + margin + i * (barWidth * 2);
+        double fraction = (std::min)(1.0, values[i] / FRAME_BUDGET_MICROSECONDS);
+        Color fill = fraction < 0.5 ? Color(0.2f, 0.9f, 0.2f) : (fraction < 1.0 ? Color(0.9f, 0.9f, 0.2f) : Color(0.9f, 0.2f, 0.2f));
+
+        batch.AddQuad(toGLX(barsLeft), toGLY(top), toGLX(barsLeft + barsWidth), toGLY(top + barWidth),
+                      Color(0.25f, 0.25f, 0.25f));
+        batch.AddQuad(toGLX(barsLeft), toGLY(top),
+                      toGLX(barsLeft + (std::max)(1, static_cast<int>(barsWidth * fraction))), toGLY(top + barWidth), fill);
+    }
+
+    batch.Build();
+    backend.SetModelMatrix(TransformMatrix::Identity());
+    backend.DrawBatch(batch);
+}
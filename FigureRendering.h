@@ -0,0 +1,31 @@
+// FigureRendering.h - Window contents drawn through IRenderBackend (same code for OpenGL and headless runs)
+#pragma once
+#include "IRenderBackend.h"
+#include "FigureBufferCache.h"
+#include "ThumbnailGrid.h"
+#include "Figure.h"
+#include "Color.h"
+#include "FrameStats.h"
+#include <memory>
+#include <vector>
+
+// Figura desde su buffer retenido, con su transformación acumulada como matriz de modelo
+void RenderFigure(IRenderBackend &backend, FigureBufferCache &buffers, const Figure &figure,
+                  const Color &color, float lineWidth, float pointSize);
+
+// Grid de miniaturas de MainWindow: la página que empieza en firstVisibleRow (llama a grid.Update)
+void RenderThumbnailGrid(IRenderBackend &backend, ThumbnailGrid &grid, const FigureListView &figures,
+                         size_t firstVisibleRow = 0);
+
+// Paleta de DrawingWindow: buttonCount botones de 5 por fila en la esquina inferior derecha
+// de un área cliente de clientWidth x clientHeight píxeles
+void RenderColorPicker(IRenderBackend &backend, const std::vector<Color> &colors, size_t buttonCount,
+                       const Color &selected, int clientWidth, int clientHeight);
+
+// Marca del pivote de FigureViewerWindow
+void RenderPivot(IRenderBackend &backend, float pivotX, float pivotY);
+
+// Superposición de FrameStats en la esquina inferior izquierda: histograma del tiempo de dibujo
+// (cubetas de potencias de dos en µs, la marca roja es el presupuesto de 60 Hz) y barras con
+// la mediana y el percentil 95 frente a ese presupuesto
+void RenderFrameStatsOverlay(IRenderBackend &backend, const FrameStatsSummary &stats, int clientWidth, int clientHeight);
@@ -0,0 +1,107 @@
+// FigureStore.cpp
+#include "FigureStore.h"
+#include <new>
+
+FigureStore::Slot *FigureStore::GetSlot(FigureHandle handle)
+{
+    if (!handle.IsValid() || handle.index >= slotCount)
+        return nullptr;
+
+    Slot &slot = chunks[handle.index / CHUNK_SIZE][handle.index % CHUNK_SIZE];
+    return (slot.alive && slot.generation == handle.generation) ? &slot : nullptr;
+}
+
+const FigureStore::Slot *FigureStore::GetSlot(FigureHandle handle) const
+{
+    return const_cast<FigureStore *>(this)->GetSlot(handle);
+}
+
+FigureHandle FigureStore::Add(Figure &&figure)
+{
+    uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        if (slotCount == chunks.size() * CHUNK_SIZE)
+            chunks.emplace_back(new Slot[CHUNK_SIZE]);
+        index = static_cast<uint32_t>(slotCount++);
+    }
+
+    Slot &slot = chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+    new (&slot.figure) Figure(std::move(figure));
+    slot.alive = true;
+    liveCount++;
+
+    FigureHandle handle;
+    handle.index = index;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+bool FigureStore::Remove(FigureHandle handle)
+{
+    Slot *slot = GetSlot(handle);
+    if (!slot)
+        return false;
+
+    // Devuelve los puntos al pool ya, no cuando se reutilice el hueco
+    slot->figure.~Figure();
+    slot->alive = false;
+    slot->generation++;
+    freeSlots.push_back(handle.index);
+    liveCount--;
+    return true;
+}
+
+void FigureStore::Clear()
+{
+    ForEach([](FigureHandle, Figure &figure)
+            { figure.~Figure(); });
+    chunks.clear();
+    slotCount = 0;
+    freeSlots.clear();
+    liveCount = 0;
+}
+
+Figure *FigureStore::Get(FigureHandle handle)
+{
+    Slot *slot = GetSlot(handle);
+    return slot ? &slot->figure : nullptr;
+}
+
+const Figure *FigureStore::Get(FigureHandle handle) const
+{
+    const Slot *slot = GetSlot(handle);
+    return slot ? &slot->figure : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// FigureListView
+// ---------------------------------------------------------------------------
+
+FigureListView::FigureListView(const FigureStore &figureStore, const std::vector<FigureHandle> &handles)
+    : list(&handles), store(&figureStore), count(handles.size()),
+      get([](const void *list, const void *store, size_t index) -> const Figure *
+          {
+              const auto &handles = *static_cast<const std::vector<FigureHandle> *>(list);
+              return static_cast<const FigureStore *>(store)->Get(handles[index]); })
+{
+}
+
+FigureListView::FigureListView(const std::vector<std::shared_ptr<Figure>> &figures)
+    : list(&figures), store(nullptr), count(figures.size()),
+      get([](const void *list, const void *, size_t index) -> const Figure *
+          { return (*static_cast<const std::vector<std::shared_ptr<Figure>> *>(list))[index].get(); })
+{
+}
+
+FigureListView::FigureListView(const std::vector<const Figure *> &figures)
+    : list(&figures), store(nullptr), count(figures.size()),
+      get([](const void *list, const void *, size_t index) -> const Figure *
+          { return (*static_cast<const std::vector<const Figure *> *>(list))[index]; })
+{
+}
@@ -0,0 +1,120 @@
+// FigureStore.h - Central owner of figures: generational handles over stable, chunked storage
+#pragma once
+#include "Figure.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Referencia a una figura de un FigureStore. Al borrar la figura su hueco cambia de generación,
+// así que un handle antiguo deja de resolver (Get devuelve nullptr) aunque el hueco se reutilice.
+struct FigureHandle
+{
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID_INDEX; }
+    bool operator==(const FigureHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const FigureHandle &other) const { return !(*this == other); }
+};
+
+// Las figuras viven en bloques de CHUNK_SIZE huecos contiguos que nunca se mueven: los punteros
+// que devuelve Get siguen valiendo mientras la figura no se borre, y recorrerlas todas (ForEach)
+// es un barrido lineal. Los puntos de cada figura van al PointPool. No es seguro entre hilos.
+class FigureStore
+{
+public:
+    static const size_t CHUNK_SIZE = 256;
+
+private:
+    // La figura solo está construida mientras alive: añadir la construye en su sitio y borrar la
+    // destruye, sin crear una Figure vacía para dejarla en el hueco
+    struct Slot
+    {
+        // Delante de la figura: Get los comprueba en la misma línea de caché que su id y versiones
+        uint32_t generation = 1;
+        bool alive = false;
+        union
+        {
+            Figure figure;
+        };
+
+        Slot() {}
+        ~Slot() {}
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks; // Bloques de CHUNK_SIZE huecos que nunca se mueven
+    size_t slotCount;                            // Huecos ya usados alguna vez (el resto del último bloque está libre)
+    std::vector<uint32_t> freeSlots;
+    size_t liveCount;
+
+    Slot *GetSlot(FigureHandle handle);
+    const Slot *GetSlot(FigureHandle handle) const;
+
+public:
+    FigureStore() : slotCount(0), liveCount(0) {}
+    ~FigureStore() { Clear(); }
+
+    FigureStore(const FigureStore &) = delete;
+    FigureStore &operator=(const FigureStore &) = delete;
+
+    FigureHandle Add(Figure &&figure);
+    // false si el handle ya no era válido
+    bool Remove(FigureHandle handle);
+    void Clear();
+
+    Figure *Get(FigureHandle handle);
+    const Figure *Get(FigureHandle handle) const;
+    bool Contains(FigureHandle handle) const { return GetSlot(handle) != nullptr; }
+
+    size_t GetCount() const { return liveCount; }
+    size_t GetCapacity() const { return chunks.size() * CHUNK_SIZE; }
+
+    // function(FigureHandle, Figure &) para cada figura viva, en orden de hueco
+    template <typename Function>
+    void ForEach(Function function)
+    {
+        for (size_t c = 0; c < chunks.size(); ++c)
+        {
+            Slot *chunk = chunks[c].get();
+            size_t used = slotCount - c * CHUNK_SIZE;
+            if (used > CHUNK_SIZE)
+                used = CHUNK_SIZE;
+            for (size_t i = 0; i < used; ++i)
+            {
+                if (chunk[i].alive)
+                {
+                    FigureHandle handle;
+                    handle.index = static_cast<uint32_t>(c * CHUNK_SIZE + i);
+                    handle.generation = chunk[i].generation;
+                    function(handle, chunk[i].figure);
+                }
+            }
+        }
+    }
+};
+
+// Lista ordenada de figuras de solo lectura, sin copiarla ni tocar contadores de referencias.
+// Sirve para handles de un FigureStore, para los vector<shared_ptr<Figure>> de los snapshots y
+// para punteros sueltos. Solo guarda referencias: no debe vivir más que la lista que envuelve.
+class FigureListView
+{
+private:
+    using GetFunction = const Figure *(*)(const void *list, const void *store, size_t index);
+
+    const void *list;
+    const void *store;
+    size_t count;
+    GetFunction get;
+
+public:
+    FigureListView(const FigureStore &figureStore, const std::vector<FigureHandle> &handles);
+    FigureListView(const std::vector<std::shared_ptr<Figure>> &figures);
+    FigureListView(const std::vector<const Figure *> &figures);
+
+    size_t Size() const { return count; }
+    bool Empty() const { return count == 0; }
+    // nullptr si el elemento está vacío o su handle ya no es válido
+    const Figure *Get(size_t index) const { return get(list, store, index); }
+};
@@ -0,0 +1,374 @@
+// FigureVectorExporter.cpp
+#include "FigureVectorExporter.h"
+#include "TextWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+
+namespace
+{
+    const int JSON_FORMAT_VERSION = 1;
+
+    // Lo que necesitan los escritores de una Figure o de un FigureView, sin copiar nada
+    struct VectorFigure
+    {
+        const char *name = "";
+        size_t nameLength = 0;
+        Color color;
+        bool complete = false;
+        TransformMatrix transform;
+        const HomogenVector *points = nullptr; // Puntos contiguos; si no, figure->GetPoint()
+        const Figure *figure = nullptr;
+        size_t pointCount = 0;
+
+        HomogenVector GetPoint(size_t index) const { return points ? points[index] : figure->GetPoint(index); }
+    };
+
+    VectorFigure FromFigure(const Figure &figure)
+    {
+        VectorFigure exported;
+        exported.name = figure.GetName().data();
+        exported.nameLength = figure.GetName().size();
+        exported.color = figure.GetColor();
+        exported.complete = figure.IsComplete();
+        exported.transform = figure.GetTransform();
+        exported.figure = &figure;
+        exported.pointCount = figure.GetPointCount();
+        // En modo Columnar GetPoints() crearía la copia entrelazada: se lee punto a punto
+        if (figure.GetStorageMode() == PointStorageMode::Interleaved)
+            exported.points = figure.GetPoints().data();
+        return exported;
+    }
+
+    VectorFigure FromView(const FigureView &view)
+    {
+        VectorFigure exported;
+        exported.name = view.name;
+        exported.nameLength = view.nameLength;
+        exported.color = view.color;
+        exported.complete = view.complete;
+        exported.transform = view.transform;
+        exported.points = view.points;
+        exported.pointCount = view.pointCount;
+        return exported;
+    }
+
+    bool IsAffine(const TransformMatrix &transform)
+    {
+        return transform.m[2][0] == 0.0f && transform.m[2][1] == 0.0f && transform.m[2][2] == 1.0f;
+    }
+
+    // Recorre los puntos en coordenadas OpenGL, con la transformación aplicada o sin ella
+    template <typename Visit>
+    void ForEachPoint(const VectorFigure &figure, bool applyTransform, Visit visit)
+    {
+        bool transformPoints = applyTransform && !figure.transform.IsIdentity();
+        for (size_t i = 0; i < figure.pointCount; ++i)
+        {
+            HomogenVector point = figure.GetPoint(i);
+            if (transformPoints)
+                point = figure.transform.Apply(point);
+            float x, y;
+            point.ToOpenGL(x, y);
+            visit(x, y);
+        }
+    }
+
+    class IVectorDocument
+    {
+    public:
+        virtual ~IVectorDocument() = default;
+        virtual void Begin() = 0;
+        virtual void Add(const VectorFigure &figure) = 0;
+        virtual void End() = 0;
+    };
+
+    class SvgDocument : public IVectorDocument
+    {
+    private:
+        TextWriter &writer;
+        const VectorExportOptions &options;
+
+        void WriteColorChannel(float value)
+        {
+            float clamped = (std::min)((std::max)(value, 0.0f), 1.0f);
+            writer.WriteUnsigned(static_cast<uint64_t>(std::lround(clamped * 255.0f)));
+        }
+
+    public:
+        SvgDocument(TextWriter &target, const VectorExportOptions &exportOptions) : writer(target), options(exportOptions) {}
+
+        void Begin() override
+        {
+            int size = (std::max)(options.svgSize, 1);
+            writer.Write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+            writer.Write("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+            writer.WriteUnsigned(static_cast<uint64_t>(size));
+            writer.Write("\" height=\"");
+            writer.WriteUnsigned(static_cast<uint64_t>(size));
+            writer.Write("\" viewBox=\"-1 -1 2 2\">\n");
+            // El eje y de OpenGL crece hacia arriba y el de SVG hacia abajo
+            writer.Write("<g transform=\"scale(1,-1)\" fill=\"none\" stroke-linejoin=\"round\" stroke-width=\"");
+            writer.WriteFloat(options.strokeWidth);
+            writer.Write("\">\n");
+        }
+
+        void Add(const VectorFigure &figure) override
+        {
+            bool asAttribute = options.transformMode == VectorTransformMode::Attribute &&
+                               !figure.transform.IsIdentity() && IsAffine(figure.transform);
+            const char *element = figure.complete ? "polygon" : "polyline";
+
+            writer.Put('<');
+            writer.Write(element);
+            writer.Write(" stroke=\"rgb(");
+            WriteColorChannel(figure.color.r);
+            writer.Put(',');
+            WriteColorChannel(figure.color.g);
+            writer.Put(',');
+            WriteColorChannel(figure.color.b);
+            writer.Write(")\" vector-effect=\"non-scaling-stroke\"");
+
+            if (asAttribute)
+            {
+                // matrix(a b c d e f): x' = a x + c y + e, y' = b x + d y + f
+                const TransformMatrix &t = figure.transform;
+                const float values[6] = {t.m[0][0], t.m[1][0], t.m[0][1], t.m[1][1], t.m[0][2], t.m[1][2]};
+                writer.Write(" transform=\"matrix(");
+                for (int i = 0; i < 6; ++i)
+                {
+                    if (i > 0)
+                        writer.Put(' ');
+                    writer.WriteFloat(values[i]);
+                }
+                writer.Write(")\"");
+            }
+
+            writer.Write(" points=\"");
+            bool first = true;
+            ForEachPoint(figure, !asAttribute, [this, &first](float x, float y)
+                         {
+                             if (!first)
+                                 writer.Put(' ');
+                             first = false;
+                             writer.WriteFloat(x);
+                             writer.Put(',');
+                             writer.WriteFloat(y);
+                         });
+            writer.Write("\"><title>");
+            writer.WriteXmlText(figure.name, figure.nameLength);
+            writer.Write("</title></");
+            writer.Write(element);
+            writer.Write(">\n");
+        }
+
+        void End() override
+        {
+            writer.Write("</g>\n</svg>\n");
+        }
+    };
+
+    class JsonDocument : public IVectorDocument
+    {
+    private:
+        TextWriter &writer;
+        const VectorExportOptions &options;
+        bool firstFigure;
+
+        void WriteNumber(float value) { writer.WriteFloat(value, "null"); }
+
+    public:
+        JsonDocument(TextWriter &target, const VectorExportOptions &exportOptions)
+            : writer(target), options(exportOptions), firstFigure(true) {}
+
+        void Begin() override
+        {
+            writer.Write("{\"format\":\"figures\",\"version\":");
+            writer.WriteUnsigned(JSON_FORMAT_VERSION);
+            writer.Write(",\"transformMode\":");
+            writer.Write(options.transformMode == VectorTransformMode::Apply ? "\"apply\"" : "\"attribute\"");
+            writer.Write(",\"figures\":[");
+            firstFigure = true;
+        }
+
+        // Una figura por línea, con las claves siempre en el mismo orden
+        void Add(const VectorFigure &figure) override
+        {
+            bool asAttribute = options.transformMode == VectorTransformMode::Attribute;
+
+            writer.Write(firstFigure ? "\n" : ",\n");
+            firstFigure = false;
+            writer.Write("{\"name\":");
+            writer.WriteJsonString(figure.name, figure.nameLength);
+            writer.Write(",\"color\":[");
+            WriteNumber(figure.color.r);
+            writer.Put(',');
+            WriteNumber(figure.color.g);
+            writer.Put(',');
+            WriteNumber(figure.color.b);
+            writer.Write("],\"complete\":");
+            writer.Write(figure.complete ? "true" : "false");
+
+            if (asAttribute)
+            {
+                // Completa (también la fila proyectiva), por filas
+                writer.Write(",\"transform\":[");
+                for (int row = 0; row < 3; ++row)
+                {
+                    writer.Write(row > 0 ? ",[" : "[");
+                    for (int col = 0; col < 3; ++col)
+                    {
+                        if (col > 0)
+                            writer.Put(',');
+                        WriteNumber(figure.transform.m[row][col]);
+                    }
+                    writer.Put(']');
+                }
+                writer.Put(']');
+            }
+
+            writer.Write(",\"points\":[");
+            bool first = true;
+            ForEachPoint(figure, !asAttribute, [this, &first](float x, float y)
+                         {
+                             writer.Write(first ? "[" : ",[");
+                             first = false;
+                             WriteNumber(x);
+                             writer.Put(',');
+                             WriteNumber(y);
+                             writer.Put(']');
+                         });
+            writer.Write("]}");
+        }
+
+        void End() override
+        {
+            writer.Write("\n]}\n");
+        }
+    };
+
+    // getFigure(i, exported): false si la figura i no se puede leer (se omite)
+    template <typename GetFigure>
+    bool WriteDocument(std::ostream &output, VectorFormat format, const VectorExportOptions &options,
+                       size_t count, GetFigure getFigure)
+    {
+        TextWriter writer(output);
+        SvgDocument svg(writer, options);
+        JsonDocument json(writer, options);
+        IVectorDocument &document = format == VectorFormat::SVG ? static_cast<IVectorDocument &>(svg) : json;
+
+        bool allFigures = true;
+        document.Begin();
+        for (size_t i = 0; i < count; ++i)
+        {
+            VectorFigure figure;
+            if (getFigure(i, figure))
+                document.Add(figure);
+            else
+                allFigures = false;
+        }
+        document.End();
+        writer.Flush();
+        return allFigures && writer.IsGood();
+    }
+
+    bool OpenVectorFile(const std::string &path, std::ofstream &file, VectorFormat &format)
+    {
+        if (!GetVectorFormat(path, format))
+            return false;
+        // Binario: los mismos bytes en todas las plataformas (sin \r\n en Windows)
+        file.open(path, std::ios::binary | std::ios::trunc);
+        return static_cast<bool>(file);
+    }
+}
+
+bool GetVectorFormat(const std::string &path, VectorFormat &format)
+{
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos)
+        return false;
+
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    if (extension == "svg")
+        format = VectorFormat::SVG;
+    else if (extension == "json")
+        format = VectorFormat::JSON;
+    else
+        return false;
+    return true;
+}
+
+bool WriteVectorFigures(std::ostream &output, VectorFormat format, const FigureListView &figures,
+                        const VectorExportOptions &options)
+{
+    return WriteDocument(output, format, options, figures.Size(),
+                         [&figures](size_t index, VectorFigure &exported)
+                         {
+                             const Figure *figure = figures.Get(index);
+                             if (!figure)
+                                 return false;
+                             exported = FromFigure(*figure);
+                             return true;
+                         });
+}
+
+bool WriteVectorFigure(std::ostream &output, VectorFormat format, const Figure &figure,
+                       const VectorExportOptions &options)
+{
+    return WriteDocument(output, format, options, 1,
+                         [&figure](size_t, VectorFigure &exported)
+                         {
+                             exported = FromFigure(figure);
+                             return true;
+                         });
+}
+
+bool WriteVectorLibrary(std::ostream &output, VectorFormat format, const FigureLibrary &library,
+                        const VectorExportOptions &options)
+{
+    return WriteDocument(output, format, options, library.GetFigureCount(),
+                         [&library](size_t index, VectorFigure &exported)
+                         {
+                             FigureView view;
+                             if (!library.GetFigure(index, view))
+                                 return false;
+                             exported = FromView(view);
+                             return true;
+                         });
+}
+
+bool ExportVectorFigures(const std::string &path, const FigureListView &figures, const VectorExportOptions &options)
+{
+    VectorFormat format;
+    std::ofstream file;
+    if (!OpenVectorFile(path, file, format))
+        return false;
+    bool written = WriteVectorFigures(file, format, figures, options);
+    file.close();
+    return written && !file.fail();
+}
+
+bool ExportVectorFigure(const std::string &path, const Figure &figure, const VectorExportOptions &options)
+{
+    VectorFormat format;
+    std::ofstream file;
+    if (!OpenVectorFile(path, file, format))
+        return false;
+    bool written = WriteVectorFigure(file, format, figure, options);
+    file.close();
+    return written && !file.fail();
+}
+
+bool ExportVectorLibrary(const std::string &path, const FigureLibrary &library, const VectorExportOptions &options)
+{
+    VectorFormat format;
+    std::ofstream file;
+    if (!OpenVectorFile(path, file, format))
+        return false;
+    bool written = WriteVectorLibrary(file, format, library, options);
+    file.close();
+    return written && !file.fail();
+}
@@ -0,0 +1,52 @@
+// FigureVectorExporter.h - Streaming SVG and JSON export of figures and figure libraries
+#pragma once
+#include "Figure.h"
+#include "FigureStore.h"
+#include "FigureLibrary.h"
+#include <ostream>
+#include <string>
+
+enum class VectorFormat
+{
+    SVG, // <polyline>/<polygon> por figura, en el espacio OpenGL [-1, 1] con el eje y hacia arriba
+    JSON // {"figures": [{"name", "color", "complete", ["transform",] "points": [[x, y], ...]}]}
+};
+
+// Por la extensión (.svg, .json). false si no se reconoce
+bool GetVectorFormat(const std::string &path, VectorFormat &format);
+
+enum class VectorTransformMode
+{
+    Apply,    // Puntos ya transformados (lo que se ve en pantalla)
+    Attribute // Puntos originales y la transformación aparte (transform de SVG, "transform" en JSON)
+};
+
+struct VectorExportOptions
+{
+    VectorTransformMode transformMode = VectorTransformMode::Apply;
+    int svgSize = 800;         // Ancho y alto del SVG en píxeles
+    float strokeWidth = 2.0f;  // En píxeles, no cambia con la transformación
+};
+
+// Los puntos se escriben según se recorren, a través de un buffer fijo (TextWriter): exportar
+// millones de puntos no construye el documento en memoria ni reserva nada por punto. La salida
+// solo depende de las figuras (orden, números con el formato más corto que recupera el float
+// exacto, sin fechas ni identificadores), así que dos exportaciones iguales se pueden comparar
+// con diff. En SVG una transformación proyectiva no cabe en matrix(): esas figuras se exportan
+// siempre con la transformación aplicada. false si falla la escritura o alguna figura no se pudo
+// leer (las demás se escriben igualmente).
+bool WriteVectorFigures(std::ostream &output, VectorFormat format, const FigureListView &figures,
+                        const VectorExportOptions &options = VectorExportOptions());
+bool WriteVectorFigure(std::ostream &output, VectorFormat format, const Figure &figure,
+                       const VectorExportOptions &options = VectorExportOptions());
+// Directamente desde el archivo mapeado, sin copiar las figuras
+bool WriteVectorLibrary(std::ostream &output, VectorFormat format, const FigureLibrary &library,
+                        const VectorExportOptions &options = VectorExportOptions());
+
+// Formato por la extensión; false también si no se reconoce o no se puede crear el archivo
+bool ExportVectorFigures(const std::string &path, const FigureListView &figures,
+                         const VectorExportOptions &options = VectorExportOptions());
+bool ExportVectorFigure(const std::string &path, const Figure &figure,
+                        const VectorExportOptions &options = VectorExportOptions());
+bool ExportVectorLibrary(const std::string &path, const FigureLibrary &library,
+                         const VectorExportOptions &options = VectorExportOptions());
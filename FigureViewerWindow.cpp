@@ -1,13 +1,27 @@
 // FigureViewerWindow.cpp
 #include "FigureViewerWindow.h"
+#include "FigureRendering.h"
+#include "FigureVectorExporter.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm> // Para std::min y std::max
 #include <limits>    // Para std::numeric_limits
 
-FigureViewerWindow::FigureViewerWindow(const WindowConfig &config, const std::vector<std::shared_ptr<Figure>> &figuresToView)
-    : Window(config), figures(figuresToView), currentFigureIndex(0), hasPivot(false), sPressed(false), tPressed(false), rPressed(false), gPressed(false)
+FigureViewerWindow::FigureViewerWindow(const WindowConfig &config, FigureStore &source, FigureHistory &sourceHistory,
+                                       const std::vector<FigureHandle> &figuresToView, std::function<void()> onFigurePublished)
+    : Window(config), source(source), sourceHistory(sourceHistory), onFigurePublished(std::move(onFigurePublished)),
+      recordBeforeTransform(false), currentFigureIndex(0), pivotX(0.0f), pivotY(0.0f), hasPivot(false)
 {
+    // Copiar una figura no copia sus puntos
+    for (const auto &handle : figuresToView)
+    {
+        if (const Figure *figure = source.Get(handle))
+        {
+            sources.push_back(handle);
+            figures.push_back(store.Add(Figure(*figure)));
+        }
+    }
+
     // Configurar botones de navegación carrusel
     leftButton = std::make_unique<Button>(10, 10, 50, 30, L"<-");
     rightButton = std::make_unique<Button>(70, 10, 50, 30, L"->");
@@ -60,16 +74,29 @@ LRESULT FigureViewerWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LP
         auto *renderer = GetRenderer();
         if (renderer)
         {
+            // Antes del cambio de contexto y de aplicar las teclas: son parte del frame
+            FrameRecorder recorder = BeginFrameStats();
+
             // Asegurar que el contexto OpenGL esté activo
-            wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+            renderer->MakeCurrent();
 
-            renderer->Render();
-            DrawSingleFigure();
-            if (hasPivot)
+            ApplyPendingInput();
+            uint64_t sceneVersion = GetSceneVersion();
+            // Sin cambios desde el último frame no se dibuja ni se intercambian buffers:
+            // la composición del escritorio conserva la última imagen presentada
+            if (frameTracker.ShouldRender(sceneVersion))
             {
-                DrawPivotPoint();
+                renderer->Render();
+                DrawSingleFigure();
+                if (hasPivot)
+                {
+                    DrawPivotPoint();
+                }
+                EndFrameStats(recorder);
+                DrawStatsOverlay();
+                renderer->SwapBuffers();
+                frameTracker.MarkRendered(sceneVersion);
             }
-            renderer->SwapBuffers();
         }
 
         EndPaint(GetWindowHandle(), &ps);
@@ -87,11 +114,12 @@ LRESULT FigureViewerWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LP
             if (renderer)
             {
                 // Asegurar que el contexto OpenGL esté activo
-                wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+                renderer->MakeCurrent();
                 glViewport(0, 0, width, height);
             }
         }
 
+        frameTracker.Invalidate();
         InvalidateRect(GetWindowHandle(), nullptr, FALSE);
         return 0;
     }
@@ -106,14 +134,28 @@ LRESULT FigureViewerWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LP
 
     case WM_KEYDOWN:
     {
-        UpdateKeyState(wParam, true);
-        HandleKeyboard(wParam);
+        if (HandleStatsKey(wParam))
+            return 0;
+        if (wParam == VK_F5)
+        {
+            ExportCurrentFigure();
+            return 0;
+        }
+        // Bit 30: la tecla ya estaba pulsada (repetición automática)
+        HandleKeyboard(wParam, (lParam & (1 << 30)) != 0);
         return 0;
     }
 
     case WM_KEYUP:
     {
-        UpdateKeyState(wParam, false);
+        input.KeyUp(ToViewerKey(wParam));
+        return 0;
+    }
+
+    case WM_KILLFOCUS:
+    {
+        // Sin foco no llegan los WM_KEYUP: soltar S/T/R para que no queden "pegadas"
+        input.ReleaseModifiers();
         return 0;
     }
     }
@@ -121,53 +163,50 @@ LRESULT FigureViewerWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LP
     return Window::HandleMessage(hwnd, msg, wParam, lParam);
 }
 
-void FigureViewerWindow::DrawSingleFigure()
+uint64_t FigureViewerWindow::GetSceneVersion() const
 {
-    auto *renderer = GetRenderer();
-    if (!renderer || figures.empty() || currentFigureIndex >= figures.size())
-        return;
+    uint64_t version = viewVersion.Get();
+    if (const Figure *figure = GetCurrentFigure())
+        version = (std::max)(version, figure->GetVersion());
+    return version;
+}
 
-    auto figure = figures[currentFigureIndex];
-    if (!figure)
-        return;
+Figure *FigureViewerWindow::GetCurrentFigure()
+{
+    if (currentFigureIndex >= figures.size())
+        return nullptr;
+    return store.Get(figures[currentFigureIndex]);
+}
 
-    wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+const Figure *FigureViewerWindow::GetCurrentFigure() const
+{
+    if (currentFigureIndex >= figures.size())
+        return nullptr;
+    return store.Get(figures[currentFigureIndex]);
+}
 
-    const auto &points = figure->GetPoints();
-    if (points.size() < 2)
+void FigureViewerWindow::DrawSingleFigure()
+{
+    auto *renderer = GetRenderer();
+    Figure *figure = GetCurrentFigure();
+    if (!renderer || !figure)
         return;
 
-    Color figureColor = figure->GetColor();
+    renderer->MakeCurrent();
 
     // Dibujar SIN recentrar
-    glColor3f(figureColor.r, figureColor.g, figureColor.b);
-    glLineWidth(3.0f);
-
-    glBegin(GL_LINE_STRIP);
-    for (const auto &point : points)
-    {
-        float glX, glY;
-        point.ToOpenGL(glX, glY);
-        glVertex2f(glX, glY); // Coordenadas directas
-    }
-    glEnd();
-
-    glPointSize(6.0f);
-    glBegin(GL_POINTS);
-    for (const auto &point : points)
-    {
-        float glX, glY;
-        point.ToOpenGL(glX, glY);
-        glVertex2f(glX, glY);
-    }
-    glEnd();
+    RenderFigure(*GetRenderBackend(), *GetFigureBuffers(), *figure, figure->GetColor(), 3.0f, 6.0f);
 }
 
 void FigureViewerWindow::HandleClick(int x, int y)
 {
     // Convertir coordenadas de pantalla a OpenGL
-    pivotPoint = ScreenToOpenGL(x, y);
+    HomogenVector glPoint = ScreenToOpenGL(x, y);
+    pivotX = glPoint.x;
+    pivotY = glPoint.y;
     hasPivot = true;
+    viewVersion.Touch();
+    input.SetPivot(pivotX, pivotY);
     InvalidateRect(GetWindowHandle(), nullptr, FALSE);
 }
 
@@ -185,89 +224,63 @@ HomogenVector FigureViewerWindow::ScreenToOpenGL(int screenX, int screenY)
     return HomogenVector::FromOpenGL(glX, glY);
 }
 
-void FigureViewerWindow::HandleKeyboard(WPARAM wParam)
+void FigureViewerWindow::HandleKeyboard(WPARAM wParam, bool isRepeat)
 {
-    auto isDown = [](int vk) -> bool
+    switch (input.KeyDown(ToViewerKey(wParam)))
     {
-        return (GetAsyncKeyState(vk) & 0x8000) != 0;
-    };
+    case ViewerAction::Close:
+        PostMessage(GetWindowHandle(), WM_CLOSE, 0, 0);
+        break;
 
-    bool sDown = isDown('S');
-    bool tDown = isDown('T');
-    bool rDown = isDown('R');
+    case ViewerAction::Transform:
+        // Mantener una tecla es un solo paso de deshacer
+        if (!isRepeat)
+            recordBeforeTransform = true;
+        // Las repeticiones de tecla se acumulan hasta el próximo frame del FrameScheduler
+        RequestFrame();
+        break;
 
-    switch (wParam)
-    {
-    case VK_ESCAPE:
-        PostMessage(GetWindowHandle(), WM_CLOSE, 0, 0);
+    case ViewerAction::Undo:
+        UndoCurrentFigure();
         break;
 
-    case VK_RIGHT:
-        if (tDown)
-        {
-            traslate(TRANSLATE_STEP, 0);
-            break;
-        }
-        else if (sDown)
-        {
-            scale(SCALE_FACTOR, 1);
-        }
-        else if (rDown)
-        {
-            ROTATION_STEP += 0.2;
-            if (ROTATION_STEP >= 360)
-            {
-                ROTATION_STEP -= 360;
-            }
-            rotate(ROTATION_STEP);
-        }
-        else
-            NavigateToNextFigure();
+    case ViewerAction::NavigateNext:
+        NavigateToNextFigure();
         break;
 
-    case VK_LEFT:
-        if (sDown)
-        {
-            scale(1.0f / SCALE_FACTOR, 1);
-        }
-        else if (rDown)
-        {
-            ROTATION_STEP += 0.2f;
-            if (ROTATION_STEP >= 360)
-            {
-                ROTATION_STEP -= 360;
-            }
-            rotate(-ROTATION_STEP);
-        }
-        else if (tDown)
-        {
-            traslate(-TRANSLATE_STEP, 0); // CORREGIDO: quitar el + 0.1f
-        }
-        else
-            NavigateToPreviousFigure();
+    case ViewerAction::NavigatePrevious:
+        NavigateToPreviousFigure();
         break;
 
-    case VK_UP:
-        if (sDown)
-        {
-            scale(1, SCALE_FACTOR); // CORREGIDO: quitar el + 0.1f
-        }
-        else if (tDown)
-        {
-            traslate(0, TRANSLATE_STEP); // CORREGIDO: quitar el + 0.1f
-        }
+    default:
         break;
+    }
+}
 
+ViewerKey FigureViewerWindow::ToViewerKey(WPARAM wParam)
+{
+    switch (wParam)
+    {
+    case VK_LEFT:
+        return ViewerKey::Left;
+    case VK_RIGHT:
+        return ViewerKey::Right;
+    case VK_UP:
+        return ViewerKey::Up;
     case VK_DOWN:
-        if (sDown)
-        {
-            scale(1, 1.0f / SCALE_FACTOR); // CORREGIDO
-        }
-        else if (tDown)
-        {
-            traslate(0, -TRANSLATE_STEP); // CORREGIDO: quitar el + 0.1f
-        }
-        break;
+        return ViewerKey::Down;
+    case VK_ESCAPE:
+        return ViewerKey::Escape;
+    case 'Z':
+        return GetKeyState(VK_CONTROL) < 0 ? ViewerKey::Undo : ViewerKey::Other;
+    case 'T':
+        return ViewerKey::Translate;
+    case 'S':
+        return ViewerKey::Scale;
+    case 'R':
+        return ViewerKey::Rotate;
+    default:
+        return ViewerKey::Other;
     }
 }
 
@@ -276,26 +289,9 @@ void FigureViewerWindow::DrawPivotPoint()
     auto *renderer = GetRenderer();
     if (!renderer || !hasPivot)
         return;
-    wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
-
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glPointSize(8.0f);
-
-    glBegin(GL_POINTS);
-    float glX, glY;
-    pivotPoint.ToOpenGL(glX, glY);
-    glVertex2f(glX, glY);
-    glEnd();
-
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glLineWidth(2.0f);
-    float size = 0.02f;
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(glX - size, glY - size);
-    glVertex2f(glX + size, glY - size);
-    glVertex2f(glX + size, glY + size);
-    glVertex2f(glX - size, glY + size);
-    glEnd();
+    renderer->MakeCurrent();
+
+    RenderPivot(*GetRenderBackend(), pivotX, pivotY);
 }
 
 void FigureViewerWindow::NavigateToPreviousFigure()
@@ -303,12 +299,17 @@ void FigureViewerWindow::NavigateToPreviousFigure()
     if (figures.size() <= 1)
         return;
 
+    // Lo acumulado pertenece a la figura actual
+    ApplyPendingInput();
+
     if (currentFigureIndex == 0)
         currentFigureIndex = figures.size() - 1;
     else
         currentFigureIndex--;
     hasPivot = false;
-    ClearKeyState();
+    viewVersion.Touch();
+    input.ClearPivot();
+    input.ReleaseModifiers();
     InvalidateRect(GetWindowHandle(), nullptr, FALSE);
 }
 
@@ -317,13 +318,17 @@ void FigureViewerWindow::NavigateToNextFigure()
     if (figures.size() <= 1)
         return;
 
+    ApplyPendingInput();
+
     if (currentFigureIndex >= figures.size() - 1)
         currentFigureIndex = 0;
     else
         currentFigureIndex++;
 
     hasPivot = false;
-    ClearKeyState();
+    viewVersion.Touch();
+    input.ClearPivot();
+    input.ReleaseModifiers();
     InvalidateRect(GetWindowHandle(), nullptr, FALSE);
 }
 
@@ -337,142 +342,79 @@ void FigureViewerWindow::OnRightButtonClick()
     NavigateToNextFigure();
 }
 
-void FigureViewerWindow::UpdateKeyState(WPARAM wParam, bool pressed)
-{
-    switch (wParam)
-    {
-    case 'S':
-        sPressed = pressed;
-        break;
-    case 'T':
-        tPressed = pressed;
-        break;
-    case 'R':
-        rPressed = pressed;
-        break;
-    }
-}
-
-void FigureViewerWindow::rotate(float degree)
+void FigureViewerWindow::ApplyPendingInput()
 {
-    float angle = degree * PI / 180.0;
-    float rotateMatrix[3][3] = {
-        {std::cos(angle), -std::sin(angle), 0},
-        {std::sin(angle), std::cos(angle), 0},
-        {0, 0, 1}};
-    if (figures.empty() || currentFigureIndex >= figures.size())
+    if (!input.HasPendingIntent())
         return;
 
-    auto figure = figures[currentFigureIndex];
+    FrameIntent intent = input.TakeIntent();
+    Figure *figure = GetCurrentFigure();
     if (!figure)
         return;
-    auto &points = figure->GetPoints();
 
-    if (hasPivot)
+    if (recordBeforeTransform)
     {
-        float pivotX, pivotY;
-        pivotPoint.ToOpenGL(pivotX, pivotY);
-
-        for (auto &p : points)
-        {
-            p.x -= pivotX;
-            p.y -= pivotY;
-            p = matrix_prod(rotateMatrix, p);
-            p.x += pivotX;
-            p.y += pivotY;
-        }
+        // Se deshace a la versión que tiene MainWindow
+        if (const Figure *published = source.Get(sources[currentFigureIndex]))
+            sourceHistory.Record(sources[currentFigureIndex], *published);
+        recordBeforeTransform = false;
     }
+
+    // Una sola composición por frame, sin importar cuántas repeticiones de tecla llegaron. Sin
+    // rotación se aplica como escala + traslación, y la figura sigue en el kernel sin productos cruzados
+    if (intent.rotates)
+        figure->ApplyTransform(intent.transform);
     else
-    {
-        for (auto &p : points)
-        {
-            p = matrix_prod(rotateMatrix, p);
-        }
-    }
-    InvalidateRect(GetWindowHandle(), nullptr, FALSE);
-    UpdateWindow(GetWindowHandle());
+        figure->ApplyTransform(intent.axisAligned);
+    PublishCurrentFigure();
 }
 
-void FigureViewerWindow::traslate(float tx, float ty)
+void FigureViewerWindow::PublishCurrentFigure()
 {
-    float traslateMatrix[3][3] = {
-        {1, 0, tx},
-        {0, 1, ty},
-        {0, 0, 1}};
+    const Figure *figure = GetCurrentFigure();
+    Figure *published = figure ? source.Get(sources[currentFigureIndex]) : nullptr;
+    if (!published)
+        return; // Ya no existe en MainWindow: el cambio se queda en el visor
+
+    // Copia de la figura, no de los puntos: la versión anterior sigue en el historial
+    *published = *figure;
+    if (onFigurePublished)
+        onFigurePublished();
+}
 
-    if (figures.empty() || currentFigureIndex >= figures.size())
-        return;
+void FigureViewerWindow::UndoCurrentFigure()
+{
+    // Lo pendiente forma parte del último paso: se aplica y se deshace con él
+    ApplyPendingInput();
+    recordBeforeTransform = false;
 
-    auto figure = figures[currentFigureIndex];
-    if (!figure)
+    if (currentFigureIndex >= figures.size() || !sourceHistory.Undo(source, sources[currentFigureIndex]))
         return;
-    auto &points = figure->GetPoints();
 
-    for (auto &p : points)
-    {
-        p = matrix_prod(traslateMatrix, p);
-    }
+    // La versión restaurada vuelve también a la copia del visor
+    if (const Figure *restored = source.Get(sources[currentFigureIndex]))
+        *store.Get(figures[currentFigureIndex]) = *restored;
+    if (onFigurePublished)
+        onFigurePublished();
     InvalidateRect(GetWindowHandle(), nullptr, FALSE);
-    UpdateWindow(GetWindowHandle());
 }
 
-void FigureViewerWindow::scale(float sx, float sy)
+void FigureViewerWindow::ExportCurrentFigure()
 {
-    float scale_matrix[3][3] = {
-        {sx, 0, 0},
-        {0, sy, 0},
-        {0, 0, 1}};
-
-    if (figures.empty() || currentFigureIndex >= figures.size())
-        return;
-
-    auto figure = figures[currentFigureIndex];
+    // Con lo que haya pendiente aplicado: se exporta lo que se ve
+    ApplyPendingInput();
+    const Figure *figure = GetCurrentFigure();
     if (!figure)
         return;
-    auto &points = figure->GetPoints();
-
-    if (hasPivot)
-    {
-        float pivotX, pivotY;
-        pivotPoint.ToOpenGL(pivotX, pivotY);
 
-        for (auto &p : points)
-        {
-            p.x -= pivotX;
-            p.y -= pivotY;
-            p = matrix_prod(scale_matrix, p);
-            p.x += pivotX;
-            p.y += pivotY;
-        }
-    }
-    else
+    VectorExportOptions options;
+    options.transformMode = VectorTransformMode::Attribute;
+    for (const char *extension : {".svg", ".json"})
     {
-        // Escalar desde el origen si no hay pivote
-        for (auto &p : points)
-        {
-            p = matrix_prod(scale_matrix, p);
-        }
+        std::string path = "figure_" + std::to_string(currentFigureIndex) + extension;
+        if (ExportVectorFigure(path, *figure, options))
+            std::wcout << L"Exported " << figure->GetName().c_str() << L" to " << path.c_str() << std::endl;
+        else
+            std::wcout << L"Error: Could not export " << figure->GetName().c_str() << L" to " << path.c_str() << std::endl;
     }
-    InvalidateRect(GetWindowHandle(), nullptr, FALSE);
-    UpdateWindow(GetWindowHandle());
-}
-
-void FigureViewerWindow::ClearKeyState()
-{
-    sPressed = false;
-    tPressed = false;
-    rPressed = false;
-    gPressed = false;
 }
-
-HomogenVector FigureViewerWindow::matrix_prod(float ma[3][3], HomogenVector mb)
-{
-    float x = mb.x;
-    float y = mb.y;
-
-    float nx = ma[0][0] * x + ma[0][1] * y + ma[0][2] * 1;
-    float ny = ma[1][0] * x + ma[1][1] * y + ma[1][2] * 1;
-
-    return HomogenVector(nx, ny, 1.0f);
-    ;
-}
\ No newline at end of file
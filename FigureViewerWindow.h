@@ -2,43 +2,53 @@
 #pragma once
 #include "Window.h"
 #include "Figure.h"
+#include "FigureStore.h"
+#include "FigureHistory.h"
 #include "HomogenVector.h"
+#include "Transforms2D.h"
+#include "ViewerInput.h"
 #include "Color.h"
 #include "Button.h"
+#include <functional>
 #include <memory>
 #include <vector>
 
 class FigureViewerWindow : public Window
 {
 private:
-    const double PI = 3.14159265358979323846;
-    const float TRANSLATE_STEP = 0.02f;
-    const float SCALE_FACTOR = 1.01f; 
-    float ROTATION_STEP = 0.0f;
-    void rotate(float degree);
-    void traslate(float tx, float ty);
-    void scale(float sx, float sy);
-    HomogenVector matrix_prod(float ma[3][3], HomogenVector mb);
-
-    std::vector<std::shared_ptr<Figure>> figures;
+    // Las teclas se acumulan aquí y se aplican una vez por frame en WM_PAINT
+    ViewerInput input;
+    void ApplyPendingInput();
+    static ViewerKey ToViewerKey(WPARAM wParam);
+
+    // Figuras de MainWindow. El visor transforma copias propias (comparten los puntos hasta que
+    // uno de los dos los cambie) y publica cada frame con cambios en source; la versión anterior
+    // queda en el historial de MainWindow, así que cerrar el visor no pierde nada
+    FigureStore &source;
+    FigureHistory &sourceHistory; // Ctrl+Z
+    std::function<void()> onFigurePublished;
+    std::vector<FigureHandle> sources; // Paralelo a figures
+    FigureStore store;
+    std::vector<FigureHandle> figures;
+    bool recordBeforeTransform; // La próxima transformación empieza un paso de deshacer
     size_t currentFigureIndex;
-    HomogenVector pivotPoint;
+    float pivotX, pivotY; // Pivote en coordenadas OpenGL
     bool hasPivot;
-    bool sPressed;
-    bool tPressed;
-    bool rPressed;
-    bool gPressed;
+    SceneVersion viewVersion; // Pivote y figura seleccionada
 
     // Botones de navegación carrusel
     std::unique_ptr<Button> leftButton;
     std::unique_ptr<Button> rightButton;
 
+    Figure *GetCurrentFigure(); // nullptr si no hay o ya no existe
+    const Figure *GetCurrentFigure() const;
     void DrawSingleFigure();
     void DrawPivotPoint();
     void HandleClick(int x, int y);
-    void HandleKeyboard(WPARAM wParam);
-    void UpdateKeyState(WPARAM wParam, bool pressed);
-    void ClearKeyState();
+    void HandleKeyboard(WPARAM wParam, bool isRepeat);
+    void PublishCurrentFigure();
+    void UndoCurrentFigure();
+    void ExportCurrentFigure(); // F5: puntos originales con su transformación aparte
     void UpdateButtonVisibility();
  
     void NavigateToPreviousFigure();
@@ -49,8 +59,12 @@ private:
 
     HomogenVector ScreenToOpenGL(int screenX, int screenY);
 
+protected:
+    uint64_t GetSceneVersion() const override;
+
 public:
-    FigureViewerWindow(const WindowConfig &config, const std::vector<std::shared_ptr<Figure>> &figuresToView);
+    FigureViewerWindow(const WindowConfig &config, FigureStore &source, FigureHistory &sourceHistory,
+                       const std::vector<FigureHandle> &figuresToView, std::function<void()> onFigurePublished);
     ~FigureViewerWindow() = default;
 
     bool Create() override;
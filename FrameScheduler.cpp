@@ -0,0 +1,98 @@
+// FrameScheduler.cpp
+#include "FrameScheduler.h"
+#include <algorithm>
+#include <chrono>
+
+uint64_t SteadyFrameClock::NowMicroseconds() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+FrameScheduler::FrameScheduler(const IFrameClock &frameClock, uint64_t frameIntervalMicroseconds)
+    : clock(frameClock), frameInterval(frameIntervalMicroseconds), lastFrameTime(0), hasLastFrame(false), frameCount(0)
+{
+}
+
+FrameScheduler &FrameScheduler::Main()
+{
+    static SteadyFrameClock steadyClock;
+    static FrameScheduler scheduler(steadyClock);
+    return scheduler;
+}
+
+bool FrameScheduler::Contains(const std::vector<FrameTarget> &list, FrameTarget target)
+{
+    return std::find(list.begin(), list.end(), target) != list.end();
+}
+
+void FrameScheduler::Remove(std::vector<FrameTarget> &list, FrameTarget target)
+{
+    list.erase(std::remove(list.begin(), list.end(), target), list.end());
+}
+
+void FrameScheduler::RequestFrame(FrameTarget target)
+{
+    // Pocas ventanas: una búsqueda lineal es más barata que un set
+    if (!Contains(dirtyTargets, target))
+        dirtyTargets.push_back(target);
+}
+
+void FrameScheduler::SetAnimating(FrameTarget target, bool animating)
+{
+    if (animating)
+    {
+        if (!Contains(animatingTargets, target))
+            animatingTargets.push_back(target);
+    }
+    else
+    {
+        Remove(animatingTargets, target);
+    }
+}
+
+void FrameScheduler::RemoveTarget(FrameTarget target)
+{
+    Remove(dirtyTargets, target);
+    Remove(animatingTargets, target);
+}
+
+int64_t FrameScheduler::GetWaitMicroseconds() const
+{
+    if (!HasWork())
+        return WAIT_FOREVER;
+    if (!hasLastFrame)
+        return 0;
+
+    uint64_t now = clock.NowMicroseconds();
+    uint64_t elapsed = now - lastFrameTime;
+    if (elapsed >= frameInterval)
+        return 0;
+    return static_cast<int64_t>(frameInterval - elapsed);
+}
+
+bool FrameScheduler::TakeDueFrame(std::vector<FrameTarget> &targets)
+{
+    targets.clear();
+    if (!HasWork() || GetWaitMicroseconds() > 0)
+        return false;
+
+    targets = dirtyTargets;
+    for (FrameTarget target : animatingTargets)
+    {
+        if (!Contains(targets, target))
+            targets.push_back(target);
+    }
+    dirtyTargets.clear();
+
+    uint64_t now = clock.NowMicroseconds();
+    // Mantener la cadencia: avanzar por intervalos salvo que nos hayamos quedado muy atrás
+    if (hasLastFrame && now - lastFrameTime < 2 * frameInterval)
+        lastFrameTime += frameInterval;
+    else
+        lastFrameTime = now;
+    hasLastFrame = true;
+    frameCount++;
+    return true;
+}
@@ -0,0 +1,65 @@
+// FrameScheduler.h - Portable frame pacing: decides when the message loop may sleep and when to draw
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Fuente de tiempo en microsegundos; las pruebas pueden usar un reloj falso
+class IFrameClock
+{
+public:
+    virtual ~IFrameClock() = default;
+    virtual uint64_t NowMicroseconds() const = 0;
+};
+
+class SteadyFrameClock : public IFrameClock
+{
+public:
+    uint64_t NowMicroseconds() const override;
+};
+
+// Un "destino" es cualquier objeto que sabe redibujarse (una ventana); se identifica por puntero
+using FrameTarget = const void *;
+
+class FrameScheduler
+{
+private:
+    const IFrameClock &clock;
+    uint64_t frameInterval;
+    uint64_t lastFrameTime;
+    bool hasLastFrame;
+    uint64_t frameCount;
+
+    std::vector<FrameTarget> dirtyTargets;
+    std::vector<FrameTarget> animatingTargets;
+
+    static bool Contains(const std::vector<FrameTarget> &list, FrameTarget target);
+    static void Remove(std::vector<FrameTarget> &list, FrameTarget target);
+
+public:
+    static const int64_t WAIT_FOREVER = -1;
+
+    FrameScheduler(const IFrameClock &frameClock, uint64_t frameIntervalMicroseconds = 16667);
+
+    // Instancia usada por las ventanas y el bucle de mensajes (reloj real, ~60 Hz)
+    static FrameScheduler &Main();
+
+    // Pide un frame para target; varias peticiones antes del frame se agrupan en una
+    void RequestFrame(FrameTarget target);
+    // Mientras esté animando, target recibe un frame en cada tick
+    void SetAnimating(FrameTarget target, bool animating);
+    // Olvidar un destino (p. ej. al destruir la ventana)
+    void RemoveTarget(FrameTarget target);
+
+    bool HasWork() const { return !dirtyTargets.empty() || !animatingTargets.empty(); }
+
+    // Microsegundos que el bucle puede dormir antes del próximo frame, WAIT_FOREVER si no hay nada
+    int64_t GetWaitMicroseconds() const;
+
+    // Si hay trabajo y ya pasó el intervalo, llena targets con los destinos a redibujar
+    // (pedidos + animados), limpia los pedidos y devuelve true
+    bool TakeDueFrame(std::vector<FrameTarget> &targets);
+
+    uint64_t GetFrameCount() const { return frameCount; }
+    uint64_t GetFrameInterval() const { return frameInterval; }
+    void SetFrameInterval(uint64_t microseconds) { frameInterval = microseconds; }
+};
@@ -0,0 +1,32 @@
+// FrameSnapshot.cpp
+#include "FrameSnapshot.h"
+
+std::shared_ptr<Figure> FrameSnapshotBuilder::Capture(const Figure &figure)
+{
+    CachedFigure &cached = copies[figure.GetId()];
+    if (!cached.copy || cached.version != figure.GetVersion())
+    {
+        // Copia nueva: la anterior puede seguir en un snapshot que aún se está dibujando
+        cached.copy = std::make_shared<Figure>(figure);
+        cached.version = figure.GetVersion();
+        copyCount++;
+    }
+    cached.used = true;
+    return cached.copy;
+}
+
+void FrameSnapshotBuilder::Sweep()
+{
+    for (auto it = copies.begin(); it != copies.end();)
+    {
+        if (!it->second.used)
+        {
+            it = copies.erase(it);
+        }
+        else
+        {
+            it->second.used = false;
+            ++it;
+        }
+    }
+}
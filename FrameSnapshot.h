@@ -0,0 +1,49 @@
+// FrameSnapshot.h - Immutable copy of what a window shows, handed from the UI thread to a render thread
+#pragma once
+#include "Figure.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Todo lo que necesita el hilo de render para dibujar un frame, sin tocar nada del hilo de la
+// interfaz. Una vez publicado no cambia: las figuras son copias que solo lee el hilo de render.
+struct FrameSnapshot
+{
+    uint64_t sceneVersion = 0;
+    int width = 0; // Área cliente en píxeles
+    int height = 0;
+    float clearR = 0.0f, clearG = 0.0f, clearB = 0.0f;
+    bool showStats = false; // Superposición de FrameStats
+    // Copias propias del snapshot (con su transformación y color); nadie las modifica
+    std::vector<std::shared_ptr<Figure>> figures;
+};
+
+// Hace las copias de las figuras para los snapshots. Una figura se vuelve a copiar solo si
+// cambió su versión; si no, snapshots sucesivos comparten la misma copia. La copia comparte los
+// puntos con la figura (copy-on-write), así que transformar o recolorear no copia puntos.
+class FrameSnapshotBuilder
+{
+private:
+    struct CachedFigure
+    {
+        uint64_t version;
+        std::shared_ptr<Figure> copy;
+        bool used;
+    };
+
+    std::unordered_map<uint64_t, CachedFigure> copies; // Clave: Figure::GetId()
+    uint64_t copyCount;
+
+public:
+    FrameSnapshotBuilder() : copyCount(0) {}
+
+    // Copia inmutable de figure en su versión actual
+    std::shared_ptr<Figure> Capture(const Figure &figure);
+
+    // Olvida las copias que no pasaron por Capture() desde el último Sweep()
+    void Sweep();
+
+    size_t GetCachedCount() const { return copies.size(); }
+    uint64_t GetCopyCount() const { return copyCount; }
+};
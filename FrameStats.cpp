@@ -0,0 +1,270 @@
+// FrameStats.cpp
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+FrameCounters &GetThreadFrameCounters()
+{
+    static thread_local FrameCounters counters;
+    return counters;
+}
+
+ScopedTransformTimer::~ScopedTransformTimer()
+{
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    GetThreadFrameCounters().transformMicroseconds += elapsed.count();
+}
+
+// ---------------------------------------------------------------------------
+// RollingHistogram
+// ---------------------------------------------------------------------------
+
+RollingHistogram::RollingHistogram(size_t windowSize)
+    : samples(windowSize == 0 ? 1 : windowSize), next(0), count(0)
+{
+    std::fill(buckets, buckets + BUCKET_COUNT, 0u);
+}
+
+int RollingHistogram::GetBucketIndex(double value)
+{
+    if (!(value >= 1.0)) // También NaN
+        return 0;
+    int exponent;
+    std::frexp(value, &exponent); // value = m * 2^exponent, m en [0.5, 1)
+    return (std::min)(exponent, BUCKET_COUNT - 1);
+}
+
+double RollingHistogram::GetBucketUpperBound(int index)
+{
+    return std::ldexp(1.0, index);
+}
+
+void RollingHistogram::Add(double value)
+{
+    if (count == samples.size())
+        buckets[GetBucketIndex(samples[next])]--;
+    else
+        count++;
+
+    samples[next] = value;
+    buckets[GetBucketIndex(value)]++;
+    next = (next + 1) % samples.size();
+}
+
+void RollingHistogram::Clear()
+{
+    next = 0;
+    count = 0;
+    std::fill(buckets, buckets + BUCKET_COUNT, 0u);
+}
+
+double RollingHistogram::GetLast() const
+{
+    if (count == 0)
+        return 0.0;
+    return samples[(next + samples.size() - 1) % samples.size()];
+}
+
+double RollingHistogram::GetMin() const
+{
+    if (count == 0)
+        return 0.0;
+    return *std::min_element(samples.begin(), samples.begin() + count);
+}
+
+double RollingHistogram::GetMax() const
+{
+    if (count == 0)
+        return 0.0;
+    return *std::max_element(samples.begin(), samples.begin() + count);
+}
+
+double RollingHistogram::GetMean() const
+{
+    if (count == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += samples[i];
+    }
+    return sum / count;
+}
+
+double RollingHistogram::GetPercentile(double fraction) const
+{
+    if (count == 0)
+        return 0.0;
+
+    // Los count primeros huecos son siempre los válidos (el anillo se llena desde 0)
+    std::vector<double> sorted(samples.begin(), samples.begin() + count);
+    fraction = (std::max)(0.0, (std::min)(1.0, fraction));
+    size_t rank = static_cast<size_t>(fraction * (count - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+// ---------------------------------------------------------------------------
+// FrameRecorder
+// ---------------------------------------------------------------------------
+
+FrameRecorder::FrameRecorder(uint64_t contextSwitchCount)
+    : start(std::chrono::steady_clock::now()), startCounters(GetThreadFrameCounters()),
+      startContextSwitches(contextSwitchCount)
+{
+}
+
+FrameSample FrameRecorder::Finish(uint64_t contextSwitchCount) const
+{
+    const FrameCounters &counters = GetThreadFrameCounters();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    FrameSample sample;
+    sample.paintMicroseconds = elapsed.count();
+    sample.drawCalls = counters.drawCalls - startCounters.drawCalls;
+    sample.vertices = counters.vertices - startCounters.vertices;
+    sample.contextSwitches = contextSwitchCount - startContextSwitches;
+    sample.transformMicroseconds = counters.transformMicroseconds - startCounters.transformMicroseconds;
+    return sample;
+}
+
+// ---------------------------------------------------------------------------
+// FrameStats
+// ---------------------------------------------------------------------------
+
+namespace
+{
+    HistogramSummary Summarize(const RollingHistogram &histogram)
+    {
+        HistogramSummary summary;
+        summary.count = histogram.GetCount();
+        summary.last = histogram.GetLast();
+        summary.min = histogram.GetMin();
+        summary.max = histogram.GetMax();
+        summary.mean = histogram.GetMean();
+        summary.p50 = histogram.GetPercentile(0.50);
+        summary.p95 = histogram.GetPercentile(0.95);
+        summary.p99 = histogram.GetPercentile(0.99);
+        for (int i = 0; i < RollingHistogram::BUCKET_COUNT; ++i)
+        {
+            summary.buckets[i] = histogram.GetBucket(i);
+        }
+        return summary;
+    }
+
+    void WriteJsonString(std::ostringstream &out, const std::string &text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (u < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", u);
+                out << escaped;
+            }
+            else
+                out << c;
+        }
+        out << '"';
+    }
+
+    void WriteJsonHistogram(std::ostringstream &out, const char *name, const HistogramSummary &summary)
+    {
+        out << "  \"" << name << "\": {\"count\": " << summary.count
+            << ", \"last\": " << summary.last << ", \"min\": " << summary.min << ", \"max\": " << summary.max
+            << ", \"mean\": " << summary.mean << ", \"p50\": " << summary.p50 << ", \"p95\": " << summary.p95
+            << ", \"p99\": " << summary.p99 << ", \"buckets\": [";
+
+        // Solo hasta la última cubeta con algo: con potencias de dos casi todas están vacías
+        int lastUsed = -1;
+        for (int i = 0; i < RollingHistogram::BUCKET_COUNT; ++i)
+        {
+            if (summary.buckets[i] != 0)
+                lastUsed = i;
+        }
+        for (int i = 0; i <= lastUsed; ++i)
+        {
+            out << (i ? ", " : "") << "{\"below\": " << RollingHistogram::GetBucketUpperBound(i)
+                << ", \"count\": " << summary.buckets[i] << "}";
+        }
+        out << "]}";
+    }
+}
+
+FrameStats::FrameStats(size_t windowSize)
+    : frames(0), paintTime(windowSize), drawCalls(windowSize), vertices(windowSize),
+      contextSwitches(windowSize), transformTime(windowSize)
+{
+}
+
+void FrameStats::Record(const FrameSample &sample)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    frames++;
+    paintTime.Add(sample.paintMicroseconds);
+    drawCalls.Add(static_cast<double>(sample.drawCalls));
+    vertices.Add(static_cast<double>(sample.vertices));
+    contextSwitches.Add(static_cast<double>(sample.contextSwitches));
+    transformTime.Add(sample.transformMicroseconds);
+}
+
+void FrameStats::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    frames = 0;
+    paintTime.Clear();
+    drawCalls.Clear();
+    vertices.Clear();
+    contextSwitches.Clear();
+    transformTime.Clear();
+}
+
+FrameStatsSummary FrameStats::GetSummary() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    FrameStatsSummary summary;
+    summary.frames = frames;
+    summary.paintMicroseconds = Summarize(paintTime);
+    summary.drawCalls = Summarize(drawCalls);
+    summary.vertices = Summarize(vertices);
+    summary.contextSwitches = Summarize(contextSwitches);
+    summary.transformMicroseconds = Summarize(transformTime);
+    return summary;
+}
+
+std::string FrameStats::ToJson(const std::string &name) const
+{
+    FrameStatsSummary summary = GetSummary();
+
+    std::ostringstream out;
+    out << "{\n  \"name\": ";
+    WriteJsonString(out, name);
+    out << ",\n  \"frames\": " << summary.frames << ",\n";
+    WriteJsonHistogram(out, "paintMicroseconds", summary.paintMicroseconds);
+    out << ",\n";
+    WriteJsonHistogram(out, "drawCalls", summary.drawCalls);
+    out << ",\n";
+    WriteJsonHistogram(out, "vertices", summary.vertices);
+    out << ",\n";
+    WriteJsonHistogram(out, "contextSwitches", summary.contextSwitches);
+    out << ",\n";
+    WriteJsonHistogram(out, "transformMicroseconds", summary.transformMicroseconds);
+    out << "\n}\n";
+    return out.str();
+}
+
+bool FrameStats::WriteJson(const std::string &path, const std::string &name) const
+{
+    std::string json = ToJson(name);
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    return std::fclose(file) == 0 && ok;
+}
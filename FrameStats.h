@@ -0,0 +1,138 @@
+// FrameStats.h - Per-frame counters and rolling histograms (portable: windows and headless benchmarks)
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Contadores acumulados del hilo actual: los backends suman llamadas de dibujo y vértices, Figure
+// el tiempo de transformar puntos. Un frame es la diferencia entre dos lecturas (FrameRecorder).
+struct FrameCounters
+{
+    uint64_t drawCalls = 0;
+    uint64_t vertices = 0;
+    double transformMicroseconds = 0.0;
+};
+
+FrameCounters &GetThreadFrameCounters();
+
+inline void CountDrawCall(size_t vertexCount)
+{
+    FrameCounters &counters = GetThreadFrameCounters();
+    counters.drawCalls++;
+    counters.vertices += vertexCount;
+}
+
+// Suma a los contadores del hilo el tiempo entre su construcción y su destrucción
+class ScopedTransformTimer
+{
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedTransformTimer() : start(std::chrono::steady_clock::now()) {}
+    ~ScopedTransformTimer();
+
+    ScopedTransformTimer(const ScopedTransformTimer &) = delete;
+    ScopedTransformTimer &operator=(const ScopedTransformTimer &) = delete;
+};
+
+// Últimos windowSize valores, con cubetas de potencias de dos mantenidas al añadir (O(1)):
+// la cubeta 0 cuenta los valores < 1 y la cubeta i los de [2^(i-1), 2^i).
+class RollingHistogram
+{
+public:
+    static const int BUCKET_COUNT = 32;
+
+private:
+    std::vector<double> samples;
+    size_t next;
+    size_t count;
+    uint32_t buckets[BUCKET_COUNT];
+
+public:
+    explicit RollingHistogram(size_t windowSize = 240);
+
+    void Add(double value);
+    void Clear();
+
+    size_t GetCount() const { return count; }
+    double GetLast() const;
+    double GetMin() const;
+    double GetMax() const;
+    double GetMean() const;
+    // fraction en [0, 1]: 0.5 = mediana. O(windowSize)
+    double GetPercentile(double fraction) const;
+    uint32_t GetBucket(int index) const { return buckets[index]; }
+
+    static int GetBucketIndex(double value);
+    static double GetBucketUpperBound(int index);
+};
+
+struct FrameSample
+{
+    double paintMicroseconds = 0.0;
+    uint64_t drawCalls = 0;
+    uint64_t vertices = 0;
+    uint64_t contextSwitches = 0;
+    double transformMicroseconds = 0.0;
+};
+
+// Mide un frame del hilo actual. Los cambios de contexto se pasan desde fuera
+// (GLContextManager::GetSwitchCount) para no atar la biblioteca a WGL.
+class FrameRecorder
+{
+private:
+    std::chrono::steady_clock::time_point start;
+    FrameCounters startCounters;
+    uint64_t startContextSwitches;
+
+public:
+    explicit FrameRecorder(uint64_t contextSwitchCount = 0);
+    FrameSample Finish(uint64_t contextSwitchCount = 0) const;
+};
+
+struct HistogramSummary
+{
+    size_t count = 0;
+    double last = 0.0, min = 0.0, max = 0.0, mean = 0.0;
+    double p50 = 0.0, p95 = 0.0, p99 = 0.0;
+    uint32_t buckets[RollingHistogram::BUCKET_COUNT] = {};
+};
+
+struct FrameStatsSummary
+{
+    uint64_t frames = 0;
+    HistogramSummary paintMicroseconds;
+    HistogramSummary drawCalls;
+    HistogramSummary vertices;
+    HistogramSummary contextSwitches;
+    HistogramSummary transformMicroseconds;
+};
+
+// Histogramas de los últimos frames de una ventana. Record y las lecturas pueden venir de hilos
+// distintos (hilo de render y de interfaz).
+class FrameStats
+{
+private:
+    mutable std::mutex mutex;
+    uint64_t frames;
+    RollingHistogram paintTime;
+    RollingHistogram drawCalls;
+    RollingHistogram vertices;
+    RollingHistogram contextSwitches;
+    RollingHistogram transformTime;
+
+public:
+    explicit FrameStats(size_t windowSize = 240);
+
+    void Record(const FrameSample &sample);
+    void Clear();
+
+    FrameStatsSummary GetSummary() const;
+    // {"name": ..., "frames": N, "paintMicroseconds": {"count", "last", "min", ..., "buckets": [...]}, ...}
+    std::string ToJson(const std::string &name) const;
+    bool WriteJson(const std::string &path, const std::string &name) const;
+};
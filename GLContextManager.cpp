@@ -0,0 +1,53 @@
+// GLContextManager.cpp
+#include "GLContextManager.h"
+
+GLContextManager::GLContextManager(IGLContextPlatform &contextPlatform)
+    : platform(contextPlatform), currentSurface(nullptr), currentContext(nullptr),
+      switchCount(0), skippedBindCount(0), frameSwitchCount(0), lastFrameSwitchCount(0)
+{
+}
+
+bool GLContextManager::Bind(GLSurfaceHandle surface, GLContextHandle context)
+{
+    if (context == nullptr || surface == nullptr)
+        return false;
+
+    if (surface == currentSurface && context == currentContext)
+    {
+        skippedBindCount++;
+        return true;
+    }
+
+    switchCount++;
+    frameSwitchCount++;
+    if (!platform.MakeCurrent(surface, context))
+    {
+        Invalidate();
+        return false;
+    }
+
+    currentSurface = surface;
+    currentContext = context;
+    return true;
+}
+
+void GLContextManager::Forget(GLContextHandle context)
+{
+    if (context == nullptr || context != currentContext)
+        return;
+
+    platform.ReleaseCurrent();
+    Invalidate();
+}
+
+void GLContextManager::Invalidate()
+{
+    currentSurface = nullptr;
+    currentContext = nullptr;
+}
+
+void GLContextManager::EndFrame()
+{
+    lastFrameSwitchCount = frameSwitchCount;
+    frameSwitchCount = 0;
+}
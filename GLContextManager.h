@@ -0,0 +1,53 @@
+// GLContextManager.h - Portable tracking of the current GL context: repeat binds become no-ops
+#pragma once
+#include <cstdint>
+
+// Manejadores opacos: en Windows, HDC y HGLRC
+using GLSurfaceHandle = const void *;
+using GLContextHandle = const void *;
+
+// Operaciones reales del sistema (wglMakeCurrent en Windows); las pruebas usan una falsa
+class IGLContextPlatform
+{
+public:
+    virtual ~IGLContextPlatform() = default;
+    virtual bool MakeCurrent(GLSurfaceHandle surface, GLContextHandle context) = 0;
+    virtual void ReleaseCurrent() = 0;
+};
+
+class GLContextManager
+{
+private:
+    IGLContextPlatform &platform;
+    GLSurfaceHandle currentSurface;
+    GLContextHandle currentContext;
+
+    uint64_t switchCount;     // Llamadas reales a MakeCurrent
+    uint64_t skippedBindCount; // Binds que ya estaban activos
+    uint64_t frameSwitchCount;
+    uint64_t lastFrameSwitchCount;
+
+public:
+    explicit GLContextManager(IGLContextPlatform &contextPlatform);
+
+    // Instancia de las ventanas (wglMakeCurrent), una por hilo. Se define junto a la plataforma WGL.
+    static GLContextManager &Main();
+
+    // Activa context sobre surface; si ya es el actual no llama a la plataforma
+    bool Bind(GLSurfaceHandle surface, GLContextHandle context);
+    // Antes de destruir context: si es el actual, se desactiva
+    void Forget(GLContextHandle context);
+    // Si otro código cambió el contexto por su cuenta, el próximo Bind no se omite
+    void Invalidate();
+
+    GLContextHandle GetCurrentContext() const { return currentContext; }
+    bool IsCurrent(GLContextHandle context) const { return context != nullptr && context == currentContext; }
+
+    // Cierra el frame actual: GetLastFrameSwitchCount pasa a ser lo contado desde el anterior
+    void EndFrame();
+
+    uint64_t GetSwitchCount() const { return switchCount; }
+    uint64_t GetSkippedBindCount() const { return skippedBindCount; }
+    uint64_t GetFrameSwitchCount() const { return frameSwitchCount; }
+    uint64_t GetLastFrameSwitchCount() const { return lastFrameSwitchCount; }
+};
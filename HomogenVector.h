@@ -8,7 +8,7 @@ struct HomogenVector
     float w = 1.0f;     /**< homogeneous component (formerly 'o') */
     
     HomogenVector() = default;
-    HomogenVector(float x, float y, int w = 1) : x(x), y(y), w(w) {}
+    HomogenVector(float x, float y, float w = 1.0f) : x(x), y(y), w(w) {}
     
     // Convert from OpenGL coordinates (-1 to 1) to homogeneous coordinates
     static HomogenVector FromOpenGL(float glX, float glY)
@@ -0,0 +1,41 @@
+// IRenderBackend.h - Dependency Inversion: 2D drawing without tying callers to OpenGL or a window
+#pragma once
+#include "IVertexBufferBackend.h"
+#include "TransformMatrix.h"
+#include "Color.h"
+#include "PrimitiveBatch.h"
+#include <cstddef>
+
+// Coordenadas en el espacio de OpenGL (-1 a 1, y hacia arriba). El estado (color, grosores,
+// matriz de modelo) se mantiene entre llamadas, igual que en OpenGL.
+class IRenderBackend
+{
+public:
+    virtual ~IRenderBackend() = default;
+
+    virtual void Clear(float r, float g, float b) = 0;
+    virtual void SetColor(const Color &color) = 0;
+    virtual void SetLineWidth(float width) = 0;
+    virtual void SetPointSize(float size) = 0;
+    // Se aplica a todo lo que se dibuje después; la identidad por defecto
+    virtual void SetModelMatrix(const TransformMatrix &model) = 0;
+
+    // xy: count pares (x, y) consecutivos
+    virtual void DrawLineStrip(const float *xy, size_t count) = 0;
+    virtual void DrawLineLoop(const float *xy, size_t count) = 0;
+    virtual void DrawPoints(const float *xy, size_t count) = 0;
+    // Cuadrilátero relleno con esquinas (left, top), (right, top), (right, bottom), (left, bottom)
+    virtual void DrawQuad(float left, float top, float right, float bottom) = 0;
+    // Los comandos de batch (tras Build()) con su color por vértice y sus grosores, con la matriz
+    // de modelo actual. Al volver, el color, el grosor de línea y el tamaño de punto son los de antes.
+    virtual void DrawBatch(const PrimitiveBatch &batch) = 0;
+
+    // Redibujo parcial: lo siguiente (Clear incluido) solo toca el rectángulo dañado.
+    // Devuelve false si el backend no lo soporta y hay que redibujar todo (p. ej. OpenGL cuando
+    // SwapBuffers no conserva el back buffer).
+    virtual bool SetDamageRect(float /*left*/, float /*top*/, float /*right*/, float /*bottom*/) { return false; }
+    virtual void ClearDamageRect() {}
+
+    // Buffers retenidos de este backend; DrawBuffer usa el estado actual
+    virtual IVertexBufferBackend &GetVertexBuffers() = 0;
+};
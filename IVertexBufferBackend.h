@@ -0,0 +1,23 @@
+// IVertexBufferBackend.h - Dependency Inversion: retained vertex buffers without tying callers to OpenGL
+#pragma once
+#include <cstddef>
+
+using VertexBufferId = unsigned int;
+
+enum class VertexPrimitive
+{
+    LineStrip,
+    LineLoop,
+    Points
+};
+
+class IVertexBufferBackend
+{
+public:
+    virtual ~IVertexBufferBackend() = default;
+    virtual VertexBufferId CreateBuffer() = 0;
+    // xy: count pares (x, y) consecutivos; reemplaza el contenido anterior del buffer
+    virtual void UploadVertices(VertexBufferId buffer, const float *xy, size_t count) = 0;
+    virtual void DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count) = 0;
+    virtual void DestroyBuffer(VertexBufferId buffer) = 0;
+};
@@ -0,0 +1,184 @@
+// ImageWriter.cpp
+#include "ImageWriter.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    const size_t MAX_STORED_BLOCK = 65535; // Máximo de un bloque deflate sin comprimir
+
+    struct CrcTable
+    {
+        uint32_t values[256];
+
+        CrcTable()
+        {
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[n] = c;
+            }
+        }
+    };
+
+    uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t size)
+    {
+        static const CrcTable table; // Inicialización segura entre hilos (static local)
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = table.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void PutUInt32(std::vector<uint8_t> &out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // chunk contiene el tipo (4 bytes) seguido de los datos
+    void WriteChunk(std::ofstream &file, const std::vector<uint8_t> &chunk)
+    {
+        std::vector<uint8_t> header;
+        PutUInt32(header, static_cast<uint32_t>(chunk.size() - 4));
+        std::vector<uint8_t> trailer;
+        PutUInt32(trailer, Crc32(0, chunk.data(), chunk.size()));
+
+        file.write(reinterpret_cast<const char *>(header.data()), header.size());
+        file.write(reinterpret_cast<const char *>(chunk.data()), chunk.size());
+        file.write(reinterpret_cast<const char *>(trailer.data()), trailer.size());
+    }
+
+    void BeginChunk(std::vector<uint8_t> &chunk, const char *type)
+    {
+        chunk.assign(type, type + 4);
+    }
+
+    // Fila en formato PNG: byte de filtro (0 = ninguno) y RGB
+    void FillPngRow(std::vector<uint8_t> &row, const uint8_t *rgba, int width)
+    {
+        row.resize(1 + static_cast<size_t>(width) * 3);
+        row[0] = 0;
+        for (int x = 0; x < width; ++x)
+        {
+            row[1 + x * 3] = rgba[x * 4];
+            row[2 + x * 3] = rgba[x * 4 + 1];
+            row[3 + x * 3] = rgba[x * 4 + 2];
+        }
+    }
+
+    bool WritePPM(std::ofstream &file, const uint8_t *rgba, int width, int height)
+    {
+        file << "P6\n"
+             << width << " " << height << "\n255\n";
+
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t *src = rgba + static_cast<size_t>(y) * width * 4;
+            for (int x = 0; x < width; ++x)
+            {
+                row[x * 3] = src[x * 4];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 2];
+            }
+            file.write(reinterpret_cast<const char *>(row.data()), row.size());
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool WritePNG(std::ofstream &file, const uint8_t *rgba, int width, int height)
+    {
+        static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        file.write(reinterpret_cast<const char *>(SIGNATURE), sizeof(SIGNATURE));
+
+        std::vector<uint8_t> chunk;
+        BeginChunk(chunk, "IHDR");
+        PutUInt32(chunk, static_cast<uint32_t>(width));
+        PutUInt32(chunk, static_cast<uint32_t>(height));
+        chunk.push_back(8); // Bits por canal
+        chunk.push_back(2); // RGB
+        chunk.push_back(0); // Deflate
+        chunk.push_back(0); // Filtro adaptativo
+        chunk.push_back(0); // Sin entrelazado
+        WriteChunk(file, chunk);
+
+        // Un IDAT por fila: así nunca hay más de una fila en memoria además del framebuffer
+        uint32_t adlerA = 1, adlerB = 0;
+        std::vector<uint8_t> row;
+        for (int y = 0; y < height; ++y)
+        {
+            BeginChunk(chunk, "IDAT");
+            if (y == 0)
+            {
+                chunk.push_back(0x78); // Cabecera zlib: deflate, ventana de 32K
+                chunk.push_back(0x01);
+            }
+
+            FillPngRow(row, rgba + static_cast<size_t>(y) * width * 4, width);
+            for (size_t offset = 0; offset < row.size(); offset += MAX_STORED_BLOCK)
+            {
+                size_t size = (std::min)(MAX_STORED_BLOCK, row.size() - offset);
+                chunk.push_back(0); // Bloque sin comprimir, no final
+                chunk.push_back(static_cast<uint8_t>(size));
+                chunk.push_back(static_cast<uint8_t>(size >> 8));
+                chunk.push_back(static_cast<uint8_t>(~size));
+                chunk.push_back(static_cast<uint8_t>(~size >> 8));
+                chunk.insert(chunk.end(), row.begin() + offset, row.begin() + offset + size);
+            }
+
+            for (uint8_t value : row)
+            {
+                adlerA = (adlerA + value) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+            WriteChunk(file, chunk);
+        }
+
+        // Bloque final vacío y checksum Adler-32 del flujo zlib
+        BeginChunk(chunk, "IDAT");
+        if (height == 0)
+        {
+            chunk.push_back(0x78);
+            chunk.push_back(0x01);
+        }
+        chunk.push_back(1);
+        chunk.push_back(0x00);
+        chunk.push_back(0x00);
+        chunk.push_back(0xFF);
+        chunk.push_back(0xFF);
+        PutUInt32(chunk, (adlerB << 16) | adlerA);
+        WriteChunk(file, chunk);
+
+        BeginChunk(chunk, "IEND");
+        WriteChunk(file, chunk);
+        return static_cast<bool>(file);
+    }
+}
+
+const char *GetImageExtension(ImageFormat format)
+{
+    return format == ImageFormat::PNG ? ".png" : ".ppm";
+}
+
+bool WriteImage(const std::string &path, const uint8_t *rgba, int width, int height, ImageFormat format)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    bool written = format == ImageFormat::PNG ? WritePNG(file, rgba, width, height) : WritePPM(file, rgba, width, height);
+    // Lo último escrito puede seguir en el buffer: un fallo al volcarlo solo se ve al cerrar
+    file.close();
+    return written && !file.fail();
+}
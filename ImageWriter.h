@@ -0,0 +1,20 @@
+// ImageWriter.h - Writes RGBA framebuffers to PPM or PNG files, row by row
+#pragma once
+#include <cstdint>
+#include <string>
+
+enum class ImageFormat
+{
+    PPM, // P6 binario
+    PNG  // RGB de 8 bits, sin dependencias externas (ver WriteImage)
+};
+
+// Extensión con punto (".ppm" / ".png")
+const char *GetImageExtension(ImageFormat format);
+
+// rgba: width * height píxeles RGBA, fila 0 arriba. El canal alfa se descarta.
+// Los PNG usan solo bloques deflate "stored" (tipo 0, sin compresión) de hasta 64 KB: cualquier
+// lector los abre, pero ocupan lo mismo que los datos en bruto (3 bytes por píxel más 1 por fila y
+// unos 5 bytes por bloque), como un PPM. Para archivarlos conviene recomprimirlos con otra herramienta.
+// Devuelve false si no se pudo abrir o escribir el archivo.
+bool WriteImage(const std::string &path, const uint8_t *rgba, int width, int height, ImageFormat format);
@@ -1,10 +1,17 @@
 // MainWindow.cpp
 #include "MainWindow.h"
+#include "FigureRendering.h"
+#include "GLContextManager.h"
+#include "FigureLibrary.h"
+#include "FigureImporter.h"
+#include "FigureVectorExporter.h"
+#include "FrameScheduler.h"
+#include <fstream>
 #include <iostream>
 #include <algorithm> // Para std::min y std::max
 
 MainWindow::MainWindow(const WindowConfig &config)
-    : Window(config), figureCounter(0)
+    : Window(config), figureCounter(0), firstVisibleRow(0), libraryLoadFailed(false), renderThreadEnabled(false)
 {
     titleLabel = std::make_unique<Label>(250, 30, 500, 30, L"Transformaciones Geométricas");
     drawButton = std::make_unique<Button>(260, 70, 150, 40, L"Abrir Dibujo");
@@ -16,6 +23,9 @@ bool MainWindow::Create()
     if (!Window::Create())
         return false;
 
+    thumbnails = std::make_unique<ThumbnailGrid>(*GetVertexBackend());
+    thumbnails->SetLodCache(&lodCache);
+
     // Crear elementos UI
     titleLabel->Create(GetWindowHandle());
     drawButton->Create(GetWindowHandle());
@@ -30,8 +40,8 @@ bool MainWindow::Create()
                            { OnViewButtonClick(); });
 
     // Configurar callback global para figuras
-    FigureManager::SetGlobalCallback([this](std::shared_ptr<Figure> figure)
-                                     { OnFigureComplete(figure); });
+    FigureManager::SetGlobalCallback([this](Figure &&figure)
+                                     { OnFigureComplete(std::move(figure)); });
 
     // Forzar redibujado de los controles
     titleLabel->Show();
@@ -47,8 +57,17 @@ bool MainWindow::Create()
 
     // Configurar viewport correcto para MainWindow
     glViewport(0, 0, rect.right - rect.left, rect.bottom - rect.top);
+    int largestSide = (std::max)(rect.right - rect.left, rect.bottom - rect.top);
+    if (largestSide > 0)
+        thumbnails->SetPixelSize(2.0f / largestSide);
     std::wcout << L"DEBUG: MainWindow viewport set to " << (rect.right - rect.left) << L"x" << (rect.bottom - rect.top) << std::endl;
 
+    if (!libraryPath.empty())
+        LoadFigureLibrary();
+
+    if (renderThreadEnabled)
+        StartRenderThread();
+
     return true;
 }
 
@@ -83,37 +102,142 @@ LRESULT MainWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPa
         BeginPaint(GetWindowHandle(), &ps);
 
         auto *renderer = GetRenderer();
-        if (renderer)
+        if (renderThread)
+        {
+            uint64_t sceneVersion = GetSceneVersion();
+            if (frameTracker.ShouldRender(sceneVersion))
+            {
+                // Con la cola llena se reintenta en el próximo frame
+                if (PublishSnapshot(sceneVersion))
+                    frameTracker.MarkRendered(sceneVersion);
+                else
+                    RequestFrame();
+            }
+        }
+        else if (renderer)
         {
-            // Asegurar que el contexto OpenGL esté activo
-            wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+            uint64_t sceneVersion = GetSceneVersion();
+            // Sin cambios desde el último frame no se dibuja ni se intercambian buffers:
+            // la composición del escritorio conserva la última imagen presentada
+            if (frameTracker.ShouldRender(sceneVersion))
+            {
+                // Antes del cambio de contexto y de Update (diseño, niveles de detalle, subida de
+                // vértices): son parte del frame
+                FrameRecorder recorder = BeginFrameStats();
 
-            std::wcout << L"DEBUG: WM_PAINT called in MainWindow" << std::endl;
-            renderer->Render();
-            DrawAllFigures();
-            renderer->SwapBuffers();
+                // Asegurar que el contexto OpenGL esté activo
+                renderer->MakeCurrent();
+
+                // Si solo cambiaron algunas celdas y el back buffer conserva el frame anterior, se
+                // limpian y redibujan solo esas (la superposición de estadísticas pide frames enteros).
+                // Sin celdas dañadas (p. ej. un nivel de detalle de una figura que ya no se ve) la
+                // imagen anterior sigue valiendo.
+                bool unchanged = false;
+                bool partial = false;
+                if (thumbnails)
+                {
+                    thumbnails->Update(FigureListView(figureStore, figures), firstVisibleRow);
+                    if (!frameTracker.IsInvalidated())
+                    {
+                        float left, top, right, bottom;
+                        unchanged = !thumbnails->HasDamage();
+                        partial = !statsOverlayVisible && thumbnails->GetDamageRect(left, top, right, bottom) &&
+                                  GetRenderBackend()->SetDamageRect(left, top, right, bottom);
+                    }
+                    thumbnails->ClearDamage();
+                }
+
+                if (!unchanged)
+                {
+                    renderer->Render();
+                    DrawAllFigures();
+                    if (partial)
+                        GetRenderBackend()->ClearDamageRect();
+                    EndFrameStats(recorder);
+                    DrawStatsOverlay();
+                    renderer->SwapBuffers();
+                }
+                frameTracker.MarkRendered(sceneVersion);
+            }
         }
 
+        // Mientras se calculen niveles de detalle hay frames en cada tick: el que vea la versión de
+        // lodCache cambiar recoge el nivel nuevo
+        FrameScheduler::Main().SetAnimating(this, lodCache.HasPendingBuilds());
+
         EndPaint(GetWindowHandle(), &ps);
         return 0;
     }
 
+    case WM_MOUSEWHEEL:
+    {
+        // Rueda hacia abajo: avanzar una fila por cada paso
+        int steps = GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA;
+        ScrollRows(-steps);
+        return 0;
+    }
+
+    case WM_KEYDOWN:
+    {
+        switch (wParam)
+        {
+        case VK_UP:
+            ScrollRows(-1);
+            return 0;
+        case VK_DOWN:
+            ScrollRows(1);
+            return 0;
+        case VK_PRIOR: // Re Pág
+            ScrollRows(-GRID_MAX_ROWS);
+            return 0;
+        case VK_NEXT: // Av Pág
+            ScrollRows(GRID_MAX_ROWS);
+            return 0;
+        case VK_HOME:
+            ScrollTo(0);
+            return 0;
+        case VK_END:
+            ScrollTo(SIZE_MAX);
+            return 0;
+        case VK_F5:
+            ExportAllFigures();
+            return 0;
+        }
+        break;
+    }
+
+    case WM_DESTROY:
+    {
+        // El hilo de render dibuja sobre el DC de la ventana: pararlo antes de que desaparezca
+        if (renderThread)
+            renderThread->Stop();
+        if (!libraryPath.empty())
+            SaveFigureLibrary();
+        break;
+    }
+
     case WM_SIZE:
     {
         int width = LOWORD(lParam);
         int height = HIWORD(lParam);
 
-        if (width > 0 && height > 0) // Evitar divisiones por cero
+        // Con hilo de render el viewport y el tamaño de píxel van en cada snapshot
+        if (width > 0 && height > 0 && !renderThread) // Evitar divisiones por cero
         {
             auto *renderer = GetRenderer();
             if (renderer)
             {
                 // Asegurar que el contexto OpenGL esté activo
-                wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+                renderer->MakeCurrent();
                 glViewport(0, 0, width, height);
             }
+
+            // El nivel de detalle de las miniaturas depende del tamaño de un píxel
+            if (thumbnails)
+                thumbnails->SetPixelSize(2.0f / (std::max)(width, height));
         }
 
+        frameTracker.Invalidate();
         std::wcout << L"DEBUG: MainWindow resized to " << width << L"x" << height << std::endl;
         std::wcout << L"DEBUG: MainWindow viewport updated to " << width << L"x" << height << std::endl;
         InvalidateRect(GetWindowHandle(), nullptr, FALSE);
@@ -124,27 +248,38 @@ LRESULT MainWindow::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPa
     return Window::HandleMessage(hwnd, msg, wParam, lParam);
 }
 
-bool MainWindow::HasActiveWindows() const
+uint64_t MainWindow::GetSceneVersion() const
 {
-    // Verificar si la ventana principal está activa
-    if (Window::IsActive())
-        return true;
-
-    // Verificar si alguna ventana de dibujo está activa
-    for (const auto &drawingWindow : drawingWindows)
+    // Cuentan la lista, el desplazamiento, los niveles de detalle y la versión de cada figura visible
+    // (los visores publican sus cambios en figureStore, con una versión nueva). Las que están fuera de la página no afectan a la imagen, así que no se miran.
+    uint64_t version = (std::max)(figureListVersion.Get(), scrollVersion.Get());
+    // Un nivel de detalle recién calculado cambia las miniaturas sin tocar ninguna figura
+    version = (std::max)(version, lodCache.GetCompletedVersion());
+    GridLayout layout = GridLayout::ForFigureCount(figures.size());
+    size_t first = layout.FirstVisibleIndex(firstVisibleRow);
+    size_t count = layout.VisibleCount(firstVisibleRow, figures.size());
+    for (size_t i = first; i < first + count; ++i)
     {
-        if (drawingWindow && drawingWindow->IsActive())
-            return true;
+        version = (std::max)(version, figureStore.Get(figures[i])->GetVersion());
     }
+    return version;
+}
 
-    // Verificar si alguna ventana de vista está activa
-    for (const auto &viewerWindow : viewerWindows)
-    {
-        if (viewerWindow && viewerWindow->IsActive())
-            return true;
-    }
+void MainWindow::ScrollRows(long long rowDelta)
+{
+    long long target = static_cast<long long>(firstVisibleRow) + rowDelta;
+    ScrollTo(target < 0 ? 0 : static_cast<size_t>(target));
+}
+
+void MainWindow::ScrollTo(size_t firstRow)
+{
+    size_t clamped = GridLayout::ForFigureCount(figures.size()).ClampFirstRow(firstRow, figures.size());
+    if (clamped == firstVisibleRow)
+        return;
 
-    return false;
+    firstVisibleRow = clamped;
+    scrollVersion.Touch();
+    InvalidateRect(GetWindowHandle(), nullptr, FALSE);
 }
 
 void MainWindow::OnViewButtonClick()
@@ -174,7 +309,8 @@ void MainWindow::OnViewButtonClick()
 
     // Crear ventana de vista con todas las figuras disponibles
     WindowConfig viewConfig(L"Figure Viewer", 600, 500, 300, 200);
-    auto viewerWindow = std::make_unique<FigureViewerWindow>(viewConfig, figures);
+    auto viewerWindow = std::make_unique<FigureViewerWindow>(viewConfig, figureStore, history, figures, [this]()
+                                                             { InvalidateRect(GetWindowHandle(), nullptr, FALSE); });
 
     if (viewerWindow->Create())
     {
@@ -246,12 +382,83 @@ void MainWindow::OnDrawButtonClick()
     }
 }
 
-void MainWindow::OnFigureComplete(std::shared_ptr<Figure> figure)
+void MainWindow::LoadFigureLibrary()
 {
-    std::wcout << L"Figure completed: " << figure->GetName().c_str() << L" with " << figure->GetPointCount() << L" points" << std::endl;
+    // Se copian todos los puntos al store (cuesta lo que ocupa el archivo): así el archivo queda
+    // libre para guardarlo al salir. Si no existe se creará entonces; si existe pero no se puede
+    // leer entero, guardar lo cargado perdería el resto
+    if (!ReadFigureLibrary(libraryPath, figureStore, figures) && std::ifstream(libraryPath))
+    {
+        libraryLoadFailed = true;
+        std::wcout << L"Warning: Could not read figure library " << libraryPath.c_str()
+                   << L"; it will not be overwritten on exit" << std::endl;
+    }
+
+    std::wcout << L"Figure library loaded: " << figures.size() << L" figures" << std::endl;
+    figureCounter = static_cast<int>(figures.size());
+    figureListVersion.Touch();
+    if (!figures.empty())
+        viewButton->Show();
+}
+
+void MainWindow::SaveFigureLibrary()
+{
+    if (libraryLoadFailed)
+    {
+        std::wcout << L"Figure library not saved: " << libraryPath.c_str() << L" could not be read on start" << std::endl;
+        return;
+    }
+    if (WriteFigureLibrary(libraryPath, FigureListView(figureStore, figures)))
+        std::wcout << L"Figure library saved: " << figures.size() << L" figures" << std::endl;
+    else
+        std::wcout << L"Error: Could not write figure library " << libraryPath.c_str() << std::endl;
+}
+
+void MainWindow::ExportAllFigures()
+{
+    FigureListView view(figureStore, figures);
+    for (const char *path : {"figures.svg", "figures.json"})
+    {
+        if (ExportVectorFigures(path, view))
+            std::wcout << L"Exported " << figures.size() << L" figures to " << path << std::endl;
+        else
+            std::wcout << L"Error: Could not export figures to " << path << std::endl;
+    }
+}
+
+bool MainWindow::ImportFigureFile(const std::string &path)
+{
+    size_t previousCount = figures.size();
+    ImportResult result = ::ImportFigureFile(path, ImportOptions(), figureStore, figures);
+
+    std::wcout << L"Imported " << path.c_str() << L": " << result.figureCount << L" figures, "
+               << result.pointCount << L" points" << std::endl;
+    for (const auto &error : result.errors)
+        std::wcout << L"  " << path.c_str() << L":" << error.line << L":" << error.column << L": " << error.message.c_str() << std::endl;
+    if (result.errorCount > result.errors.size())
+        std::wcout << L"  ... " << (result.errorCount - result.errors.size()) << L" more errors" << std::endl;
+
+    if (figures.size() == previousCount)
+        return false;
+
+    figureListVersion.Touch();
+    if (previousCount == 0)
+        viewButton->Show();
+    InvalidateRect(GetWindowHandle(), nullptr, FALSE);
+    return true;
+}
+
+void MainWindow::OnFigureComplete(Figure &&figure)
+{
+    std::wcout << L"Figure completed: " << figure.GetName().c_str() << L" with " << figure.GetPointCount() << L" points" << std::endl;
 
     // Agregar figura a la lista
-    figures.push_back(figure);
+    figures.push_back(figureStore.Add(std::move(figure)));
+    figureListVersion.Touch();
+
+    // Desplazar el grid lo justo para que se vea la figura nueva
+    GridLayout layout = GridLayout::ForFigureCount(figures.size());
+    firstVisibleRow = layout.ClampFirstRow(layout.ScrollToShow(firstVisibleRow, figures.size() - 1), figures.size());
 
     // Mostrar botón "Ver Figuras" si es la primera figura
     if (figures.size() == 1)
@@ -297,115 +504,88 @@ void MainWindow::DrawAllFigures()
     // - Área de dibujo: -0.9f a 0.9f (horizontal y vertical)
     // - Espacio entre figuras: 10% del área total
     // - Escaling automático basado en el número de figuras
+    // - Distribución y escalado en GridLayout / ThumbnailGrid: se recalculan solo cuando cambia
+    //   la lista de figuras o alguna figura, no en cada WM_PAINT
+    // - Grid virtualizado: solo se dibuja la página visible (rueda, flechas, Re Pág/Av Pág,
+    //   Inicio/Fin para desplazarse), así que el coste no depende del número de figuras
     //
     // ============================================================================
 
     auto *renderer = GetRenderer();
-    if (!renderer || figures.empty())
+    if (!renderer || !thumbnails)
         return;
 
     // Asegurar que el contexto OpenGL esté activo
-    wglMakeCurrent(GetDC(GetWindowHandle()), renderer->GetGLRC());
+    renderer->MakeCurrent();
 
-    // Configuración del área de dibujo
-    const float areaLeft = -0.9f;
-    const float areaRight = 0.9f;
-    const float areaTop = 0.9f;
-    const float areaBottom = -0.9f;
+    RenderThumbnailGrid(*GetRenderBackend(), *thumbnails, FigureListView(figureStore, figures), firstVisibleRow);
+}
 
-    const int maxFiguresPerRow = 3; // Máximo 3 figuras por fila
-    const int maxRows = 3;          // Máximo 3 filas (9 figuras total)
+void MainWindow::StartRenderThread()
+{
+    auto *renderer = GetRenderer();
+    if (!renderer || !thumbnails)
+        return;
 
-    // Calcular grid dimensions
-    int totalFigures = static_cast<int>(figures.size());
-    int figuresPerRow = (std::min)(maxFiguresPerRow, totalFigures);
-    int totalRows = (totalFigures + figuresPerRow - 1) / figuresPerRow; // Ceiling division
-    totalRows = (std::min)(totalRows, maxRows);
+    // Un contexto solo puede estar activo en un hilo: desde aquí lo usa solo el hilo de render
+    GLContextManager::Main().Forget(renderer->GetGLRC());
+
+    renderThread = std::make_unique<RenderThread>();
+    renderThread->Start([renderer]()
+                        { renderer->MakeCurrent(); },
+                        [this](const FrameSnapshot &snapshot)
+                        { RenderSnapshot(snapshot); },
+                        [renderer]()
+                        { GLContextManager::Main().Forget(renderer->GetGLRC()); });
+    frameTracker.Invalidate();
+    std::wcout << L"DEBUG: MainWindow rendering on its own thread" << std::endl;
+}
 
-    // Calcular tamaño de celda
-    float cellWidth = (areaRight - areaLeft) / figuresPerRow;
-    float cellHeight = (areaTop - areaBottom) / totalRows;
+bool MainWindow::PublishSnapshot(uint64_t sceneVersion)
+{
+    auto snapshot = std::make_shared<FrameSnapshot>();
+    snapshot->sceneVersion = sceneVersion;
 
-    // Dibujar cada figura en su posición de grid
-    for (int i = 0; i < totalFigures; ++i)
+    RECT rect;
+    GetClientRect(GetWindowHandle(), &rect);
+    snapshot->width = rect.right - rect.left;
+    snapshot->height = rect.bottom - rect.top;
+    GetRenderer()->GetClearColor(snapshot->clearR, snapshot->clearG, snapshot->clearB);
+    snapshot->showStats = statsOverlayVisible;
+
+    // Solo la página visible del grid; en el snapshot empieza en la fila 0
+    GridLayout layout = GridLayout::ForFigureCount(figures.size());
+    size_t first = layout.FirstVisibleIndex(firstVisibleRow);
+    size_t count = layout.VisibleCount(firstVisibleRow, figures.size());
+    snapshot->figures.reserve(count);
+    for (size_t i = first; i < first + count; ++i)
     {
-        const auto &figure = figures[i];
-        const auto &points = figure->GetPoints();
-
-        if (points.size() < 2)
-            continue;
-
-        // Calcular posición en el grid
-        int row = i / figuresPerRow;
-        int col = i % figuresPerRow;
-
-        // Calcular centro de la celda
-        float cellCenterX = areaLeft + (col + 0.5f) * cellWidth;
-        float cellCenterY = areaTop - (row + 0.5f) * cellHeight;
-
-        // Calcular tamaño de la figura para escalar
-        float minX = (std::numeric_limits<float>::max)();
-        float maxX = (std::numeric_limits<float>::lowest)();
-        float minY = (std::numeric_limits<float>::max)();
-        float maxY = (std::numeric_limits<float>::lowest)();
-
-        for (const auto &point : points)
-        {
-            float glX, glY;
-            point.ToOpenGL(glX, glY);
-            minX = (std::min)(minX, glX);
-            maxX = (std::max)(maxX, glX);
-            minY = (std::min)(minY, glY);
-            maxY = (std::max)(maxY, glY);
-        }
-
-        float figureWidth = maxX - minX;
-        float figureHeight = maxY - minY;
-
-        // Calcular escala para que quepa en la celda (con margen del 10%)
-        float scaleX = (cellWidth * 0.9f) / figureWidth;
-        float scaleY = (cellHeight * 0.9f) / figureHeight;
-        float scale = (std::min)(scaleX, scaleY);
-
-        // Si la figura es muy pequeña, usar escala 1:1 con límite superior
-        if (scale > 1.0f)
-            scale = 1.0f;
-
-        // Usar el color original de la figura
-        Color figureColor = figure->GetColor();
-        glColor3f(figureColor.r, figureColor.g, figureColor.b);
-        glLineWidth(2.0f);
-
-        // Dibujar línea de la figura
-        glBegin(GL_LINE_STRIP);
-        for (const auto &point : points)
-        {
-            float glX, glY;
-            point.ToOpenGL(glX, glY);
-
-            // Aplicar escala y centrar en la celda
-            glX = cellCenterX + (glX - (minX + maxX) / 2.0f) * scale;
-            glY = cellCenterY + (glY - (minY + maxY) / 2.0f) * scale;
+        snapshot->figures.push_back(snapshotBuilder.Capture(*figureStore.Get(figures[i])));
+    }
+    snapshotBuilder.Sweep();
 
-            glVertex2f(glX, glY);
-        }
-        glEnd();
+    return renderThread->Publish(std::move(snapshot));
+}
 
-        // Dibujar puntos de la figura
-        glColor3f(figureColor.r, figureColor.g, figureColor.b);
-        glPointSize(4.0f);
-        glBegin(GL_POINTS);
-        for (const auto &point : points)
-        {
-            float glX, glY;
-            point.ToOpenGL(glX, glY);
+void MainWindow::RenderSnapshot(const FrameSnapshot &snapshot)
+{
+    if (snapshot.width <= 0 || snapshot.height <= 0)
+        return;
 
-            // Aplicar escala y centrar en la celda
-            glX = cellCenterX + (glX - (minX + maxX) / 2.0f) * scale;
-            glY = cellCenterY + (glY - (minY + maxY) / 2.0f) * scale;
+    // Contadores y cambios de contexto del hilo de render
+    FrameRecorder recorder = BeginFrameStats();
 
-            glVertex2f(glX, glY);
-        }
-        glEnd();
-    }
+    auto *renderer = GetRenderer();
+    auto *backend = GetRenderBackend();
+    glViewport(0, 0, snapshot.width, snapshot.height);
+    thumbnails->SetPixelSize(2.0f / (std::max)(snapshot.width, snapshot.height));
+
+    backend->Clear(snapshot.clearR, snapshot.clearG, snapshot.clearB);
+    // La página visible tiene la misma distribución que en la lista completa (ver GridLayout)
+    RenderThumbnailGrid(*backend, *thumbnails, snapshot.figures, 0);
+    EndFrameStats(recorder);
+
+    if (snapshot.showStats)
+        RenderFrameStatsOverlay(*backend, frameStats.GetSummary(), snapshot.width, snapshot.height);
+    renderer->SwapBuffers();
 }
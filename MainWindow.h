@@ -6,9 +6,14 @@
 #include "DrawingWindow.h"
 #include "FigureViewerWindow.h"
 #include "Figure.h"
+#include "FigureStore.h"
 #include "FigureCallback.h"
 #include "Color.h"
+#include "ThumbnailGrid.h"
+#include "PolylineLodCache.h"
+#include "RenderThread.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 class MainWindow : public Window
@@ -17,22 +22,54 @@ private:
     std::unique_ptr<Label> titleLabel;
     std::unique_ptr<Button> drawButton;
     std::unique_ptr<Button> viewButton;
-    std::vector<std::shared_ptr<Figure>> figures;
+    FigureStore figureStore;          // Dueño de las figuras; los visores publican aquí sus cambios
+    std::vector<FigureHandle> figures; // Orden del grid
+    FigureHistory history;             // Versiones anteriores de las figuras (Ctrl+Z en el visor)
     std::vector<std::unique_ptr<DrawingWindow>> drawingWindows;
     std::vector<std::unique_ptr<FigureViewerWindow>> viewerWindows;
     int figureCounter;
+    PolylineLodCache lodCache;                 // Miniaturas simplificadas, calculadas en segundo plano
+    std::unique_ptr<ThumbnailGrid> thumbnails; // Miniaturas: un buffer compartido y una celda por figura visible
+    SceneVersion figureListVersion;
+    size_t firstVisibleRow; // Desplazamiento del grid, en filas
+    SceneVersion scrollVersion;
+    std::string libraryPath; // Biblioteca que se carga al crear la ventana y se guarda al cerrarla
+    bool libraryLoadFailed;  // Existe pero no se pudo leer entera: no se sobrescribe al cerrar
+
+    // Dibujo en un hilo propio (opcional): WM_PAINT solo publica un FrameSnapshot. Va el último
+    // para pararse antes de destruir el grid y el contexto.
+    bool renderThreadEnabled;
+    FrameSnapshotBuilder snapshotBuilder;
+    std::unique_ptr<RenderThread> renderThread;
     
     void OnDrawButtonClick();
     void OnViewButtonClick();
-    void OnFigureComplete(std::shared_ptr<Figure> figure);
+    void OnFigureComplete(Figure &&figure);
     void DrawAllFigures();
+    void ScrollRows(long long rowDelta);
+    void ScrollTo(size_t firstRow);
+    void LoadFigureLibrary();
+    void SaveFigureLibrary();
+    void ExportAllFigures(); // F5: figures.svg y figures.json, con las transformaciones aplicadas
+    void StartRenderThread();
+    bool PublishSnapshot(uint64_t sceneVersion);
+    void RenderSnapshot(const FrameSnapshot &snapshot); // En el hilo de render
+
+protected:
+    uint64_t GetSceneVersion() const override;
 
 public:
     MainWindow(const WindowConfig& config);
     ~MainWindow() = default;
     
+    // Antes de Create(): dibujar en un hilo propio en lugar de dentro de WM_PAINT
+    void SetRenderThreadEnabled(bool enabled) { renderThreadEnabled = enabled; }
+    bool IsRenderThreadEnabled() const { return renderThreadEnabled; }
+    // Antes de Create(): archivo de FigureLibrary con las figuras de la sesión
+    void SetLibraryPath(const std::string &path) { libraryPath = path; }
+
     bool Create() override;
+    // CSV, WKT o SVG (por la extensión), ajustado a [-1, 1]; false si no se importó nada
+    bool ImportFigureFile(const std::string &path);
     LRESULT HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) override;
-
-    bool HasActiveWindows() const;
 };
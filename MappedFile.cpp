@@ -0,0 +1,99 @@
+// MappedFile.cpp
+#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : data(nullptr), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : data(nullptr), size(0), descriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0 ||
+        static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<size_t>(-1))
+    {
+        Close();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle)
+    {
+        Close();
+        return false;
+    }
+
+    const void *view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        Close();
+        return false;
+    }
+    data = static_cast<const uint8_t *>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size <= 0)
+    {
+        Close();
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+    data = static_cast<const uint8_t *>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (data)
+        UnmapViewOfFile(data);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (data)
+        munmap(const_cast<uint8_t *>(data), size);
+    if (descriptor >= 0)
+        close(descriptor);
+    descriptor = -1;
+#endif
+    data = nullptr;
+    size = 0;
+}
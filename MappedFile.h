@@ -0,0 +1,35 @@
+// MappedFile.h - Read-only memory mapping of a whole file (MapViewOfFile / mmap)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// El contenido se lee directamente de las páginas del archivo: abrir no copia nada y el sistema
+// carga cada página la primera vez que se toca. Los punteros valen hasta Close() o el destructor.
+class MappedFile
+{
+private:
+    const uint8_t *data;
+    size_t size;
+#ifdef _WIN32
+    void *fileHandle;    // HANDLE
+    void *mappingHandle; // HANDLE
+#else
+    int descriptor;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // false si no existe, no se puede leer o está vacío (no se puede mapear un archivo vacío)
+    bool Open(const std::string &path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t *GetData() const { return data; }
+    size_t GetSize() const { return size; }
+};
@@ -0,0 +1,143 @@
+// OpenGLRenderBackend.cpp
+#include "OpenGLRenderBackend.h"
+#include "FrameStats.h"
+#include <cmath>
+
+OpenGLRenderBackend::OpenGLRenderBackend(HGLRC context, bool preservesBackBuffer)
+    : vertexBuffers(context), preservesBackBuffer(preservesBackBuffer)
+{
+}
+
+void OpenGLRenderBackend::Clear(float r, float g, float b)
+{
+    glClearColor(r, g, b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void OpenGLRenderBackend::SetColor(const Color &color)
+{
+    glColor3f(color.r, color.g, color.b);
+}
+
+void OpenGLRenderBackend::SetLineWidth(float width)
+{
+    glLineWidth(width);
+}
+
+void OpenGLRenderBackend::SetPointSize(float size)
+{
+    glPointSize(size);
+}
+
+void OpenGLRenderBackend::SetModelMatrix(const TransformMatrix &model)
+{
+    float columnMajor[16];
+    model.ToColumnMajor4x4(columnMajor);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(columnMajor);
+}
+
+void OpenGLRenderBackend::DrawVertices(GLenum mode, const float *xy, size_t count)
+{
+    CountDrawCall(count);
+    glBegin(mode);
+    for (size_t i = 0; i < count; ++i)
+    {
+        glVertex2f(xy[i * 2], xy[i * 2 + 1]);
+    }
+    glEnd();
+}
+
+void OpenGLRenderBackend::DrawLineStrip(const float *xy, size_t count)
+{
+    DrawVertices(GL_LINE_STRIP, xy, count);
+}
+
+void OpenGLRenderBackend::DrawLineLoop(const float *xy, size_t count)
+{
+    DrawVertices(GL_LINE_LOOP, xy, count);
+}
+
+void OpenGLRenderBackend::DrawPoints(const float *xy, size_t count)
+{
+    DrawVertices(GL_POINTS, xy, count);
+}
+
+void OpenGLRenderBackend::DrawQuad(float left, float top, float right, float bottom)
+{
+    CountDrawCall(4);
+    glBegin(GL_QUADS);
+    glVertex2f(left, top);
+    glVertex2f(right, top);
+    glVertex2f(right, bottom);
+    glVertex2f(left, bottom);
+    glEnd();
+}
+
+void OpenGLRenderBackend::DrawBatch(const PrimitiveBatch &batch)
+{
+    const auto &commands = batch.GetCommands();
+    if (commands.empty())
+        return;
+
+    // Guardar color, grosor de línea, tamaño de punto y arrays de vértices para dejarlos como estaban
+    glPushAttrib(GL_CURRENT_BIT | GL_LINE_BIT | GL_POINT_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+    const auto &vertices = batch.GetVertices();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(BatchVertex), &vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex), vertices[0].rgba);
+
+    // Una llamada por comando: solo cambia el estado entre grupos de distinto tipo o grosor
+    for (const auto &command : commands)
+    {
+        GLenum mode = GL_QUADS;
+        if (command.primitive == BatchPrimitive::Lines)
+        {
+            mode = GL_LINES;
+            glLineWidth(command.size);
+        }
+        else if (command.primitive == BatchPrimitive::Points)
+        {
+            mode = GL_POINTS;
+            glPointSize(command.size);
+        }
+        glDrawArrays(mode, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count));
+        CountDrawCall(command.count);
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+}
+
+bool OpenGLRenderBackend::SetDamageRect(float left, float top, float right, float bottom)
+{
+    if (!preservesBackBuffer)
+        return false;
+
+    // De coordenadas OpenGL a píxeles del viewport (origen abajo a la izquierda), redondeando hacia
+    // fuera y con un píxel de margen para el grosor de las líneas del borde
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float x0 = viewport[0] + ((std::min)(left, right) + 1.0f) * 0.5f * viewport[2];
+    float x1 = viewport[0] + ((std::max)(left, right) + 1.0f) * 0.5f * viewport[2];
+    float y0 = viewport[1] + ((std::min)(top, bottom) + 1.0f) * 0.5f * viewport[3];
+    float y1 = viewport[1] + ((std::max)(top, bottom) + 1.0f) * 0.5f * viewport[3];
+    if (!std::isfinite(x0) || !std::isfinite(x1) || !std::isfinite(y0) || !std::isfinite(y1))
+        return false;
+
+    GLint pixelLeft = static_cast<GLint>(std::floor(x0)) - 1;
+    GLint pixelBottom = static_cast<GLint>(std::floor(y0)) - 1;
+    GLint pixelRight = static_cast<GLint>(std::ceil(x1)) + 1;
+    GLint pixelTop = static_cast<GLint>(std::ceil(y1)) + 1;
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(pixelLeft, pixelBottom, pixelRight - pixelLeft, pixelTop - pixelBottom);
+    return true;
+}
+
+void OpenGLRenderBackend::ClearDamageRect()
+{
+    glDisable(GL_SCISSOR_TEST);
+}
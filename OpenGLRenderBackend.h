@@ -0,0 +1,38 @@
+// OpenGLRenderBackend.h - IRenderBackend over the legacy OpenGL pipeline of the current context
+#pragma once
+#include "IRenderBackend.h"
+#include "OpenGLVertexBufferBackend.h"
+#include <windows.h>
+#include <gl/gl.h>
+
+class OpenGLRenderBackend : public IRenderBackend
+{
+private:
+    OpenGLVertexBufferBackend vertexBuffers;
+    bool preservesBackBuffer;
+
+    void DrawVertices(GLenum mode, const float *xy, size_t count);
+
+public:
+    // Las llamadas se emiten sobre el contexto activo; context debe estarlo al dibujar.
+    // preservesBackBuffer: el back buffer sobrevive a SwapBuffers (OpenGLRenderer::PreservesBackBuffer)
+    OpenGLRenderBackend(HGLRC context, bool preservesBackBuffer);
+
+    void Clear(float r, float g, float b) override;
+    void SetColor(const Color &color) override;
+    void SetLineWidth(float width) override;
+    void SetPointSize(float size) override;
+    void SetModelMatrix(const TransformMatrix &model) override;
+
+    void DrawLineStrip(const float *xy, size_t count) override;
+    void DrawLineLoop(const float *xy, size_t count) override;
+    void DrawPoints(const float *xy, size_t count) override;
+    void DrawQuad(float left, float top, float right, float bottom) override;
+    void DrawBatch(const PrimitiveBatch &batch) override;
+
+    // Recorta con glScissor; sin back buffer conservado devuelve false
+    bool SetDamageRect(float left, float top, float right, float bottom) override;
+    void ClearDamageRect() override;
+
+    IVertexBufferBackend &GetVertexBuffers() override { return vertexBuffers; }
+};
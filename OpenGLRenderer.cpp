@@ -1,21 +1,24 @@
 // OpenGLRenderer.cpp
 #include "OpenGLRenderer.h"
+#include "GLContextManager.h"
 
-OpenGLRenderer::OpenGLRenderer() : hdc(nullptr), hrc(nullptr), colorR(0.0f), colorG(0.0f), colorB(0.0f) {}
+OpenGLRenderer::OpenGLRenderer() : hwnd(nullptr), hdc(nullptr), hrc(nullptr), colorR(0.0f), colorG(0.0f), colorB(0.0f), preservesBackBuffer(false) {}
 
 OpenGLRenderer::~OpenGLRenderer()
 {
     Cleanup();
 }
 
-bool OpenGLRenderer::Initialize(HWND hwnd)
+bool OpenGLRenderer::Initialize(HWND window)
 {
+    hwnd = window;
     hdc = GetDC(hwnd);
 
     PIXELFORMATDESCRIPTOR pfd = {};
     pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
     pfd.nVersion = 1;
-    pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
+    // PFD_SWAP_COPY es solo una preferencia: el controlador puede dar un formato que intercambie
+    pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER | PFD_SWAP_COPY;
     pfd.iPixelType = PFD_TYPE_RGBA;
     pfd.cColorBits = 32;
     pfd.cDepthBits = 24;
@@ -28,11 +31,15 @@ bool OpenGLRenderer::Initialize(HWND hwnd)
     if (!SetPixelFormat(hdc, pixelFormat, &pfd))
         return false;
 
+    PIXELFORMATDESCRIPTOR chosen = {};
+    if (DescribePixelFormat(hdc, pixelFormat, sizeof(chosen), &chosen))
+        preservesBackBuffer = (chosen.dwFlags & PFD_SWAP_COPY) != 0;
+
     hrc = wglCreateContext(hdc);
     if (!hrc)
         return false;
 
-    if (!wglMakeCurrent(hdc, hrc))
+    if (!MakeCurrent())
         return false;
 
     glViewport(0, 0, 800, 600);
@@ -42,10 +49,19 @@ bool OpenGLRenderer::Initialize(HWND hwnd)
 
 void OpenGLRenderer::Cleanup() {
     if (hrc) {
-        wglMakeCurrent(nullptr, nullptr);
+        // Solo se desactiva si es el actual: borrar un contexto inactivo no necesita cambiar el de otra ventana
+        GLContextManager::Main().Forget(hrc);
         wglDeleteContext(hrc);
         hrc = nullptr;
     }
+    if (hdc) {
+        ReleaseDC(hwnd, hdc);
+        hdc = nullptr;
+    }
+}
+
+bool OpenGLRenderer::MakeCurrent() {
+    return GLContextManager::Main().Bind(hdc, hrc);
 }
 
 void OpenGLRenderer::SetClearColor(float r, float g, float b) {
@@ -6,20 +6,30 @@
 class OpenGLRenderer
 {
 private:
-    HDC hdc;
+    HWND hwnd;
+    HDC hdc; // Ventanas con CS_OWNDC: el DC es fijo y se guarda para toda la vida de la ventana
     HGLRC hrc;
     float colorR, colorG, colorB;
+    bool preservesBackBuffer;
 
 public:
     OpenGLRenderer();
     ~OpenGLRenderer();
 
-    bool Initialize(HWND hwnd);
+    bool Initialize(HWND window);
     void Cleanup();
     void SetClearColor(float r, float g, float b);
+    void GetClearColor(float &r, float &g, float &b) const { r = colorR; g = colorG; b = colorB; }
     void Render();
     void SwapBuffers();
 
+    // Activa este contexto (no hace nada si ya está activo, ver GLContextManager)
+    bool MakeCurrent();
+
     // Agregar método para acceder al contexto OpenGL
     HGLRC GetGLRC() const { return hrc; }
+    HDC GetHDC() const { return hdc; }
+    // El formato de píxel copia el back buffer al hacer SwapBuffers (PFD_SWAP_COPY): lo que no se
+    // redibuja en un frame sigue siendo el del anterior y se puede redibujar solo una parte
+    bool PreservesBackBuffer() const { return preservesBackBuffer; }
 };
@@ -0,0 +1,122 @@
+// OpenGLVertexBufferBackend.cpp
+#include "OpenGLVertexBufferBackend.h"
+#include "GLContextManager.h"
+#include "FrameStats.h"
+
+namespace
+{
+    const GLenum GL_ARRAY_BUFFER_ID = 0x8892; // GL_ARRAY_BUFFER (OpenGL 1.5)
+    const GLenum GL_STATIC_DRAW_ID = 0x88E4;  // GL_STATIC_DRAW
+
+    GLenum ToGLPrimitive(VertexPrimitive primitive)
+    {
+        switch (primitive)
+        {
+        case VertexPrimitive::LineStrip:
+            return GL_LINE_STRIP;
+        case VertexPrimitive::LineLoop:
+            return GL_LINE_LOOP;
+        default:
+            return GL_POINTS;
+        }
+    }
+}
+
+OpenGLVertexBufferBackend::OpenGLVertexBufferBackend(HGLRC ownerContext)
+    : context(ownerContext), loaded(false), genBuffers(nullptr), deleteBuffers(nullptr),
+      bindBuffer(nullptr), bufferData(nullptr), nextClientBuffer(1)
+{
+}
+
+void OpenGLVertexBufferBackend::LoadFunctions()
+{
+    // wglGetProcAddress necesita un contexto activo: se carga en el primer uso
+    loaded = true;
+    genBuffers = reinterpret_cast<GenBuffersProc>(wglGetProcAddress("glGenBuffers"));
+    deleteBuffers = reinterpret_cast<DeleteBuffersProc>(wglGetProcAddress("glDeleteBuffers"));
+    bindBuffer = reinterpret_cast<BindBufferProc>(wglGetProcAddress("glBindBuffer"));
+    bufferData = reinterpret_cast<BufferDataProc>(wglGetProcAddress("glBufferData"));
+}
+
+void OpenGLVertexBufferBackend::DeletePendingBuffers()
+{
+    if (pendingDeletes.empty())
+        return;
+
+    deleteBuffers(static_cast<GLsizei>(pendingDeletes.size()), pendingDeletes.data());
+    pendingDeletes.clear();
+}
+
+VertexBufferId OpenGLVertexBufferBackend::CreateBuffer()
+{
+    if (!loaded)
+        LoadFunctions();
+
+    if (HasBufferObjects())
+    {
+        DeletePendingBuffers();
+        GLuint buffer = 0;
+        genBuffers(1, &buffer);
+        return buffer;
+    }
+
+    VertexBufferId buffer = nextClientBuffer++;
+    clientBuffers[buffer];
+    return buffer;
+}
+
+void OpenGLVertexBufferBackend::UploadVertices(VertexBufferId buffer, const float *xy, size_t count)
+{
+    if (HasBufferObjects())
+    {
+        DeletePendingBuffers();
+        bindBuffer(GL_ARRAY_BUFFER_ID, buffer);
+        bufferData(GL_ARRAY_BUFFER_ID, static_cast<ptrdiff_t>(count * 2 * sizeof(float)), xy, GL_STATIC_DRAW_ID);
+        bindBuffer(GL_ARRAY_BUFFER_ID, 0);
+        return;
+    }
+
+    clientBuffers[buffer].assign(xy, xy + count * 2);
+}
+
+void OpenGLVertexBufferBackend::DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count)
+{
+    if (count == 0)
+        return;
+
+    CountDrawCall(count);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (HasBufferObjects())
+    {
+        DeletePendingBuffers();
+        bindBuffer(GL_ARRAY_BUFFER_ID, buffer);
+        glVertexPointer(2, GL_FLOAT, 0, nullptr); // Desplazamiento 0 dentro del buffer
+        glDrawArrays(ToGLPrimitive(primitive), static_cast<GLint>(first), static_cast<GLsizei>(count));
+        bindBuffer(GL_ARRAY_BUFFER_ID, 0);
+    }
+    else
+    {
+        auto it = clientBuffers.find(buffer);
+        if (it != clientBuffers.end() && !it->second.empty())
+        {
+            glVertexPointer(2, GL_FLOAT, 0, it->second.data());
+            glDrawArrays(ToGLPrimitive(primitive), static_cast<GLint>(first), static_cast<GLsizei>(count));
+        }
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void OpenGLVertexBufferBackend::DestroyBuffer(VertexBufferId buffer)
+{
+    if (HasBufferObjects())
+    {
+        // Los nombres de buffer son por contexto: borrar con otro contexto activo rompería
+        // buffers ajenos. Si el nuestro no está activo, se borra en la próxima operación.
+        pendingDeletes.push_back(buffer);
+        if (GLContextManager::Main().IsCurrent(context))
+            DeletePendingBuffers();
+        return;
+    }
+
+    clientBuffers.erase(buffer);
+}
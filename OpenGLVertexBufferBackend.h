@@ -0,0 +1,44 @@
+// OpenGLVertexBufferBackend.h - IVertexBufferBackend over OpenGL buffer objects (client arrays as fallback)
+#pragma once
+#include "IVertexBufferBackend.h"
+#include <windows.h>
+#include <gl/gl.h>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+class OpenGLVertexBufferBackend : public IVertexBufferBackend
+{
+private:
+    typedef void(APIENTRY *GenBuffersProc)(GLsizei n, GLuint *buffers);
+    typedef void(APIENTRY *DeleteBuffersProc)(GLsizei n, const GLuint *buffers);
+    typedef void(APIENTRY *BindBufferProc)(GLenum target, GLuint buffer);
+    typedef void(APIENTRY *BufferDataProc)(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+
+    HGLRC context; // Los buffers pertenecen a este contexto
+    bool loaded;
+    GenBuffersProc genBuffers;
+    DeleteBuffersProc deleteBuffers;
+    BindBufferProc bindBuffer;
+    BufferDataProc bufferData;
+
+    // Borrados pedidos mientras otro contexto estaba activo; se hacen en la próxima operación
+    // con el nuestro (todas la necesitan activo), así los nombres no se pierden
+    std::vector<GLuint> pendingDeletes;
+    void DeletePendingBuffers();
+
+    // Sin buffer objects (OpenGL < 1.5) los vértices se guardan en memoria y se dibujan con arrays de cliente
+    VertexBufferId nextClientBuffer;
+    std::map<VertexBufferId, std::vector<float>> clientBuffers;
+
+    void LoadFunctions();
+    bool HasBufferObjects() const { return genBuffers && deleteBuffers && bindBuffer && bufferData; }
+
+public:
+    explicit OpenGLVertexBufferBackend(HGLRC ownerContext);
+
+    VertexBufferId CreateBuffer() override;
+    void UploadVertices(VertexBufferId buffer, const float *xy, size_t count) override;
+    void DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count) override;
+    void DestroyBuffer(VertexBufferId buffer) override;
+};
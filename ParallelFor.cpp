@@ -0,0 +1,220 @@
+// ParallelFor.cpp
+#include "ParallelFor.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::atomic<unsigned> workerThreadOverride(0);
+
+    // true en los hilos del pool y en quien está ejecutando un trabajo: un ParallelFor anidado
+    // se hace en línea en lugar de esperar a un pool que ya está ocupado con el trabajo de fuera
+    thread_local bool insideParallelFor = false;
+
+    typedef std::pair<size_t, size_t> Chunk;
+
+    // Hilos persistentes que se reparten los trozos de un ParallelFor. Solo hay un trabajo a la
+    // vez; si otro hilo ya lo está usando, quien llama hace su rango en línea.
+    class WorkerPool
+    {
+    public:
+        static WorkerPool &Instance()
+        {
+            static WorkerPool pool;
+            return pool;
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        // Devuelve false si el pool está ocupado (no se ha ejecutado nada)
+        bool TryRun(const std::vector<Chunk> &chunks, const std::function<void(size_t, size_t)> &body)
+        {
+            std::unique_lock<std::mutex> submit(submitMutex, std::try_to_lock);
+            if (!submit.owns_lock())
+                return false;
+
+            // El que llama también procesa trozos
+            EnsureThreads(chunks.size() - 1);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobBody = &body;
+                jobChunks = &chunks;
+                nextChunk = 0;
+                remainingChunks = chunks.size();
+                jobError = nullptr;
+                ++generation;
+            }
+            wake.notify_all();
+
+            insideParallelFor = true;
+            RunChunks();
+            insideParallelFor = false;
+
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [this]() { return remainingChunks == 0; });
+                jobBody = nullptr;
+                jobChunks = nullptr;
+                error = jobError;
+                jobError = nullptr;
+            }
+
+            if (error)
+                std::rethrow_exception(error);
+            return true;
+        }
+
+    private:
+        WorkerPool() = default;
+
+        void EnsureThreads(size_t count)
+        {
+            while (threads.size() < count)
+            {
+                threads.emplace_back([this]() { WorkerLoop(); });
+            }
+        }
+
+        void WorkerLoop()
+        {
+            insideParallelFor = true;
+            unsigned long long seenGeneration = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+                    if (stopping)
+                        return;
+                    seenGeneration = generation;
+                }
+                RunChunks();
+            }
+        }
+
+        // Toma trozos hasta que no quede ninguno. Los límites de cada trozo están fijados de
+        // antemano, así que el resultado no depende de qué hilo haga cada uno.
+        void RunChunks()
+        {
+            for (;;)
+            {
+                const std::function<void(size_t, size_t)> *body;
+                Chunk chunk;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (jobBody == nullptr || nextChunk >= jobChunks->size())
+                        return;
+                    body = jobBody;
+                    chunk = (*jobChunks)[nextChunk++];
+                }
+
+                std::exception_ptr error;
+                try
+                {
+                    (*body)(chunk.first, chunk.second);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error && !jobError)
+                    jobError = error;
+                if (--remainingChunks == 0)
+                    finished.notify_all();
+            }
+        }
+
+        std::mutex submitMutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::vector<std::thread> threads;
+
+        const std::function<void(size_t, size_t)> *jobBody = nullptr;
+        const std::vector<Chunk> *jobChunks = nullptr;
+        size_t nextChunk = 0;
+        size_t remainingChunks = 0;
+        std::exception_ptr jobError;
+        unsigned long long generation = 0;
+        bool stopping = false;
+    };
+}
+
+unsigned GetWorkerThreadCount()
+{
+    unsigned count = workerThreadOverride;
+    if (count == 0)
+        count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+void SetWorkerThreadCount(unsigned count)
+{
+    workerThreadOverride = count;
+}
+
+void ParallelFor(size_t count, size_t alignment, const std::function<void(size_t, size_t)> &body)
+{
+    if (count == 0)
+        return;
+    if (alignment == 0)
+        alignment = 1;
+
+    size_t threadCount = GetWorkerThreadCount();
+    size_t units = (count + alignment - 1) / alignment;
+    if (threadCount > units)
+        threadCount = units;
+
+    if (threadCount <= 1 || insideParallelFor)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Repartir en unidades de 'alignment' elementos, el resto va a los primeros trozos
+    size_t unitsPerThread = units / threadCount;
+    size_t extraUnits = units % threadCount;
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(threadCount);
+
+    size_t begin = 0;
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        size_t chunkUnits = unitsPerThread + (t < extraUnits ? 1 : 0);
+        size_t end = begin + chunkUnits * alignment;
+        if (end > count)
+            end = count;
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+
+    if (WorkerPool::Instance().TryRun(chunks, body))
+        return;
+
+    // Pool ocupado por otro hilo: mismos trozos, en orden, en el hilo que llama
+    for (const auto &chunk : chunks)
+    {
+        body(chunk.first, chunk.second);
+    }
+}
@@ -0,0 +1,15 @@
+// ParallelFor.h - Splits an index range across worker threads
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// Número de hilos a usar (hardware_concurrency, mínimo 1, salvo que se fije otro valor)
+unsigned GetWorkerThreadCount();
+void SetWorkerThreadCount(unsigned count); // 0 = automático
+
+// Llama a body(begin, end) sobre trozos disjuntos de [0, count). Los límites de cada trozo
+// son múltiplos de alignment, así que el reparto no depende del número de hilos más allá
+// de dónde se corta. Los trozos se reparten entre hilos persistentes y el que llama; vuelve
+// cuando todos terminan. Si body lanza, se relanza la primera excepción tras esperar al resto.
+// Un ParallelFor dentro de body (o con el pool ocupado por otro hilo) se ejecuta en línea.
+void ParallelFor(size_t count, size_t alignment, const std::function<void(size_t, size_t)> &body);
@@ -0,0 +1,106 @@
+// PointColumns.cpp
+#include "PointColumns.h"
+
+void PointColumns::Add(const HomogenVector &point)
+{
+    // La columna w solo se materializa con el primer punto que la necesita
+    // (Con la columna vacía y ningún punto anterior, assign no crea nada: se decide antes)
+    bool storeW = !ws.empty() || point.w != 1.0f;
+    if (storeW && ws.empty())
+        ws.assign(xs.size(), 1.0f);
+
+    xs.push_back(point.x);
+    ys.push_back(point.y);
+    if (storeW)
+        ws.push_back(point.w);
+}
+
+void PointColumns::Set(size_t index, const HomogenVector &point)
+{
+    if (point.w != 1.0f && ws.empty())
+        ws.assign(xs.size(), 1.0f);
+
+    xs[index] = point.x;
+    ys[index] = point.y;
+    if (!ws.empty())
+        ws[index] = point.w;
+}
+
+HomogenVector PointColumns::Get(size_t index) const
+{
+    HomogenVector point;
+    point.x = xs[index];
+    point.y = ys[index];
+    point.w = ws.empty() ? 1.0f : ws[index];
+    return point;
+}
+
+void PointColumns::Reserve(size_t count)
+{
+    xs.reserve(count);
+    ys.reserve(count);
+}
+
+void PointColumns::Clear()
+{
+    xs.clear();
+    ys.clear();
+    ws.clear();
+}
+
+void PointColumns::ShrinkToFit()
+{
+    xs.shrink_to_fit();
+    ys.shrink_to_fit();
+    ws.shrink_to_fit();
+}
+
+void PointColumns::FromInterleaved(const PointList &points)
+{
+    Clear();
+    Reserve(points.size());
+    for (const auto &point : points)
+    {
+        Add(point);
+    }
+}
+
+void PointColumns::ToInterleaved(PointList &points) const
+{
+    points.resize(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        points[i].x = xs[i];
+        points[i].y = ys[i];
+        points[i].w = ws.empty() ? 1.0f : ws[i];
+    }
+}
+
+float *PointColumns::EnsureW()
+{
+    if (ws.empty())
+        ws.assign(xs.size(), 1.0f);
+    return ws.data();
+}
+
+void PointColumns::ToOpenGL(float *xy) const
+{
+    size_t count = xs.size();
+    if (ws.empty())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            xy[i * 2] = xs[i];
+            xy[i * 2 + 1] = ys[i];
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        HomogenVector(xs[i], ys[i], ws[i]).ToOpenGL(xy[i * 2], xy[i * 2 + 1]);
+}
+
+size_t PointColumns::GetStorageBytes() const
+{
+    return (xs.capacity() + ys.capacity() + ws.capacity()) * sizeof(float);
+}
@@ -0,0 +1,46 @@
+// PointColumns.h - Structure-of-arrays storage for figure points (x, y and optional w columns)
+#pragma once
+#include "HomogenVector.h"
+#include "PointPool.h"
+#include "AlignedAllocator.h"
+#include <vector>
+
+// Columnas alineadas a 32 bytes para cargas SIMD alineadas
+using FloatColumn = std::vector<float, AlignedAllocator<float, 32>>;
+
+class PointColumns
+{
+private:
+    FloatColumn xs;
+    FloatColumn ys;
+    FloatColumn ws; // Vacía mientras todos los puntos tengan w == 1
+
+public:
+    void Add(const HomogenVector &point);
+    void Set(size_t index, const HomogenVector &point);
+    HomogenVector Get(size_t index) const;
+    void Reserve(size_t count);
+    void Clear();
+    void ShrinkToFit();
+
+    size_t Size() const { return xs.size(); }
+    bool Empty() const { return xs.empty(); }
+    bool HasW() const { return !ws.empty(); }
+
+    const float *X() const { return xs.data(); }
+    const float *Y() const { return ys.data(); }
+    const float *W() const { return ws.empty() ? nullptr : ws.data(); } // nullptr => w == 1
+    float *X() { return xs.data(); }
+    float *Y() { return ys.data(); }
+    float *W() { return ws.empty() ? nullptr : ws.data(); }
+    // Crea la columna w (todo a 1) si aún no existe, p. ej. antes de una transformación proyectiva
+    float *EnsureW();
+
+    void FromInterleaved(const PointList &points);
+    void ToInterleaved(PointList &points) const;
+    // Size() pares (x/w, y/w) consecutivos en xy; sin columna w solo se leen x e y
+    void ToOpenGL(float *xy) const;
+
+    // Bytes reservados por las columnas
+    size_t GetStorageBytes() const;
+};
@@ -0,0 +1,251 @@
+// PointPool.cpp
+#include "PointPool.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    const size_t MIN_BLOCK_SHIFT = 8;  // POINT_POOL_MIN_BLOCK_BYTES
+    const size_t MAX_BLOCK_SHIFT = 16; // 64 KB
+    const size_t CLASS_COUNT = MAX_BLOCK_SHIFT - MIN_BLOCK_SHIFT + 1;
+    static_assert((size_t(1) << MIN_BLOCK_SHIFT) == POINT_POOL_MIN_BLOCK_BYTES, "Clase más pequeña del pool");
+    const size_t SLAB_BYTES = size_t(1) << 20;
+    // Cada viaje de un hilo al pool mueve un lote de hasta 32 bloques y 64 KB; cada hilo guarda
+    // como mucho dos lotes por clase
+    const size_t THREAD_BATCH_BLOCKS = 32;
+    const size_t THREAD_BATCH_BYTES = size_t(1) << 16;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct SizeClass
+    {
+        FreeBlock *freeList = nullptr;
+        char *cursor = nullptr; // Parte sin usar del slab actual
+        char *end = nullptr;
+    };
+
+    struct Pool
+    {
+        std::mutex mutex;
+        SizeClass classes[CLASS_COUNT];
+        std::vector<std::unique_ptr<char[]>> slabs;
+        size_t slabBytes = 0;
+        size_t pooledBytes = 0; // Lo que ya pasaron los hilos, ver ThreadCache
+        size_t pooledAllocations = 0;
+        // Fuera del mutex: los bloques grandes ya pasan por operator new
+        std::atomic<size_t> largeBytes{0};
+        std::atomic<size_t> largeAllocations{0};
+    };
+
+    // No se destruye nunca: puede haber figuras estáticas que se liberen después
+    Pool &GetPool()
+    {
+        static Pool *pool = new Pool();
+        return *pool;
+    }
+
+    size_t GetClassIndex(size_t bytes)
+    {
+        size_t shift = MIN_BLOCK_SHIFT;
+        while ((size_t(1) << shift) < bytes)
+            shift++;
+        return shift - MIN_BLOCK_SHIFT;
+    }
+
+    size_t GetBatchBlocks(size_t index)
+    {
+        size_t blocks = THREAD_BATCH_BYTES >> (index + MIN_BLOCK_SHIFT);
+        return blocks < 1 ? 1 : (blocks > THREAD_BATCH_BLOCKS ? THREAD_BATCH_BLOCKS : blocks);
+    }
+
+    // Listas libres propias de cada hilo: pedir y devolver bloques casi nunca toma el mutex del pool.
+    // Sin destructor, para poder usarla hasta el final del hilo; ThreadCacheFlush la vacía.
+    struct ThreadCache
+    {
+        FreeBlock *lists[CLASS_COUNT];
+        size_t counts[CLASS_COUNT];
+        // Cambios de las estadísticas del pool que aún no se pasaron a Pool (una operación atómica por
+        // bloque cuesta más que el resto de pedirlo); pueden ser negativos si se liberan bloques de
+        // otro hilo
+        ptrdiff_t pooledBytes;
+        ptrdiff_t pooledAllocations;
+        bool retired; // Ya vaciada al terminar el hilo: lo que se libere después va directo al pool
+    };
+    thread_local ThreadCache threadCache = {};
+
+    // Con el mutex tomado
+    void FlushStats(Pool &pool, ThreadCache &cache)
+    {
+        pool.pooledBytes += cache.pooledBytes;
+        pool.pooledAllocations += cache.pooledAllocations;
+        cache.pooledBytes = 0;
+        cache.pooledAllocations = 0;
+    }
+
+    // La lista entera del hilo, enganchada tal cual delante de la del pool: los bloques liberados
+    // seguidos siguen seguidos (y en orden) para los siguientes Refill
+    void ReturnToPool(ThreadCache &cache, size_t index)
+    {
+        FreeBlock *first = cache.lists[index];
+        if (!first)
+            return;
+
+        FreeBlock *last = first;
+        while (last->next)
+            last = last->next;
+        cache.lists[index] = nullptr;
+        cache.counts[index] = 0;
+
+        Pool &pool = GetPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        last->next = pool.classes[index].freeList;
+        pool.classes[index].freeList = first;
+        FlushStats(pool, cache);
+    }
+
+    // Al terminar el hilo sus bloques vuelven al pool (las figuras estáticas se liberan después)
+    struct ThreadCacheFlush
+    {
+        ~ThreadCacheFlush()
+        {
+            for (size_t index = 0; index < CLASS_COUNT; ++index)
+            {
+                ReturnToPool(threadCache, index);
+            }
+            Pool &pool = GetPool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            FlushStats(pool, threadCache);
+            threadCache.retired = true;
+        }
+    };
+    thread_local ThreadCacheFlush threadCacheFlush;
+
+    // Con la lista del hilo vacía: un lote del principio de la lista del pool, sin reordenarlo, o
+    // bloques nuevos del slab
+    void Refill(ThreadCache &cache, size_t index)
+    {
+        (void)&threadCacheFlush; // Registra el vaciado al terminar este hilo
+
+        Pool &pool = GetPool();
+        size_t batch = GetBatchBlocks(index);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        FlushStats(pool, cache);
+        SizeClass &sizeClass = pool.classes[index];
+        if (sizeClass.freeList)
+        {
+            FreeBlock *last = sizeClass.freeList;
+            size_t count = 1;
+            while (count < batch && last->next)
+            {
+                last = last->next;
+                count++;
+            }
+            cache.lists[index] = sizeClass.freeList;
+            cache.counts[index] = count;
+            sizeClass.freeList = last->next;
+            last->next = nullptr;
+            return;
+        }
+
+        // En orden de dirección: las figuras creadas juntas quedan juntas
+        size_t blockBytes = size_t(1) << (index + MIN_BLOCK_SHIFT);
+        FreeBlock **tail = &cache.lists[index];
+        for (size_t i = 0; i < batch; ++i)
+        {
+            if (sizeClass.cursor == sizeClass.end)
+            {
+                // Slab nuevo para esta clase; new char[] alinea para cualquier tipo fundamental
+                pool.slabs.emplace_back(new char[SLAB_BYTES]);
+                sizeClass.cursor = pool.slabs.back().get();
+                sizeClass.end = sizeClass.cursor + SLAB_BYTES;
+                pool.slabBytes += SLAB_BYTES;
+            }
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(sizeClass.cursor);
+            sizeClass.cursor += blockBytes;
+            *tail = block;
+            tail = &block->next;
+        }
+        *tail = nullptr;
+        cache.counts[index] = batch;
+    }
+}
+
+void *AllocatePointBlock(size_t bytes)
+{
+    if (bytes > (size_t(1) << MAX_BLOCK_SHIFT))
+    {
+        Pool &pool = GetPool();
+        void *block = ::operator new(bytes);
+        pool.largeBytes.fetch_add(bytes, std::memory_order_relaxed);
+        pool.largeAllocations.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    size_t index = GetClassIndex(bytes);
+    ThreadCache &cache = threadCache;
+    if (!cache.lists[index])
+        Refill(cache, index);
+    FreeBlock *block = cache.lists[index];
+    cache.lists[index] = block->next;
+    cache.counts[index]--;
+
+    cache.pooledBytes += ptrdiff_t(1) << (index + MIN_BLOCK_SHIFT);
+    cache.pooledAllocations++;
+    return block;
+}
+
+void FreePointBlock(void *block, size_t bytes)
+{
+    if (bytes > (size_t(1) << MAX_BLOCK_SHIFT))
+    {
+        Pool &pool = GetPool();
+        ::operator delete(block);
+        pool.largeBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        pool.largeAllocations.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // A la caché del hilo que libera, aunque el bloque viniera de otro hilo
+    size_t index = GetClassIndex(bytes);
+    ThreadCache &cache = threadCache;
+    FreeBlock *freed = static_cast<FreeBlock *>(block);
+    cache.pooledBytes -= ptrdiff_t(1) << (index + MIN_BLOCK_SHIFT);
+    cache.pooledAllocations--;
+    if (cache.retired)
+    {
+        Pool &pool = GetPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        freed->next = pool.classes[index].freeList;
+        pool.classes[index].freeList = freed;
+        FlushStats(pool, cache);
+        return;
+    }
+
+    if (cache.counts[index] == 0)
+        (void)&threadCacheFlush;
+    freed->next = cache.lists[index];
+    cache.lists[index] = freed;
+    if (++cache.counts[index] > 2 * GetBatchBlocks(index))
+        ReturnToPool(cache, index);
+}
+
+PointPoolStats GetPointPoolStats()
+{
+    Pool &pool = GetPool();
+    PointPoolStats stats;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        FlushStats(pool, threadCache);
+        stats.slabBytes = pool.slabBytes;
+        stats.pooledBytes = pool.pooledBytes;
+        stats.allocations = pool.pooledAllocations;
+    }
+    stats.largeBytes = pool.largeBytes.load(std::memory_order_relaxed);
+    stats.allocations += pool.largeAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
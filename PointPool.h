@@ -0,0 +1,66 @@
+// PointPool.h - Slab pool for figure point arrays, so the points of many figures share a few large blocks
+#pragma once
+#include "HomogenVector.h"
+#include <cstddef>
+#include <vector>
+
+// Bloques por tamaños (potencias de dos de 256 B a 64 KB) recortados de slabs de 1 MB: las
+// figuras creadas juntas quedan juntas en memoria y liberar un array lo devuelve a la lista libre
+// de su tamaño, sin pasar por el heap. Lo más grande va directo a operator new. Los slabs no se
+// devuelven al sistema hasta el final del programa. Seguro entre hilos: cada hilo tiene sus propias
+// listas libres (dos lotes de hasta 32 bloques y 64 KB por tamaño) y solo toma el mutex del pool
+// para pasarse un lote; al terminar el hilo los devuelve.
+const size_t POINT_POOL_MIN_BLOCK_BYTES = 256;
+
+void *AllocatePointBlock(size_t bytes);
+void FreePointBlock(void *block, size_t bytes);
+
+struct PointPoolStats
+{
+    size_t slabBytes = 0;     // Reservado en slabs
+    size_t pooledBytes = 0;   // En uso dentro de los slabs (tamaño de bloque, no lo pedido)
+    size_t largeBytes = 0;    // En uso fuera del pool
+    size_t allocations = 0;   // Bloques vivos
+};
+// Exactas para lo pedido desde el hilo que llama; lo de otros hilos se cuenta cuando su caché
+// pasa por el pool (cada lote, o al terminar el hilo)
+PointPoolStats GetPointPoolStats();
+
+template <typename T>
+class PointPoolAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = PointPoolAllocator<U>;
+    };
+
+    PointPoolAllocator() = default;
+    template <typename U>
+    PointPoolAllocator(const PointPoolAllocator<U> &) {}
+
+    T *allocate(size_t n)
+    {
+        return n == 0 ? nullptr : static_cast<T *>(AllocatePointBlock(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        if (p)
+            FreePointBlock(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PointPoolAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const PointPoolAllocator<U> &) const { return false; }
+};
+
+// Puntos de una figura
+using PointList = std::vector<HomogenVector, PointPoolAllocator<HomogenVector>>;
+
+// Puntos que caben en el bloque más pequeño: reservarlos de entrada evita crecer de 1 en 1, 2, 4...
+const size_t POINT_LIST_MIN_CAPACITY = POINT_POOL_MIN_BLOCK_BYTES / sizeof(HomogenVector);
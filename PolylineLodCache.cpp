@@ -0,0 +1,197 @@
+// PolylineLodCache.cpp
+#include "PolylineLodCache.h"
+#include "PolylineSimplifier.h"
+#include "SceneVersion.h"
+#include <algorithm>
+
+namespace
+{
+    const float LOD_BASE_TOLERANCE = 0.002f;
+}
+
+PolylineLodCache::PolylineLodCache(size_t maxFigures)
+    : capacity(maxFigures == 0 ? 1 : maxFigures), useClock(0), buildCount(0), completedVersion(0),
+      building(false), stopping(false)
+{
+    worker = std::thread(&PolylineLodCache::WorkerMain, this);
+}
+
+PolylineLodCache::~PolylineLodCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    worker.join();
+}
+
+float PolylineLodCache::GetLevelTolerance(int level)
+{
+    return LOD_BASE_TOLERANCE * static_cast<float>(1 << level);
+}
+
+bool PolylineLodCache::Find(uint64_t figureId, uint64_t pointsVersion, int level, LodPoints &points)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(figureId);
+    if (it == entries.end() || it->second.pointsVersion != pointsVersion)
+    {
+        points.reset();
+        return false;
+    }
+
+    it->second.lastUsed = ++useClock;
+    points = it->second.levels[level];
+    return true;
+}
+
+void PolylineLodCache::FindMany(std::vector<Lookup> &lookups)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &lookup : lookups)
+    {
+        auto it = entries.find(lookup.figureId);
+        lookup.requested = it != entries.end() && it->second.pointsVersion == lookup.pointsVersion;
+        if (!lookup.requested)
+        {
+            lookup.points.reset();
+            continue;
+        }
+
+        it->second.lastUsed = ++useClock;
+        lookup.points = it->second.levels[lookup.level];
+    }
+}
+
+void PolylineLodCache::Request(uint64_t figureId, uint64_t pointsVersion, const float *xy, size_t count)
+{
+    Job job;
+    job.figureId = figureId;
+    job.pointsVersion = pointsVersion;
+    job.xy.assign(xy, xy + count * 2);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry &entry = entries[figureId];
+        if (entry.pointsVersion == pointsVersion && entry.lastUsed != 0)
+            return; // Ya pedido para esta versión
+
+        // Los niveles de la versión anterior dejan de valer en este momento
+        entry.pointsVersion = pointsVersion;
+        for (auto &level : entry.levels)
+        {
+            level.reset();
+        }
+        entry.lastUsed = ++useClock;
+
+        jobs.push_back(std::move(job));
+        if (entries.size() > capacity)
+            EvictLeastRecentlyUsed();
+    }
+    jobAvailable.notify_one();
+}
+
+void PolylineLodCache::EvictLeastRecentlyUsed()
+{
+    // Se descarta de golpe la mitad más antigua para no ordenar en cada Request
+    std::vector<uint64_t> uses;
+    uses.reserve(entries.size());
+    for (const auto &pair : entries)
+    {
+        uses.push_back(pair.second.lastUsed);
+    }
+    auto middle = uses.begin() + uses.size() / 2;
+    std::nth_element(uses.begin(), middle, uses.end());
+    uint64_t threshold = *middle;
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.lastUsed < threshold)
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+void PolylineLodCache::WorkerMain()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this]()
+                              { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+
+            // Figura liberada o con puntos nuevos desde que se pidió: no vale la pena calcularla
+            auto it = entries.find(job.figureId);
+            if (it == entries.end() || it->second.pointsVersion != job.pointsVersion)
+                continue;
+            building = true;
+        }
+
+        // Cada nivel parte de los puntos originales: simplificar el anterior acumularía el error
+        LodPoints levels[LOD_LEVEL_COUNT];
+        for (int level = 0; level < LOD_LEVEL_COUNT; ++level)
+        {
+            levels[level] = std::make_shared<const std::vector<float>>(
+                SimplifyPolyline(job.xy.data(), job.xy.size() / 2, GetLevelTolerance(level)));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        building = false;
+        auto it = entries.find(job.figureId);
+        if (it == entries.end() || it->second.pointsVersion != job.pointsVersion)
+            continue;
+
+        for (int level = 0; level < LOD_LEVEL_COUNT; ++level)
+        {
+            it->second.levels[level] = levels[level];
+        }
+        buildCount++;
+        completedVersion = NextSceneVersion();
+    }
+}
+
+void PolylineLodCache::Release(uint64_t figureId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(figureId);
+}
+
+void PolylineLodCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    jobs.clear();
+}
+
+size_t PolylineLodCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+uint64_t PolylineLodCache::GetBuildCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return buildCount;
+}
+
+uint64_t PolylineLodCache::GetCompletedVersion() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return completedVersion;
+}
+
+bool PolylineLodCache::HasPendingBuilds() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return building || !jobs.empty();
+}
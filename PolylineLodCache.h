@@ -0,0 +1,90 @@
+// PolylineLodCache.h - Simplified versions of figure polylines at a few tolerances, built on a worker thread
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+const int LOD_LEVEL_COUNT = 4;
+const size_t LOD_MIN_POINTS = 32; // Con menos puntos se dibuja siempre la figura completa
+
+typedef std::shared_ptr<const std::vector<float>> LodPoints; // Pares (x, y) en coordenadas OpenGL
+
+// Cada figura (por Figure::GetId()) tiene sus niveles calculados para una GetPointsVersion()
+// concreta: un nivel solo se devuelve si se calculó para la versión pedida, así que nunca se
+// dibuja una forma antigua. Los niveles se calculan todos a la vez, en segundo plano.
+class PolylineLodCache
+{
+private:
+    struct Entry
+    {
+        uint64_t pointsVersion = 0;
+        LodPoints levels[LOD_LEVEL_COUNT]; // Vacíos mientras el cálculo está pendiente
+        uint64_t lastUsed = 0;             // 0: recién creada, aún sin pedir
+    };
+
+    struct Job
+    {
+        uint64_t figureId;
+        uint64_t pointsVersion;
+        std::vector<float> xy; // Copia: el hilo no toca la Figure
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::deque<Job> jobs;
+    size_t capacity;
+    uint64_t useClock;
+    uint64_t buildCount;
+    uint64_t completedVersion; // NextSceneVersion() del último nivel terminado
+    bool building;             // El hilo está calculando un trabajo ya sacado de jobs
+    bool stopping;
+    std::thread worker;
+
+    void WorkerMain();
+    void EvictLeastRecentlyUsed(); // Con mutex tomado
+
+public:
+    explicit PolylineLodCache(size_t maxFigures = 4096);
+    ~PolylineLodCache();
+
+    PolylineLodCache(const PolylineLodCache &) = delete;
+    PolylineLodCache &operator=(const PolylineLodCache &) = delete;
+
+    // Tolerancia (en coordenadas OpenGL sin transformar) del nivel: se dobla en cada nivel
+    static float GetLevelTolerance(int level);
+
+    // true si la figura ya tiene niveles pedidos para pointsVersion; en ese caso points es el nivel
+    // pedido, o vacío si aún se está calculando. Con false hay que llamar a Request.
+    bool Find(uint64_t figureId, uint64_t pointsVersion, int level, LodPoints &points);
+
+    struct Lookup
+    {
+        uint64_t figureId = 0;
+        uint64_t pointsVersion = 0;
+        int level = 0;
+        LodPoints points;       // Salida, como en Find
+        bool requested = false; // Salida: lo que devolvería Find
+    };
+    // Find de varias figuras con un solo bloqueo (el grid busca todas las celdas visibles a la vez)
+    void FindMany(std::vector<Lookup> &lookups);
+
+    // Encola el cálculo de todos los niveles de la figura (count pares x, y que se copian)
+    void Request(uint64_t figureId, uint64_t pointsVersion, const float *xy, size_t count);
+
+    void Release(uint64_t figureId);
+    void Clear();
+
+    size_t GetEntryCount() const;
+    uint64_t GetBuildCount() const;
+
+    // El hilo no puede pedir frames: quien dibuja los niveles incluye esta versión en la de su
+    // escena (cambia al terminar cada cálculo) y sigue pidiendo frames mientras haya pendientes
+    uint64_t GetCompletedVersion() const;
+    bool HasPendingBuilds() const;
+};
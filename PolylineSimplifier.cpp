@@ -0,0 +1,86 @@
+// PolylineSimplifier.cpp
+#include "PolylineSimplifier.h"
+#include <utility>
+
+namespace
+{
+    // Distancia al cuadrado de p al segmento a-b
+    float SegmentDistanceSquared(const float *p, const float *a, const float *b)
+    {
+        float dx = b[0] - a[0];
+        float dy = b[1] - a[1];
+        float px = p[0] - a[0];
+        float py = p[1] - a[1];
+
+        float lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared > 0.0f)
+        {
+            float t = (px * dx + py * dy) / lengthSquared;
+            if (t > 1.0f)
+            {
+                px = p[0] - b[0];
+                py = p[1] - b[1];
+            }
+            else if (t > 0.0f)
+            {
+                px -= t * dx;
+                py -= t * dy;
+            }
+        }
+        return px * px + py * py;
+    }
+}
+
+std::vector<float> SimplifyPolyline(const float *xy, size_t count, float tolerance)
+{
+    if (count <= 2)
+        return std::vector<float>(xy, xy + count * 2);
+
+    std::vector<char> keep(count, 0);
+    keep[0] = 1;
+    keep[count - 1] = 1;
+
+    // Tramos [first, last] pendientes de revisar
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(0, count - 1);
+    float toleranceSquared = tolerance * tolerance;
+
+    while (!stack.empty())
+    {
+        size_t first = stack.back().first;
+        size_t last = stack.back().second;
+        stack.pop_back();
+
+        float maxDistance = 0.0f;
+        size_t farthest = first;
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            float distance = SegmentDistanceSquared(xy + i * 2, xy + first * 2, xy + last * 2);
+            if (distance > maxDistance)
+            {
+                maxDistance = distance;
+                farthest = i;
+            }
+        }
+
+        if (maxDistance > toleranceSquared)
+        {
+            keep[farthest] = 1;
+            if (farthest - first > 1)
+                stack.emplace_back(first, farthest);
+            if (last - farthest > 1)
+                stack.emplace_back(farthest, last);
+        }
+    }
+
+    std::vector<float> result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (keep[i])
+        {
+            result.push_back(xy[i * 2]);
+            result.push_back(xy[i * 2 + 1]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,9 @@
+// PolylineSimplifier.h - Douglas-Peucker simplification of 2D polylines
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Douglas-Peucker sobre count pares (x, y) consecutivos: devuelve los pares que se conservan, en orden.
+// Ningún punto descartado queda a más de tolerance del polígono resultante. El primero y el último
+// se conservan siempre. Iterativo, sin recursión, así que no depende del número de puntos.
+std::vector<float> SimplifyPolyline(const float *xy, size_t count, float tolerance);
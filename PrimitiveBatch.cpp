@@ -0,0 +1,100 @@
+// PrimitiveBatch.cpp
+#include "PrimitiveBatch.h"
+#include <algorithm>
+
+namespace
+{
+    uint8_t ToByte(float value)
+    {
+        value = (std::max)(0.0f, (std::min)(1.0f, value));
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+}
+
+void PrimitiveBatch::AddVertex(float x, float y, const Color &color)
+{
+    BatchVertex vertex;
+    vertex.x = x;
+    vertex.y = y;
+    vertex.rgba[0] = ToByte(color.r);
+    vertex.rgba[1] = ToByte(color.g);
+    vertex.rgba[2] = ToByte(color.b);
+    vertex.rgba[3] = 255;
+    pending.push_back(vertex);
+}
+
+void PrimitiveBatch::AddItem(BatchPrimitive primitive, float size, size_t first)
+{
+    if (pending.size() > first)
+        items.push_back(Item{primitive, size, first, pending.size() - first});
+}
+
+void PrimitiveBatch::AddQuad(float left, float top, float right, float bottom, const Color &color)
+{
+    size_t first = pending.size();
+    AddVertex(left, top, color);
+    AddVertex(right, top, color);
+    AddVertex(right, bottom, color);
+    AddVertex(left, bottom, color);
+    AddItem(BatchPrimitive::Quads, 0.0f, first);
+}
+
+void PrimitiveBatch::AddLine(float x0, float y0, float x1, float y1, const Color &color, float width)
+{
+    size_t first = pending.size();
+    AddVertex(x0, y0, color);
+    AddVertex(x1, y1, color);
+    AddItem(BatchPrimitive::Lines, width, first);
+}
+
+void PrimitiveBatch::AddLineLoop(const float *xy, size_t count, const Color &color, float width)
+{
+    if (count < 2)
+        return;
+
+    size_t first = pending.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t next = (i + 1) % count;
+        AddVertex(xy[i * 2], xy[i * 2 + 1], color);
+        AddVertex(xy[next * 2], xy[next * 2 + 1], color);
+    }
+    AddItem(BatchPrimitive::Lines, width, first);
+}
+
+void PrimitiveBatch::AddPoint(float x, float y, const Color &color, float size)
+{
+    size_t first = pending.size();
+    AddVertex(x, y, color);
+    AddItem(BatchPrimitive::Points, size, first);
+}
+
+void PrimitiveBatch::Build()
+{
+    std::stable_sort(items.begin(), items.end(), [](const Item &a, const Item &b)
+                     {
+        if (a.primitive != b.primitive)
+            return a.primitive < b.primitive;
+        return a.size < b.size; });
+
+    vertices.clear();
+    vertices.reserve(pending.size());
+    commands.clear();
+
+    for (const auto &item : items)
+    {
+        if (commands.empty() || commands.back().primitive != item.primitive || commands.back().size != item.size)
+            commands.push_back(BatchCommand{item.primitive, item.size, vertices.size(), 0});
+
+        vertices.insert(vertices.end(), pending.begin() + item.first, pending.begin() + item.first + item.count);
+        commands.back().count += item.count;
+    }
+}
+
+void PrimitiveBatch::Clear()
+{
+    pending.clear();
+    items.clear();
+    vertices.clear();
+    commands.clear();
+}
@@ -0,0 +1,68 @@
+// PrimitiveBatch.h - Colored quads, lines and points collected into one vertex array and few draw calls
+#pragma once
+#include "Color.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Orden de dibujo tras Build(): primero los rellenos, encima las líneas y por último los puntos
+enum class BatchPrimitive
+{
+    Quads,
+    Lines, // Segmentos sueltos (pares de vértices)
+    Points
+};
+
+struct BatchVertex
+{
+    float x, y;
+    uint8_t rgba[4]; // Color por vértice, empaquetado como lo lee glColorPointer(4, GL_UNSIGNED_BYTE)
+};
+
+// Una llamada de dibujo: count vértices desde first con el mismo tipo y grosor
+struct BatchCommand
+{
+    BatchPrimitive primitive;
+    float size; // Grosor de línea o tamaño de punto (0 en Quads)
+    size_t first;
+    size_t count;
+};
+
+// Se llena con Add*, se ordena con Build() y se dibuja con IRenderBackend::DrawBatch. Los comandos
+// quedan a la vista (GetCommands/GetVertices), así que se puede comprobar qué se dibuja sin ventana.
+class PrimitiveBatch
+{
+private:
+    struct Item
+    {
+        BatchPrimitive primitive;
+        float size;
+        size_t first; // Rango en pending
+        size_t count;
+    };
+
+    std::vector<BatchVertex> pending;
+    std::vector<Item> items;
+    std::vector<BatchVertex> vertices;
+    std::vector<BatchCommand> commands;
+
+    void AddVertex(float x, float y, const Color &color);
+    void AddItem(BatchPrimitive primitive, float size, size_t first);
+
+public:
+    // Coordenadas OpenGL; esquinas (left, top), (right, top), (right, bottom), (left, bottom)
+    void AddQuad(float left, float top, float right, float bottom, const Color &color);
+    void AddLine(float x0, float y0, float x1, float y1, const Color &color, float width);
+    // Contorno cerrado de count pares (x, y), como un GL_LINE_LOOP
+    void AddLineLoop(const float *xy, size_t count, const Color &color, float width);
+    void AddPoint(float x, float y, const Color &color, float size);
+
+    // Ordena lo añadido por tipo y grosor (sin cambiar el orden entre iguales) y une en un
+    // comando todo lo que comparte estado
+    void Build();
+    void Clear();
+
+    bool IsEmpty() const { return items.empty(); }
+    const std::vector<BatchVertex> &GetVertices() const { return vertices; }
+    const std::vector<BatchCommand> &GetCommands() const { return commands; }
+};
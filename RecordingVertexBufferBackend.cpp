@@ -0,0 +1,49 @@
+// RecordingVertexBufferBackend.cpp
+#include "RecordingVertexBufferBackend.h"
+
+RecordingVertexBufferBackend::RecordingVertexBufferBackend() : nextBuffer(1)
+{
+}
+
+VertexBufferId RecordingVertexBufferBackend::CreateBuffer()
+{
+    VertexBufferId buffer = nextBuffer++;
+    buffers[buffer];
+    commands.push_back({Operation::Create, buffer, VertexPrimitive::Points, 0, 0});
+    return buffer;
+}
+
+void RecordingVertexBufferBackend::UploadVertices(VertexBufferId buffer, const float *xy, size_t count)
+{
+    buffers[buffer].assign(xy, xy + count * 2);
+    commands.push_back({Operation::Upload, buffer, VertexPrimitive::Points, 0, count});
+}
+
+void RecordingVertexBufferBackend::DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count)
+{
+    commands.push_back({Operation::Draw, buffer, primitive, first, count});
+}
+
+void RecordingVertexBufferBackend::DestroyBuffer(VertexBufferId buffer)
+{
+    buffers.erase(buffer);
+    commands.push_back({Operation::Destroy, buffer, VertexPrimitive::Points, 0, 0});
+}
+
+size_t RecordingVertexBufferBackend::CountOperations(Operation operation) const
+{
+    size_t count = 0;
+    for (const auto &command : commands)
+    {
+        if (command.operation == operation)
+            count++;
+    }
+    return count;
+}
+
+const std::vector<float> &RecordingVertexBufferBackend::GetBufferData(VertexBufferId buffer) const
+{
+    static const std::vector<float> empty;
+    auto it = buffers.find(buffer);
+    return it != buffers.end() ? it->second : empty;
+}
@@ -0,0 +1,46 @@
+// RecordingVertexBufferBackend.h - Null backend that records buffer operations (headless, no GPU)
+#pragma once
+#include "IVertexBufferBackend.h"
+#include <map>
+#include <vector>
+
+class RecordingVertexBufferBackend : public IVertexBufferBackend
+{
+public:
+    enum class Operation
+    {
+        Create,
+        Upload,
+        Draw,
+        Destroy
+    };
+
+    struct Command
+    {
+        Operation operation;
+        VertexBufferId buffer;
+        VertexPrimitive primitive;
+        size_t first;
+        size_t count;
+    };
+
+private:
+    VertexBufferId nextBuffer;
+    std::map<VertexBufferId, std::vector<float>> buffers;
+    std::vector<Command> commands;
+
+public:
+    RecordingVertexBufferBackend();
+
+    VertexBufferId CreateBuffer() override;
+    void UploadVertices(VertexBufferId buffer, const float *xy, size_t count) override;
+    void DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count) override;
+    void DestroyBuffer(VertexBufferId buffer) override;
+
+    const std::vector<Command> &GetCommands() const { return commands; }
+    size_t CountOperations(Operation operation) const;
+    size_t GetLiveBufferCount() const { return buffers.size(); }
+    // Contenido subido (pares x, y); vacío si el buffer no existe
+    const std::vector<float> &GetBufferData(VertexBufferId buffer) const;
+    void ClearCommands() { commands.clear(); }
+};
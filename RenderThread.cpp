@@ -0,0 +1,92 @@
+// RenderThread.cpp
+#include "RenderThread.h"
+
+RenderThread::RenderThread(size_t queueCapacity)
+    : queue(queueCapacity), stopping(false), publishedCount(0), rejectedCount(0), renderedCount(0),
+      droppedCount(0), lastRenderedVersion(0)
+{
+}
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+void RenderThread::Start(ThreadFunction startFunction, RenderFunction renderFunction, ThreadFunction stopFunction)
+{
+    if (thread.joinable())
+        return;
+
+    onStart = std::move(startFunction);
+    render = std::move(renderFunction);
+    onStop = std::move(stopFunction);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = false;
+    }
+    thread = std::thread(&RenderThread::ThreadMain, this);
+}
+
+void RenderThread::Stop()
+{
+    if (!thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+
+    // Soltar lo que quedó sin dibujar
+    SnapshotPtr discarded;
+    queue.PopLatest(discarded);
+}
+
+bool RenderThread::Publish(SnapshotPtr snapshot)
+{
+    if (!queue.TryPush(std::move(snapshot)))
+    {
+        rejectedCount++;
+        return false;
+    }
+    publishedCount++;
+
+    // Pasar por el mutex evita que el aviso se pierda entre la comprobación y la espera del hilo
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+    return true;
+}
+
+void RenderThread::ThreadMain()
+{
+    if (onStart)
+        onStart();
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [this]()
+                      { return stopping || !queue.IsEmpty(); });
+            if (stopping)
+                break;
+        }
+
+        SnapshotPtr snapshot;
+        size_t popped = queue.PopLatest(snapshot);
+        if (popped == 0)
+            continue;
+
+        droppedCount += popped - 1;
+        render(*snapshot);
+        lastRenderedVersion = snapshot->sceneVersion;
+        renderedCount++;
+    }
+
+    if (onStop)
+        onStop();
+}
@@ -0,0 +1,63 @@
+// RenderThread.h - Draws the newest published FrameSnapshot on a dedicated thread
+#pragma once
+#include "FrameSnapshot.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Un hilo productor (el de la interfaz) publica snapshots con Publish y este hilo dibuja siempre el
+// más reciente: si se acumulan varios mientras dibuja, los antiguos se descartan sin dibujar.
+// El paso de snapshots es sin bloqueos (SpscQueue); el mutex solo sirve para dormir cuando no hay nada.
+class RenderThread
+{
+public:
+    using SnapshotPtr = std::shared_ptr<const FrameSnapshot>;
+    using RenderFunction = std::function<void(const FrameSnapshot &)>;
+    using ThreadFunction = std::function<void()>;
+
+private:
+    SpscQueue<SnapshotPtr> queue;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping; // Protegido por wakeMutex
+    std::thread thread;
+
+    ThreadFunction onStart;
+    RenderFunction render;
+    ThreadFunction onStop;
+
+    std::atomic<uint64_t> publishedCount;
+    std::atomic<uint64_t> rejectedCount; // Publish con la cola llena
+    std::atomic<uint64_t> renderedCount;
+    std::atomic<uint64_t> droppedCount;  // Publicados pero superados por uno más nuevo
+    std::atomic<uint64_t> lastRenderedVersion;
+
+    void ThreadMain();
+
+public:
+    explicit RenderThread(size_t queueCapacity = 8);
+    ~RenderThread();
+
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+
+    // startFunction y stopFunction corren en el hilo de render (p. ej. activar y soltar el contexto GL)
+    void Start(ThreadFunction startFunction, RenderFunction renderFunction, ThreadFunction stopFunction);
+    // Espera a que termine el frame en curso; lo pendiente no se dibuja. Se puede llamar varias veces.
+    void Stop();
+    bool IsRunning() const { return thread.joinable(); }
+
+    // Solo desde un hilo (el productor). false si la cola está llena: hay que volver a publicar más tarde
+    bool Publish(SnapshotPtr snapshot);
+
+    uint64_t GetPublishedCount() const { return publishedCount; }
+    uint64_t GetRejectedCount() const { return rejectedCount; }
+    uint64_t GetRenderedCount() const { return renderedCount; }
+    uint64_t GetDroppedCount() const { return droppedCount; }
+    uint64_t GetLastRenderedVersion() const { return lastRenderedVersion; }
+};
@@ -0,0 +1,13 @@
+// SceneVersion.cpp
+#include "SceneVersion.h"
+#include <atomic>
+
+namespace
+{
+    std::atomic<uint64_t> nextSceneVersion(1);
+}
+
+uint64_t NextSceneVersion()
+{
+    return nextSceneVersion++;
+}
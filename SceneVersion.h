@@ -0,0 +1,60 @@
+// SceneVersion.h - Monotonic scene versions and per-window tracking of what was last rendered
+#pragma once
+#include <cstdint>
+
+// Reloj global de versiones: cada llamada devuelve un valor mayor que todos los anteriores.
+// Como todas las versiones (figuras, pivote, paleta...) salen de aquí, el máximo de las versiones
+// de lo que muestra una ventana cambia si y solo si cambió algo de ello.
+uint64_t NextSceneVersion();
+
+// Versión de una parte de la escena que no es una Figure (pivote, selección de la paleta...)
+class SceneVersion
+{
+private:
+    uint64_t value;
+
+public:
+    SceneVersion() : value(NextSceneVersion()) {}
+
+    void Touch() { value = NextSceneVersion(); }
+    uint64_t Get() const { return value; }
+};
+
+// Recuerda la versión dibujada por una ventana para saltarse frames sin cambios
+class FrameSkipTracker
+{
+private:
+    uint64_t renderedVersion;
+    bool forceNext;
+    uint64_t framesRendered;
+    uint64_t framesSkipped;
+
+public:
+    FrameSkipTracker() : renderedVersion(0), forceNext(true), framesRendered(0), framesSkipped(0) {}
+
+    // true si hay que dibujar sceneVersion; si no, cuenta el frame como saltado
+    bool ShouldRender(uint64_t sceneVersion)
+    {
+        if (!forceNext && sceneVersion == renderedVersion)
+        {
+            framesSkipped++;
+            return false;
+        }
+        return true;
+    }
+
+    void MarkRendered(uint64_t sceneVersion)
+    {
+        renderedVersion = sceneVersion;
+        forceNext = false;
+        framesRendered++;
+    }
+
+    // El próximo frame se dibuja aunque la escena no haya cambiado (p. ej. nuevo tamaño)
+    void Invalidate() { forceNext = true; }
+    // Hay un Invalidate() pendiente: la imagen anterior no vale y hay que dibujarla entera
+    bool IsInvalidated() const { return forceNext; }
+
+    uint64_t GetFramesRendered() const { return framesRendered; }
+    uint64_t GetFramesSkipped() const { return framesSkipped; }
+};
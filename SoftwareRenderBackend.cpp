@@ -0,0 +1,468 @@
+// SoftwareRenderBackend.cpp
+#include "SoftwareRenderBackend.h"
+#include "ParallelFor.h"
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const size_t ROWS_PER_BAND = 16; // Las bandas empiezan en múltiplos de 16 filas
+
+    uint8_t ToByte(float value)
+    {
+        value = (std::min)((std::max)(value, 0.0f), 1.0f);
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    // Convierte a int recortando antes a [low, high]: un float fuera del rango de int (o infinito)
+    // no se puede convertir. NaN da low.
+    int ClampToInt(float value, int low, int high)
+    {
+        if (!(value > static_cast<float>(low)))
+            return low;
+        if (value >= static_cast<float>(high))
+            return high;
+        return static_cast<int>(value);
+    }
+
+    struct RowTarget
+    {
+        uint8_t *pixels;
+        int width;
+        int rowBegin; // Banda [rowBegin, rowEnd), ya recortada a la región dañada
+        int rowEnd;
+        int columnBegin; // Columnas [columnBegin, columnEnd) de la región dañada
+        int columnEnd;
+        const uint8_t *rgba;
+    };
+
+    void FillSpan(const RowTarget &target, int row, int x0, int x1)
+    {
+        x0 = (std::max)(x0, target.columnBegin);
+        x1 = (std::min)(x1, target.columnEnd - 1);
+        uint8_t *p = target.pixels + (static_cast<size_t>(row) * target.width + x0) * 4;
+        for (int x = x0; x <= x1; ++x, p += 4)
+        {
+            p[0] = target.rgba[0];
+            p[1] = target.rgba[1];
+            p[2] = target.rgba[2];
+            p[3] = target.rgba[3];
+        }
+    }
+
+    // Polígono convexo (en píxeles, y hacia abajo): se pintan los píxeles con el centro dentro
+    void FillConvex(const RowTarget &target, const float *xs, const float *ys, int n)
+    {
+        // Un vértice no finito (w <= 0 o desbordamiento) descarta la primitiva entera
+        for (int i = 0; i < n; ++i)
+        {
+            if (!std::isfinite(xs[i]) || !std::isfinite(ys[i]))
+                return;
+        }
+
+        float minY = ys[0], maxY = ys[0];
+        for (int i = 1; i < n; ++i)
+        {
+            minY = (std::min)(minY, ys[i]);
+            maxY = (std::max)(maxY, ys[i]);
+        }
+
+        int firstRow = ClampToInt(std::ceil(minY - 0.5f), target.rowBegin, target.rowEnd);
+        int lastRow = ClampToInt(std::floor(maxY - 0.5f), target.rowBegin - 1, target.rowEnd - 1);
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            float yc = row + 0.5f;
+            float minX = 0.0f, maxX = -1.0f;
+            bool hit = false;
+            for (int i = 0; i < n; ++i)
+            {
+                int j = (i + 1) % n;
+                float y0 = ys[i], y1 = ys[j];
+                if (y0 == y1 || yc < (std::min)(y0, y1) || yc > (std::max)(y0, y1))
+                    continue;
+
+                float x = xs[i] + (yc - y0) * (xs[j] - xs[i]) / (y1 - y0);
+                minX = hit ? (std::min)(minX, x) : x;
+                maxX = hit ? (std::max)(maxX, x) : x;
+                hit = true;
+            }
+
+            if (hit)
+                FillSpan(target, row, ClampToInt(std::ceil(minX - 0.5f), target.columnBegin, target.columnEnd),
+                         ClampToInt(std::floor(maxX - 0.5f), target.columnBegin - 1, target.columnEnd - 1));
+        }
+    }
+
+    void FillSegment(const RowTarget &target, float x0, float y0, float x1, float y1, float lineWidth)
+    {
+        float dx = x1 - x0, dy = y1 - y0;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length == 0.0f)
+            return;
+
+        // Rectángulo de ancho lineWidth centrado en el segmento
+        float half = (std::max)(lineWidth, 1.0f) * 0.5f;
+        float nx = -dy / length * half, ny = dx / length * half;
+        float xs[4] = {x0 + nx, x1 + nx, x1 - nx, x0 - nx};
+        float ys[4] = {y0 + ny, y1 + ny, y1 - ny, y0 - ny};
+        FillConvex(target, xs, ys, 4);
+    }
+
+    void FillPoint(const RowTarget &target, float x, float y, float pointSize)
+    {
+        float half = (std::max)(pointSize, 1.0f) * 0.5f;
+        float xs[4] = {x - half, x + half, x + half, x - half};
+        float ys[4] = {y - half, y - half, y + half, y + half};
+        FillConvex(target, xs, ys, 4);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Buffers retenidos: los vértices se guardan en memoria y se dibujan como primitivas normales
+// ---------------------------------------------------------------------------
+
+SoftwareRenderBackend::VertexBuffers::VertexBuffers(SoftwareRenderBackend &backend)
+    : owner(backend), nextBuffer(1)
+{
+}
+
+VertexBufferId SoftwareRenderBackend::VertexBuffers::CreateBuffer()
+{
+    VertexBufferId buffer = nextBuffer++;
+    buffers[buffer];
+    return buffer;
+}
+
+void SoftwareRenderBackend::VertexBuffers::UploadVertices(VertexBufferId buffer, const float *xy, size_t count)
+{
+    buffers[buffer].assign(xy, xy + count * 2);
+}
+
+void SoftwareRenderBackend::VertexBuffers::DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count)
+{
+    auto it = buffers.find(buffer);
+    if (it == buffers.end() || (first + count) * 2 > it->second.size())
+        return;
+
+    const float *xy = it->second.data() + first * 2;
+    switch (primitive)
+    {
+    case VertexPrimitive::LineStrip:
+        owner.DrawLineStrip(xy, count);
+        break;
+    case VertexPrimitive::LineLoop:
+        owner.DrawLineLoop(xy, count);
+        break;
+    default:
+        owner.DrawPoints(xy, count);
+        break;
+    }
+}
+
+void SoftwareRenderBackend::VertexBuffers::DestroyBuffer(VertexBufferId buffer)
+{
+    buffers.erase(buffer);
+}
+
+// ---------------------------------------------------------------------------
+// SoftwareRenderBackend
+// ---------------------------------------------------------------------------
+
+SoftwareRenderBackend::SoftwareRenderBackend(int framebufferWidth, int framebufferHeight)
+    : width(0), height(0), parallelRasterization(true), lineWidth(1.0f), pointSize(1.0f),
+      clipLeft(0), clipTop(0), clipRight(0), clipBottom(0), vertexBuffers(*this)
+{
+    color[0] = color[1] = color[2] = color[3] = 255;
+    Resize(framebufferWidth, framebufferHeight);
+}
+
+void SoftwareRenderBackend::Resize(int framebufferWidth, int framebufferHeight)
+{
+    width = (std::max)(framebufferWidth, 0);
+    height = (std::max)(framebufferHeight, 0);
+    pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    commands.clear();
+    vertices.clear();
+    ClearDamageRect();
+}
+
+bool SoftwareRenderBackend::SetDamageRect(float left, float top, float right, float bottom)
+{
+    // De coordenadas OpenGL a píxeles, redondeando hacia fuera
+    float x0 = (left + 1.0f) * 0.5f * width, x1 = (right + 1.0f) * 0.5f * width;
+    float y0 = (1.0f - top) * 0.5f * height, y1 = (1.0f - bottom) * 0.5f * height;
+    clipLeft = ClampToInt(std::floor((std::min)(x0, x1)), 0, width);
+    clipRight = ClampToInt(std::ceil((std::max)(x0, x1)), 0, width);
+    clipTop = ClampToInt(std::floor((std::min)(y0, y1)), 0, height);
+    clipBottom = ClampToInt(std::ceil((std::max)(y0, y1)), 0, height);
+    return true;
+}
+
+void SoftwareRenderBackend::ClearDamageRect()
+{
+    clipLeft = 0;
+    clipTop = 0;
+    clipRight = width;
+    clipBottom = height;
+}
+
+void SoftwareRenderBackend::SetClip(Command &command) const
+{
+    command.clipLeft = clipLeft;
+    command.clipTop = clipTop;
+    command.clipRight = clipRight;
+    command.clipBottom = clipBottom;
+}
+
+void SoftwareRenderBackend::Clear(float r, float g, float b)
+{
+    // Un clear de todo el framebuffer deja sin efecto lo anterior
+    if (clipLeft == 0 && clipTop == 0 && clipRight == width && clipBottom == height)
+    {
+        commands.clear();
+        vertices.clear();
+    }
+
+    Command command;
+    command.type = CommandType::Clear;
+    command.rgba[0] = ToByte(r);
+    command.rgba[1] = ToByte(g);
+    command.rgba[2] = ToByte(b);
+    command.rgba[3] = 255;
+    command.size = 0.0f;
+    command.first = 0;
+    command.count = 0;
+    SetClip(command);
+    commands.push_back(command);
+}
+
+void SoftwareRenderBackend::SetColor(const Color &newColor)
+{
+    color[0] = ToByte(newColor.r);
+    color[1] = ToByte(newColor.g);
+    color[2] = ToByte(newColor.b);
+    color[3] = 255;
+}
+
+void SoftwareRenderBackend::SetLineWidth(float newWidth)
+{
+    lineWidth = newWidth;
+}
+
+void SoftwareRenderBackend::SetPointSize(float newSize)
+{
+    pointSize = newSize;
+}
+
+void SoftwareRenderBackend::SetModelMatrix(const TransformMatrix &modelMatrix)
+{
+    model = modelMatrix;
+}
+
+void SoftwareRenderBackend::Record(CommandType type, const float *xy, size_t count)
+{
+    if (count == 0)
+        return;
+    CountDrawCall(count);
+    Append(type, xy, count);
+}
+
+// Graba sin contar la llamada: DrawBatch cuenta una por comando, como OpenGLRenderBackend
+void SoftwareRenderBackend::Append(CommandType type, const float *xy, size_t count)
+{
+    Command command;
+    command.type = type;
+    std::copy(color, color + 4, command.rgba);
+    command.size = (type == CommandType::Points) ? pointSize : lineWidth;
+    command.first = vertices.size() / 2;
+    command.count = count;
+    SetClip(command);
+
+    // Matriz de modelo y paso a píxeles al grabar: la rasterización solo ve coordenadas finales.
+    // Con una matriz proyectiva se divide por w como hace OpenGL; un vértice con w <= 0 queda
+    // como NaN y las primitivas que lo tocan no pintan nada (OpenGL recortaría la parte visible).
+    const float (&m)[3][3] = model.m;
+    bool projective = !model.IsAffine();
+    float halfWidth = width * 0.5f, halfHeight = height * 0.5f;
+    vertices.reserve(vertices.size() + count * 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float x = xy[i * 2], y = xy[i * 2 + 1];
+        float tx = m[0][0] * x + m[0][1] * y + m[0][2];
+        float ty = m[1][0] * x + m[1][1] * y + m[1][2];
+        if (projective)
+        {
+            float tw = m[2][0] * x + m[2][1] * y + m[2][2];
+            if (tw > 0.0f)
+            {
+                tx /= tw;
+                ty /= tw;
+            }
+            else
+                tx = ty = std::numeric_limits<float>::quiet_NaN();
+        }
+        vertices.push_back((tx + 1.0f) * halfWidth);
+        vertices.push_back((1.0f - ty) * halfHeight);
+    }
+    commands.push_back(command);
+}
+
+void SoftwareRenderBackend::DrawLineStrip(const float *xy, size_t count)
+{
+    Record(CommandType::LineStrip, xy, count);
+}
+
+void SoftwareRenderBackend::DrawLineLoop(const float *xy, size_t count)
+{
+    Record(CommandType::LineLoop, xy, count);
+}
+
+void SoftwareRenderBackend::DrawPoints(const float *xy, size_t count)
+{
+    Record(CommandType::Points, xy, count);
+}
+
+void SoftwareRenderBackend::DrawQuad(float left, float top, float right, float bottom)
+{
+    const float corners[8] = {left, top, right, top, right, bottom, left, bottom};
+    Record(CommandType::Quad, corners, 4);
+}
+
+void SoftwareRenderBackend::DrawBatch(const PrimitiveBatch &batch)
+{
+    uint8_t savedColor[4] = {color[0], color[1], color[2], color[3]};
+    float savedLineWidth = lineWidth;
+    float savedPointSize = pointSize;
+
+    // Aquí cada primitiva es un comando (el color va por comando, no por vértice)
+    const auto &batchVertices = batch.GetVertices();
+    for (const auto &command : batch.GetCommands())
+    {
+        CountDrawCall(command.count);
+        CommandType type = CommandType::Quad;
+        size_t stride = 4;
+        if (command.primitive == BatchPrimitive::Lines)
+        {
+            type = CommandType::LineStrip;
+            stride = 2;
+            lineWidth = command.size;
+        }
+        else if (command.primitive == BatchPrimitive::Points)
+        {
+            type = CommandType::Points;
+            stride = 1;
+            pointSize = command.size;
+        }
+
+        for (size_t i = command.first; i + stride <= command.first + command.count; i += stride)
+        {
+            float xy[8];
+            for (size_t j = 0; j < stride; ++j)
+            {
+                xy[j * 2] = batchVertices[i + j].x;
+                xy[j * 2 + 1] = batchVertices[i + j].y;
+            }
+            for (int c = 0; c < 4; ++c)
+            {
+                color[c] = batchVertices[i].rgba[c];
+            }
+            Append(type, xy, stride);
+        }
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+        color[c] = savedColor[c];
+    }
+    lineWidth = savedLineWidth;
+    pointSize = savedPointSize;
+}
+
+void SoftwareRenderBackend::RasterizeRows(size_t rowBegin, size_t rowEnd)
+{
+    RowTarget target;
+    target.pixels = pixels.data();
+    target.width = width;
+
+    for (const auto &command : commands)
+    {
+        target.rowBegin = (std::max)(static_cast<int>(rowBegin), command.clipTop);
+        target.rowEnd = (std::min)(static_cast<int>(rowEnd), command.clipBottom);
+        target.columnBegin = command.clipLeft;
+        target.columnEnd = command.clipRight;
+        if (target.rowBegin >= target.rowEnd || target.columnBegin >= target.columnEnd)
+            continue;
+
+        target.rgba = command.rgba;
+        const float *v = vertices.data() + command.first * 2;
+
+        switch (command.type)
+        {
+        case CommandType::Clear:
+            for (int row = target.rowBegin; row < target.rowEnd; ++row)
+            {
+                FillSpan(target, row, target.columnBegin, target.columnEnd - 1);
+            }
+            break;
+
+        case CommandType::LineStrip:
+        case CommandType::LineLoop:
+            for (size_t i = 0; i + 1 < command.count; ++i)
+            {
+                FillSegment(target, v[i * 2], v[i * 2 + 1], v[i * 2 + 2], v[i * 2 + 3], command.size);
+            }
+            if (command.type == CommandType::LineLoop && command.count > 2)
+            {
+                size_t last = command.count - 1;
+                FillSegment(target, v[last * 2], v[last * 2 + 1], v[0], v[1], command.size);
+            }
+            break;
+
+        case CommandType::Points:
+            for (size_t i = 0; i < command.count; ++i)
+            {
+                FillPoint(target, v[i * 2], v[i * 2 + 1], command.size);
+            }
+            break;
+
+        case CommandType::Quad:
+        {
+            float xs[4] = {v[0], v[2], v[4], v[6]};
+            float ys[4] = {v[1], v[3], v[5], v[7]};
+            FillConvex(target, xs, ys, 4);
+            break;
+        }
+        }
+    }
+}
+
+void SoftwareRenderBackend::Flush()
+{
+    if (commands.empty() || width == 0 || height == 0)
+    {
+        commands.clear();
+        vertices.clear();
+        return;
+    }
+
+    if (parallelRasterization)
+    {
+        ParallelFor(static_cast<size_t>(height), ROWS_PER_BAND, [this](size_t begin, size_t end)
+                    { RasterizeRows(begin, end); });
+    }
+    else
+    {
+        RasterizeRows(0, static_cast<size_t>(height));
+    }
+
+    commands.clear();
+    vertices.clear();
+}
+
+const std::vector<uint8_t> &SoftwareRenderBackend::GetPixels()
+{
+    Flush();
+    return pixels;
+}
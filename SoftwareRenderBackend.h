@@ -0,0 +1,105 @@
+// SoftwareRenderBackend.h - IRenderBackend rasterized on the CPU into an RGBA framebuffer (no window, no GPU)
+#pragma once
+#include "IRenderBackend.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Las primitivas se acumulan y se rasterizan en Flush(), repartiendo el framebuffer en bandas de
+// filas entre hilos. Cada banda aplica todas las primitivas en orden, así el resultado no depende
+// del número de hilos. Reglas como las de OpenGL sin antialiasing: un píxel se pinta si su centro
+// cae dentro; las líneas gruesas son rectángulos por segmento y los puntos, cuadrados.
+class SoftwareRenderBackend : public IRenderBackend
+{
+private:
+    enum class CommandType
+    {
+        Clear,
+        LineStrip,
+        LineLoop,
+        Points,
+        Quad
+    };
+
+    struct Command
+    {
+        CommandType type;
+        uint8_t rgba[4];
+        float size;   // Grosor de línea o tamaño de punto, en píxeles
+        size_t first; // Rango en vertices
+        size_t count;
+        int clipLeft, clipTop, clipRight, clipBottom; // Píxeles [left, right) x [top, bottom)
+    };
+
+    class VertexBuffers : public IVertexBufferBackend
+    {
+    private:
+        SoftwareRenderBackend &owner;
+        VertexBufferId nextBuffer;
+        std::map<VertexBufferId, std::vector<float>> buffers;
+
+    public:
+        explicit VertexBuffers(SoftwareRenderBackend &backend);
+
+        VertexBufferId CreateBuffer() override;
+        void UploadVertices(VertexBufferId buffer, const float *xy, size_t count) override;
+        void DrawBuffer(VertexBufferId buffer, VertexPrimitive primitive, size_t first, size_t count) override;
+        void DestroyBuffer(VertexBufferId buffer) override;
+    };
+
+    int width;
+    int height;
+    std::vector<uint8_t> pixels; // RGBA, fila 0 arriba
+    bool parallelRasterization;
+
+    uint8_t color[4];
+    float lineWidth;
+    float pointSize;
+    TransformMatrix model;
+    int clipLeft, clipTop, clipRight, clipBottom; // Región dañada actual (todo el framebuffer por defecto)
+
+    std::vector<Command> commands;
+    std::vector<float> vertices; // Pendientes, ya en píxeles
+    VertexBuffers vertexBuffers;
+
+    void Record(CommandType type, const float *xy, size_t count);
+    void Append(CommandType type, const float *xy, size_t count);
+    void SetClip(Command &command) const;
+    void RasterizeRows(size_t rowBegin, size_t rowEnd);
+
+public:
+    SoftwareRenderBackend(int framebufferWidth, int framebufferHeight);
+
+    SoftwareRenderBackend(const SoftwareRenderBackend &) = delete;
+    SoftwareRenderBackend &operator=(const SoftwareRenderBackend &) = delete;
+
+    void Clear(float r, float g, float b) override;
+    void SetColor(const Color &newColor) override;
+    void SetLineWidth(float newWidth) override;
+    void SetPointSize(float newSize) override;
+    void SetModelMatrix(const TransformMatrix &modelMatrix) override;
+
+    void DrawLineStrip(const float *xy, size_t count) override;
+    void DrawLineLoop(const float *xy, size_t count) override;
+    void DrawPoints(const float *xy, size_t count) override;
+    void DrawQuad(float left, float top, float right, float bottom) override;
+    void DrawBatch(const PrimitiveBatch &batch) override;
+
+    bool SetDamageRect(float left, float top, float right, float bottom) override;
+    void ClearDamageRect() override;
+
+    IVertexBufferBackend &GetVertexBuffers() override { return vertexBuffers; }
+
+    // Rasteriza las primitivas pendientes
+    void Flush();
+    // Por defecto Flush reparte las bandas entre hilos; desactivarlo si ya se renderiza
+    // un framebuffer por hilo (por ejemplo, exportando muchas figuras en paralelo)
+    void SetParallelRasterization(bool enabled) { parallelRasterization = enabled; }
+    // Cambia el tamaño (descarta el contenido y lo pendiente)
+    void Resize(int framebufferWidth, int framebufferHeight);
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    // Framebuffer con todo lo dibujado hasta ahora (hace Flush)
+    const std::vector<uint8_t> &GetPixels();
+};
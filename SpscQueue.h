@@ -0,0 +1,87 @@
+// SpscQueue.h - Lock-free bounded queue for exactly one producer thread and one consumer thread
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Anillo de capacidad potencia de dos. head solo lo escribe el consumidor y tail solo el productor;
+// cada uno publica con release y lee el del otro con acquire, así que no hacen falta mutex.
+// Con más de un productor o más de un consumidor no es correcta.
+template <typename T>
+class SpscQueue
+{
+private:
+    static const size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+    char padding0[CACHE_LINE];
+    std::atomic<size_t> head; // Próximo a sacar (consumidor)
+    char padding1[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail; // Próximo hueco libre (productor)
+    char padding2[CACHE_LINE - sizeof(std::atomic<size_t>)];
+
+    static size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots(RoundUpToPowerOfTwo(capacity)), mask(slots.size() - 1), head(0), tail(0)
+    {
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Productor. false si está llena (value se descarta)
+    bool TryPush(T value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == slots.size())
+            return false;
+
+        slots[position & mask] = std::move(value);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor. false si está vacía
+    bool TryPop(T &out)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire))
+            return false;
+
+        out = std::move(slots[position & mask]);
+        slots[position & mask] = T(); // No retener lo que ya salió (p. ej. un shared_ptr)
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor. Vacía la cola y deja en out el elemento más reciente; devuelve cuántos sacó
+    size_t PopLatest(T &out)
+    {
+        size_t popped = 0;
+        T value;
+        while (TryPop(value))
+        {
+            out = std::move(value);
+            popped++;
+        }
+        return popped;
+    }
+
+    // Aproximado si lo llama un hilo mientras el otro opera
+    bool IsEmpty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const { return slots.size(); }
+};
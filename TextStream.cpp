@@ -0,0 +1,245 @@
+// TextStream.cpp
+#include "TextStream.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const size_t MAX_PEEK_AHEAD = 16;
+    const size_t NUMBER_LOOKAHEAD = 64;    // Lo que suele ocupar un número como mucho
+    const int MAX_MANTISSA_DIGITS = 19;    // Caben en uint64_t; los demás solo mueven el exponente
+
+    bool IsDigit(int c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    double PowerOfTen(int exponent)
+    {
+        // Exactas en double hasta 1e22
+        static const double exact[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        int magnitude = exponent < 0 ? -exponent : exponent;
+        double power = magnitude <= 22 ? exact[magnitude] : std::pow(10.0, magnitude);
+        return exponent < 0 ? 1.0 / power : power;
+    }
+
+    // Número en [p, limit); devuelve dónde termina, o nullptr si no hay número
+    const char *ParseNumber(const char *p, const char *limit, double &value)
+    {
+        bool negative = false;
+        if (p < limit && (*p == '+' || *p == '-'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool anyDigit = false;
+
+        while (p < limit && IsDigit(*p))
+        {
+            if (digits < MAX_MANTISSA_DIGITS)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0)
+                    digits++;
+            }
+            else
+            {
+                exponent++;
+            }
+            anyDigit = true;
+            ++p;
+        }
+
+        if (p < limit && *p == '.')
+        {
+            ++p;
+            while (p < limit && IsDigit(*p))
+            {
+                if (digits < MAX_MANTISSA_DIGITS)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0)
+                        digits++;
+                    exponent--;
+                }
+                anyDigit = true;
+                ++p;
+            }
+        }
+
+        if (!anyDigit)
+            return nullptr;
+
+        // El exponente solo si le sigue un dígito: en "5em" o "1e" la 'e' es de otra cosa
+        if (p < limit && (*p == 'e' || *p == 'E'))
+        {
+            const char *q = p + 1;
+            bool negativeExponent = false;
+            if (q < limit && (*q == '+' || *q == '-'))
+            {
+                negativeExponent = *q == '-';
+                ++q;
+            }
+            if (q < limit && IsDigit(*q))
+            {
+                int explicitExponent = 0;
+                while (q < limit && IsDigit(*q))
+                {
+                    if (explicitExponent < 100000)
+                        explicitExponent = explicitExponent * 10 + (*q - '0');
+                    ++q;
+                }
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                p = q;
+            }
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (exponent != 0 && mantissa != 0)
+            result *= PowerOfTen(exponent);
+        value = negative ? -result : result;
+        return p;
+    }
+}
+
+TextStream::TextStream(std::istream &source)
+    : input(source), buffer(new char[BUFFER_SIZE]), cursor(nullptr), end(nullptr),
+      inputExhausted(false), bufferOffset(0), line(1), lineStartOffset(0)
+{
+    cursor = end = buffer.get();
+}
+
+bool TextStream::Refill()
+{
+    if (inputExhausted)
+        return cursor != end;
+
+    size_t remaining = static_cast<size_t>(end - cursor);
+    bufferOffset += static_cast<uint64_t>(cursor - buffer.get());
+    if (remaining > 0 && cursor != buffer.get())
+        std::memmove(buffer.get(), cursor, remaining);
+    cursor = buffer.get();
+    end = cursor + remaining;
+
+    input.read(buffer.get() + remaining, static_cast<std::streamsize>(BUFFER_SIZE - remaining));
+    std::streamsize count = input.gcount();
+    if (count <= 0)
+        inputExhausted = true;
+    end += count;
+    return cursor != end;
+}
+
+void TextStream::Reserve(size_t count)
+{
+    while (static_cast<size_t>(end - cursor) < count && !inputExhausted)
+    {
+        size_t before = static_cast<size_t>(end - cursor);
+        if (!Refill() || static_cast<size_t>(end - cursor) == before)
+            return;
+    }
+}
+
+int TextStream::PeekAt(size_t ahead)
+{
+    if (ahead >= MAX_PEEK_AHEAD)
+        return END;
+    Reserve(ahead + 1);
+    if (static_cast<size_t>(end - cursor) <= ahead)
+        return END;
+    return static_cast<unsigned char>(cursor[ahead]);
+}
+
+void TextStream::SkipInlineSpaces()
+{
+    for (;;)
+    {
+        const char *p = cursor;
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        cursor = p;
+        if (p < end || !Refill())
+            return;
+    }
+}
+
+void TextStream::SkipSpaces()
+{
+    for (;;)
+    {
+        const char *p = cursor;
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        {
+            if (*p++ == '\n')
+            {
+                ++line;
+                lineStartOffset = bufferOffset + static_cast<uint64_t>(p - buffer.get());
+            }
+        }
+        cursor = p;
+        if (p < end || !Refill())
+            return;
+    }
+}
+
+void TextStream::SkipSpacesAndCommas()
+{
+    for (;;)
+    {
+        const char *p = cursor;
+        while (p < end && (*p == ' ' || *p == ',' || *p == '\t' || *p == '\r' || *p == '\n'))
+        {
+            if (*p++ == '\n')
+            {
+                ++line;
+                lineStartOffset = bufferOffset + static_cast<uint64_t>(p - buffer.get());
+            }
+        }
+        cursor = p;
+        if (p < end || !Refill())
+            return;
+    }
+}
+
+void TextStream::SkipLine()
+{
+    for (;;)
+    {
+        const void *newline = std::memchr(cursor, '\n', static_cast<size_t>(end - cursor));
+        if (newline)
+        {
+            cursor = static_cast<const char *>(newline) + 1;
+            ++line;
+            lineStartOffset = GetOffset();
+            return;
+        }
+        cursor = end;
+        if (!Refill())
+            return;
+    }
+}
+
+bool TextStream::ReadNumber(double &value)
+{
+    if (static_cast<size_t>(end - cursor) < NUMBER_LOOKAHEAD)
+        Reserve(NUMBER_LOOKAHEAD);
+    const char *stop = ParseNumber(cursor, end, value);
+
+    // Número que llega al final del buffer: puede seguir en lo que aún no se ha leído
+    for (size_t wanted = NUMBER_LOOKAHEAD * 2; stop == end && !inputExhausted && wanted <= BUFFER_SIZE; wanted *= 2)
+    {
+        Reserve(wanted);
+        stop = ParseNumber(cursor, end, value);
+    }
+
+    if (!stop)
+        return false;
+    // Sin saltos de línea dentro de un número: la línea no cambia
+    cursor = stop;
+    return true;
+}
@@ -0,0 +1,87 @@
+// TextStream.h - Chunked character reader with line/column tracking and fast number parsing
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+
+// Lee un istream por bloques de tamaño fijo: la memoria no depende del tamaño de la entrada ni
+// de la longitud de las líneas. Lleva la línea y la columna (desde 1) del próximo carácter para
+// poder señalar dónde está un error. Los bucles calientes (espacios, números, saltar líneas)
+// recorren el buffer con punteros locales en vez de llamar a Get() por carácter.
+class TextStream
+{
+public:
+    static const int END = -1;
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+private:
+    std::istream &input;
+    std::unique_ptr<char[]> buffer;
+    const char *cursor;
+    const char *end;
+    bool inputExhausted;
+    uint64_t bufferOffset;    // Posición en la entrada de buffer[0]
+    size_t line;
+    uint64_t lineStartOffset; // Posición del primer carácter de la línea actual
+
+    // Conserva lo no leído y añade lo siguiente del istream. false si no queda nada más
+    bool Refill();
+    // Intenta tener al menos count caracteres en el buffer (menos solo al final de la entrada)
+    void Reserve(size_t count);
+
+public:
+    explicit TextStream(std::istream &source);
+
+    TextStream(const TextStream &) = delete;
+    TextStream &operator=(const TextStream &) = delete;
+
+    int Peek()
+    {
+        if (cursor == end && !Refill())
+            return END;
+        return static_cast<unsigned char>(*cursor);
+    }
+
+    // ahead < 16: carácter ahead posiciones después del próximo (END si no llega)
+    int PeekAt(size_t ahead);
+
+    int Get()
+    {
+        int c = Peek();
+        if (c == END)
+            return END;
+        ++cursor;
+        if (c == '\n')
+        {
+            ++line;
+            lineStartOffset = GetOffset();
+        }
+        return c;
+    }
+
+    bool Accept(int expected)
+    {
+        if (Peek() != expected)
+            return false;
+        Get();
+        return true;
+    }
+
+    // Espacios, tabuladores y retornos de carro; SkipSpaces también saltos de línea
+    void SkipInlineSpaces();
+    void SkipSpaces();
+    // SkipSpaces más comas (separadores de SVG)
+    void SkipSpacesAndCommas();
+    // Hasta después del próximo '\n' (o el final)
+    void SkipLine();
+
+    // [+-]dígitos[.dígitos][(e|E)[+-]dígitos], también ".5" y "5.". false (sin consumir nada)
+    // si lo siguiente no es un número.
+    bool ReadNumber(double &value);
+
+    bool AtEnd() { return Peek() == END; }
+    size_t GetLine() const { return line; }
+    size_t GetColumn() const { return static_cast<size_t>(GetOffset() - lineStartOffset) + 1; }
+    uint64_t GetOffset() const { return bufferOffset + static_cast<uint64_t>(cursor - buffer.get()); } // Bytes consumidos
+};
@@ -0,0 +1,258 @@
+// TextWriter.cpp
+#include "TextWriter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const int MIN_FLOAT_DIGITS = 6;
+    const int MAX_FLOAT_DIGITS = 9; // Suficientes para cualquier float
+
+    const double EXACT_POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const int MAX_EXACT_POWER = 22;
+
+    // value * 10^power con una sola operación exacta en double
+    double ScaleByPowerOfTen(double value, int power)
+    {
+        return power >= 0 ? value * EXACT_POWERS_OF_TEN[power] : value / EXACT_POWERS_OF_TEN[-power];
+    }
+
+    uint64_t IntegerPowerOfTen(int power)
+    {
+        return static_cast<uint64_t>(EXACT_POWERS_OF_TEN[power]);
+    }
+}
+
+// value > 0 = digits * 10^exponent con el menor número de cifras (de 6 a 9) que vuelve a dar
+// value. Sin printf ni strtof: la comprobación se hace en double, con potencias de diez exactas
+// (false si el exponente se sale de ellas).
+bool TextWriter::ShortestDigits(float value, uint64_t &digits, int &exponent)
+{
+    double exact = static_cast<double>(value);
+    int leading = static_cast<int>(std::floor(std::log10(exact))); // Exponente de la primera cifra
+
+    for (int precision = MIN_FLOAT_DIGITS; precision <= MAX_FLOAT_DIGITS; ++precision)
+    {
+        int scale = precision - 1 - leading;
+        if (scale > MAX_EXACT_POWER || scale < -MAX_EXACT_POWER)
+            return false;
+
+        double scaled = ScaleByPowerOfTen(exact, scale);
+        uint64_t candidate = static_cast<uint64_t>(std::llround(scaled));
+        // log10 puede fallar por uno justo en potencias de diez; el redondeo puede llegar a 10^precision
+        if (candidate >= IntegerPowerOfTen(precision) || candidate < IntegerPowerOfTen(precision - 1))
+        {
+            leading += candidate >= IntegerPowerOfTen(precision) ? 1 : -1;
+            scale = precision - 1 - leading;
+            if (scale > MAX_EXACT_POWER || scale < -MAX_EXACT_POWER)
+                return false;
+            candidate = static_cast<uint64_t>(std::llround(ScaleByPowerOfTen(exact, scale)));
+        }
+
+        if (static_cast<float>(ScaleByPowerOfTen(static_cast<double>(candidate), -scale)) == value)
+        {
+            while (candidate % 10 == 0)
+            {
+                candidate /= 10;
+                scale--;
+            }
+            digits = candidate;
+            exponent = -scale;
+            return true;
+        }
+    }
+    return false;
+}
+
+// digits * 10^exponent como lo escribiría %g: notación normal salvo exponentes muy grandes o
+// muy pequeños, que van como 1.5e-07
+void TextWriter::WriteDigits(uint64_t digits, int exponent)
+{
+    char text[20];
+    int count = 0;
+    for (uint64_t rest = digits; rest != 0; rest /= 10)
+        text[count++] = static_cast<char>('0' + rest % 10);
+    // text tiene las cifras al revés; la primera vale 10^leading
+    int leading = exponent + count - 1;
+
+    if (leading < -4 || leading >= MAX_FLOAT_DIGITS)
+    {
+        Put(text[count - 1]);
+        if (count > 1)
+        {
+            Put('.');
+            for (int i = count - 2; i >= 0; --i)
+                Put(text[i]);
+        }
+        Put('e');
+        Put(leading < 0 ? '-' : '+');
+        int magnitude = leading < 0 ? -leading : leading;
+        if (magnitude < 10)
+            Put('0');
+        WriteUnsigned(static_cast<uint64_t>(magnitude));
+        return;
+    }
+
+    if (leading < 0)
+    {
+        Write("0.");
+        for (int i = -1; i > leading; --i)
+            Put('0');
+        for (int i = count - 1; i >= 0; --i)
+            Put(text[i]);
+        return;
+    }
+
+    // Parte entera: las cifras de 10^leading a 10^0, con ceros si faltan
+    for (int position = leading, i = count - 1; position >= 0; --position, --i)
+        Put(i >= 0 ? text[i] : '0');
+    if (exponent < 0)
+    {
+        Put('.');
+        for (int i = -exponent - 1; i >= 0; --i)
+            Put(text[i]);
+    }
+}
+
+TextWriter::TextWriter(std::ostream &target) : output(target), buffer(new char[BUFFER_SIZE]), used(0) {}
+
+TextWriter::~TextWriter()
+{
+    Flush();
+}
+
+void TextWriter::Write(const char *text, size_t length)
+{
+    if (length > BUFFER_SIZE - used)
+    {
+        Flush();
+        if (length > BUFFER_SIZE)
+        {
+            output.write(text, static_cast<std::streamsize>(length));
+            return;
+        }
+    }
+    std::memcpy(buffer.get() + used, text, length);
+    used += length;
+}
+
+void TextWriter::Write(const char *text)
+{
+    Write(text, std::strlen(text));
+}
+
+void TextWriter::WriteUnsigned(uint64_t value)
+{
+    char digits[20];
+    size_t count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count > 0)
+        Put(digits[--count]);
+}
+
+void TextWriter::WriteFloat(float value, const char *nonFinite)
+{
+    if (!std::isfinite(value))
+    {
+        Write(nonFinite);
+        return;
+    }
+    if (value == 0.0f)
+    {
+        Put('0');
+        return;
+    }
+
+    uint64_t digits;
+    int exponent;
+    if (!ShortestDigits(std::fabs(value), digits, exponent))
+    {
+        // Exponentes extremos: printf/strtof, con el locale "C" del programa (siempre '.')
+        char text[32];
+        int length = 0;
+        for (int precision = 6; precision <= 9; ++precision)
+        {
+            length = std::snprintf(text, sizeof(text), "%.*g", precision, static_cast<double>(value));
+            if (std::strtof(text, nullptr) == value)
+                break; // Con 9 cifras siempre se recupera el float
+        }
+        Write(text, static_cast<size_t>(length));
+        return;
+    }
+
+    if (value < 0.0f)
+        Put('-');
+    WriteDigits(digits, exponent);
+}
+
+void TextWriter::WriteJsonString(const char *text, size_t length)
+{
+    Put('"');
+    for (size_t i = 0; i < length; ++i)
+    {
+        char c = text[i];
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\')
+        {
+            Put('\\');
+            Put(c);
+        }
+        else if (u < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", u);
+            Write(escaped);
+        }
+        else
+        {
+            Put(c);
+        }
+    }
+    Put('"');
+}
+
+void TextWriter::WriteXmlText(const char *text, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        switch (text[i])
+        {
+        case '&':
+            Write("&amp;");
+            break;
+        case '<':
+            Write("&lt;");
+            break;
+        case '>':
+            Write("&gt;");
+            break;
+        case '"':
+            Write("&quot;");
+            break;
+        case '\'':
+            Write("&apos;");
+            break;
+        default:
+            Put(text[i]);
+            break;
+        }
+    }
+}
+
+void TextWriter::Flush()
+{
+    if (used > 0)
+    {
+        output.write(buffer.get(), static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
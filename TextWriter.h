@@ -0,0 +1,55 @@
+// TextWriter.h - Fixed-size buffered text output with deterministic number formatting
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+// Acumula en un buffer propio y lo vuelca al ostream cuando se llena: escribir millones de
+// puntos no construye ninguna cadena intermedia ni reserva memoria aparte de ese buffer.
+// Los números salen siempre igual para el mismo valor, para poder comparar archivos con diff.
+class TextWriter
+{
+public:
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+private:
+    std::ostream &output;
+    std::unique_ptr<char[]> buffer;
+    size_t used;
+
+    static bool ShortestDigits(float value, uint64_t &digits, int &exponent);
+    void WriteDigits(uint64_t digits, int exponent);
+
+public:
+    explicit TextWriter(std::ostream &target);
+    ~TextWriter(); // Vuelca lo pendiente
+
+    TextWriter(const TextWriter &) = delete;
+    TextWriter &operator=(const TextWriter &) = delete;
+
+    void Write(const char *text, size_t length);
+    void Write(const char *text);
+    void Put(char c)
+    {
+        if (used == BUFFER_SIZE)
+            Flush();
+        buffer[used++] = c;
+    }
+
+    void WriteUnsigned(uint64_t value);
+    // El número más corto (6 a 9 cifras significativas) que vuelve a dar exactamente value al
+    // leerlo como float. "-0" sale como "0". No finitos: nonFinite.
+    void WriteFloat(float value, const char *nonFinite = "0");
+
+    // Texto con los escapes de una cadena JSON (comillas incluidas)
+    void WriteJsonString(const char *text, size_t length);
+    void WriteJsonString(const std::string &text) { WriteJsonString(text.data(), text.size()); }
+    // Texto con los escapes de XML (&, <, >, comillas), para atributos y contenido
+    void WriteXmlText(const char *text, size_t length);
+    void WriteXmlText(const std::string &text) { WriteXmlText(text.data(), text.size()); }
+
+    void Flush();
+    bool IsGood() const { return static_cast<bool>(output); }
+};
@@ -0,0 +1,351 @@
+// ThumbnailGrid.cpp
+#include "ThumbnailGrid.h"
+#include <algorithm> // Para std::min y std::max
+#include <cmath>
+
+namespace
+{
+    const float LOD_PIXEL_TOLERANCE = 0.5f; // Error máximo de una miniatura simplificada, en píxeles
+}
+
+GridLayout GridLayout::ForFigureCount(size_t figureCount)
+{
+    GridLayout layout;
+    if (figureCount == 0)
+        return layout;
+
+    int totalFigures = static_cast<int>(figureCount);
+    layout.columns = (std::min)(GRID_MAX_COLUMNS, totalFigures);
+    layout.rows = (totalFigures + layout.columns - 1) / layout.columns; // Ceiling division
+    layout.rows = (std::min)(layout.rows, GRID_MAX_ROWS);
+    return layout;
+}
+
+size_t GridLayout::ClampFirstRow(size_t firstRow, size_t figureCount) const
+{
+    size_t totalRows = TotalRows(figureCount);
+    size_t lastFirstRow = totalRows > static_cast<size_t>(rows) ? totalRows - rows : 0;
+    return (std::min)(firstRow, lastFirstRow);
+}
+
+size_t GridLayout::ScrollToShow(size_t firstRow, size_t index) const
+{
+    size_t row = index / columns;
+    if (row < firstRow)
+        return row;
+    if (row >= firstRow + rows)
+        return row - rows + 1;
+    return firstRow;
+}
+
+size_t GridLayout::VisibleCount(size_t firstRow, size_t figureCount) const
+{
+    size_t first = FirstVisibleIndex(firstRow);
+    if (first >= figureCount)
+        return 0;
+    return (std::min)(PageSize(), figureCount - first);
+}
+
+ScaleTranslate2D GridLayout::FitToCell(size_t index, float minX, float minY, float maxX, float maxY) const
+{
+    int row = static_cast<int>(index) / columns;
+    int col = static_cast<int>(index) % columns;
+
+    float cellWidth = CellWidth();
+    float cellHeight = CellHeight();
+
+    // Calcular centro de la celda
+    float cellCenterX = areaLeft + (col + 0.5f) * cellWidth;
+    float cellCenterY = areaTop - (row + 0.5f) * cellHeight;
+
+    // Calcular escala para que quepa en la celda (con margen del 10%)
+    float scaleX = (cellWidth * 0.9f) / (maxX - minX);
+    float scaleY = (cellHeight * 0.9f) / (maxY - minY);
+    float scale = (std::min)(scaleX, scaleY);
+
+    // Si la figura es muy pequeña, usar escala 1:1 con límite superior
+    if (scale > 1.0f)
+        scale = 1.0f;
+
+    // Centrar en el origen, escalar y mover al centro de la celda
+    return Translate2D(cellCenterX, cellCenterY) *
+           Scale2D(scale, scale) *
+           Translate2D(-(minX + maxX) / 2.0f, -(minY + maxY) / 2.0f);
+}
+
+void GridLayout::GetCellRect(size_t index, float &left, float &top, float &right, float &bottom) const
+{
+    int row = static_cast<int>(index) / columns;
+    int col = static_cast<int>(index) % columns;
+    left = areaLeft + col * CellWidth();
+    right = left + CellWidth();
+    top = areaTop - row * CellHeight();
+    bottom = top - CellHeight();
+}
+
+ThumbnailGrid::ThumbnailGrid(IVertexBufferBackend &vertexBackend)
+    : backend(vertexBackend), buffer(vertexBackend.CreateBuffer()), firstRow(0), pageDamaged(true),
+      lodCache(nullptr), pixelSize(2.0f / 800.0f), uploadCount(0), cellUpdateCount(0)
+{
+}
+
+ThumbnailGrid::~ThumbnailGrid()
+{
+    backend.DestroyBuffer(buffer);
+}
+
+bool ThumbnailGrid::SamePage(const FigureListView &figures, const GridLayout &newLayout, size_t newFirstRow) const
+{
+    if (newLayout.columns != layout.columns || newLayout.rows != layout.rows || newFirstRow != firstRow)
+        return false;
+
+    size_t first = newLayout.FirstVisibleIndex(newFirstRow);
+    size_t count = newLayout.VisibleCount(newFirstRow, figures.Size());
+    if (count != states.size())
+        return false;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (figures.Get(first + i)->GetId() != states[i].figureId)
+            return false;
+    }
+    return true;
+}
+
+void ThumbnailGrid::ResetPage(const FigureListView &figures, const GridLayout &newLayout,
+                              size_t newFirstRow)
+{
+    // Todas las celdas de la página nueva se recalculan y se vuelven a subir
+    layout = newLayout;
+    firstRow = newFirstRow;
+    size_t firstIndex = layout.FirstVisibleIndex(firstRow);
+    size_t count = layout.VisibleCount(firstRow, figures.Size());
+
+    instances.assign(count, ThumbnailInstance());
+    states.resize(count);
+    damagedCells.assign(count, false);
+    pageDamaged = true;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Figure &figure = *figures.Get(firstIndex + i);
+        instances[i].figureId = figure.GetId();
+        instances[i].figureIndex = firstIndex + i;
+        states[i].figureId = figure.GetId();
+        InvalidateCell(i, figure);
+    }
+}
+
+void ThumbnailGrid::InvalidateCell(size_t index, const Figure &figure)
+{
+    FigureState &state = states[index];
+    state.pointsVersion = figure.GetPointsVersion();
+    state.version = figure.GetVersion() + 1; // Forzar el cálculo de la celda
+    state.lod.reset();
+    damagedCells[index] = true;
+}
+
+void ThumbnailGrid::UploadGeometry(const FigureListView &figures)
+{
+    // Las figuras visibles (o su versión simplificada), una detrás de otra, en un solo buffer
+    // de puntos sin transformar
+    size_t totalPoints = 0;
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        const auto &lod = states[i].lod;
+        totalPoints += lod ? lod->size() / 2 : figures.Get(instances[i].figureIndex)->GetPointCount();
+    }
+    uploadScratch.resize(totalPoints * 2);
+
+    size_t first = 0;
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        size_t count;
+        const auto &lod = states[i].lod;
+        if (lod)
+        {
+            count = lod->size() / 2;
+            std::copy(lod->begin(), lod->end(), uploadScratch.begin() + first * 2);
+        }
+        else
+        {
+            const Figure &figure = *figures.Get(instances[i].figureIndex);
+            count = figure.GetPointCount();
+            figure.WriteOpenGLVertices(uploadScratch.data() + first * 2);
+        }
+
+        instances[i].first = first;
+        instances[i].count = count;
+        first += count;
+    }
+
+    backend.UploadVertices(buffer, uploadScratch.data(), totalPoints);
+    uploadCount++;
+}
+
+void ThumbnailGrid::UpdateCell(size_t index, const Figure &figure)
+{
+    ThumbnailInstance &instance = instances[index];
+
+    // Tamaño de la figura (ya transformada) para escalar; Figure la mantiene incrementalmente
+    FigureBounds bounds = figure.GetTransformedBounds();
+    instance.cellTransform = layout.FitToCell(index, bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+    instance.model = instance.cellTransform.ToMatrix() * figure.GetTransform();
+
+    states[index].version = figure.GetVersion();
+    damagedCells[index] = true;
+    cellUpdateCount++;
+}
+
+int ThumbnailGrid::ChooseLodLevel(size_t index, const Figure &figure) const
+{
+    if (!lodCache || figure.GetPointCount() < LOD_MIN_POINTS)
+        return -1;
+
+    // Con perspectiva la escala cambia por zonas: mejor no simplificar
+    const TransformMatrix &model = instances[index].model;
+    if (model.m[2][0] != 0.0f || model.m[2][1] != 0.0f)
+        return -1;
+
+    // La norma de Frobenius de la parte lineal acota cuánto puede estirar el modelo una distancia
+    float stretch = std::sqrt(model.m[0][0] * model.m[0][0] + model.m[0][1] * model.m[0][1] +
+                              model.m[1][0] * model.m[1][0] + model.m[1][1] * model.m[1][1]);
+    if (stretch <= 0.0f)
+        return -1;
+    float allowed = pixelSize * LOD_PIXEL_TOLERANCE / stretch;
+
+    int level = LOD_LEVEL_COUNT - 1;
+    while (level >= 0 && PolylineLodCache::GetLevelTolerance(level) > allowed)
+        level--;
+    return level;
+}
+
+bool ThumbnailGrid::UpdateLods(const FigureListView &figures)
+{
+    // Todas las celdas visibles se buscan en la caché con un solo bloqueo
+    lodLookups.clear();
+    lodCells.clear();
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        const Figure &figure = *figures.Get(instances[i].figureIndex);
+        int level = ChooseLodLevel(i, figure);
+        if (level < 0)
+            continue;
+
+        PolylineLodCache::Lookup lookup;
+        lookup.figureId = figure.GetId();
+        lookup.pointsVersion = figure.GetPointsVersion();
+        lookup.level = level;
+        lodLookups.push_back(std::move(lookup));
+        lodCells.push_back(i);
+    }
+    if (!lodLookups.empty())
+        lodCache->FindMany(lodLookups);
+
+    bool changed = false;
+    size_t next = 0;
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        LodPoints points;
+        instances[i].lodLevel = -1;
+        if (next < lodCells.size() && lodCells[next] == i)
+        {
+            auto &lookup = lodLookups[next++];
+            if (!lookup.requested)
+            {
+                const Figure &figure = *figures.Get(instances[i].figureIndex);
+                lodScratch.resize(figure.GetPointCount() * 2);
+                figure.WriteOpenGLVertices(lodScratch.data());
+                lodCache->Request(lookup.figureId, lookup.pointsVersion, lodScratch.data(), figure.GetPointCount());
+            }
+            points = std::move(lookup.points);
+            if (points)
+                instances[i].lodLevel = lookup.level;
+        }
+
+        // El nivel depende de la escala de la celda; si cambia (o acaba de calcularse) se resube la página
+        if (points != states[i].lod)
+        {
+            states[i].lod = std::move(points);
+            damagedCells[i] = true;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void ThumbnailGrid::Update(const FigureListView &figures, size_t firstVisibleRow)
+{
+    GridLayout newLayout = GridLayout::ForFigureCount(figures.Size());
+    size_t newFirstRow = newLayout.ClampFirstRow(firstVisibleRow, figures.Size());
+
+    bool upload = false;
+    if (!SamePage(figures, newLayout, newFirstRow))
+    {
+        ResetPage(figures, newLayout, newFirstRow);
+        upload = true;
+    }
+
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        const Figure &figure = *figures.Get(instances[i].figureIndex);
+        // Misma página con puntos nuevos en una figura: solo se recalcula su celda
+        if (states[i].pointsVersion != figure.GetPointsVersion())
+        {
+            InvalidateCell(i, figure);
+            upload = true;
+        }
+        if (states[i].version != figure.GetVersion() && figure.GetPointCount() >= 2)
+            UpdateCell(i, figure);
+    }
+
+    if (UpdateLods(figures))
+        upload = true;
+
+    if (upload)
+        UploadGeometry(figures);
+}
+
+bool ThumbnailGrid::GetDamageRect(float &left, float &top, float &right, float &bottom) const
+{
+    if (pageDamaged)
+        return false;
+
+    bool any = false;
+    for (size_t i = 0; i < damagedCells.size(); ++i)
+    {
+        if (!damagedCells[i])
+            continue;
+
+        float cellLeft, cellTop, cellRight, cellBottom;
+        layout.GetCellRect(i, cellLeft, cellTop, cellRight, cellBottom);
+        left = any ? (std::min)(left, cellLeft) : cellLeft;
+        top = any ? (std::max)(top, cellTop) : cellTop;
+        right = any ? (std::max)(right, cellRight) : cellRight;
+        bottom = any ? (std::min)(bottom, cellBottom) : cellBottom;
+        any = true;
+    }
+    return any;
+}
+
+bool ThumbnailGrid::HasDamage() const
+{
+    return pageDamaged || std::find(damagedCells.begin(), damagedCells.end(), true) != damagedCells.end();
+}
+
+void ThumbnailGrid::ClearDamage()
+{
+    pageDamaged = false;
+    damagedCells.assign(damagedCells.size(), false);
+}
+
+void ThumbnailGrid::DrawLineStrip(const ThumbnailInstance &instance)
+{
+    if (instance.count >= 2)
+        backend.DrawBuffer(buffer, VertexPrimitive::LineStrip, instance.first, instance.count);
+}
+
+void ThumbnailGrid::DrawPoints(const ThumbnailInstance &instance)
+{
+    if (instance.count >= 2)
+        backend.DrawBuffer(buffer, VertexPrimitive::Points, instance.first, instance.count);
+}
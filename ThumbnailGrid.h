@@ -0,0 +1,134 @@
+// ThumbnailGrid.h - Virtualized figure grid: only the visible page, drawn as instances of one shared vertex buffer
+#pragma once
+#include "IVertexBufferBackend.h"
+#include "Figure.h"
+#include "FigureStore.h"
+#include "PolylineLodCache.h"
+#include "Transforms2D.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+const int GRID_MAX_COLUMNS = 3; // Máximo 3 figuras por fila
+const int GRID_MAX_ROWS = 3;    // Máximo 3 filas (9 figuras visibles)
+
+// Distribución del grid en coordenadas OpenGL (-1 a 1). Con más figuras de las que caben se
+// desplaza por filas: firstRow es la primera fila visible y todo se calcula en O(1).
+struct GridLayout
+{
+    float areaLeft = -0.9f;
+    float areaRight = 0.9f;
+    float areaTop = 0.9f;
+    float areaBottom = -0.9f;
+    int columns = 1;
+    int rows = 1;
+
+    static GridLayout ForFigureCount(size_t figureCount);
+
+    size_t PageSize() const { return static_cast<size_t>(columns) * rows; }
+    size_t TotalRows(size_t figureCount) const { return (figureCount + columns - 1) / columns; }
+    // Primera fila válida más cercana (la última página siempre va llena si hay figuras suficientes)
+    size_t ClampFirstRow(size_t firstRow, size_t figureCount) const;
+    // Fila en la que hay que empezar para que se vea la figura index, moviéndose lo mínimo desde firstRow
+    size_t ScrollToShow(size_t firstRow, size_t index) const;
+    size_t FirstVisibleIndex(size_t firstRow) const { return firstRow * columns; }
+    size_t VisibleCount(size_t firstRow, size_t figureCount) const;
+
+    float CellWidth() const { return (areaRight - areaLeft) / columns; }
+    float CellHeight() const { return (areaTop - areaBottom) / rows; }
+    // Rectángulo de la celda index (relativa a la página); FitToCell deja la figura dentro
+    void GetCellRect(size_t index, float &left, float &top, float &right, float &bottom) const;
+
+    // Lleva el rectángulo [minX, maxX] x [minY, maxY] al centro de la celda index (relativa a la página),
+    // escalado para ocupar el 90% de la celda como mucho (sin ampliar más de 1:1)
+    ScaleTranslate2D FitToCell(size_t index, float minX, float minY, float maxX, float maxY) const;
+};
+
+struct ThumbnailInstance
+{
+    uint64_t figureId = 0;
+    size_t figureIndex = 0; // Posición en la lista completa de figuras
+    size_t first = 0; // Rango de la figura dentro del buffer compartido
+    size_t count = 0;
+    int lodLevel = -1; // Nivel de PolylineLodCache subido, -1 = todos los puntos
+    ScaleTranslate2D cellTransform;
+    TransformMatrix model; // cellTransform * transformación de la figura
+};
+
+class ThumbnailGrid
+{
+private:
+    struct FigureState
+    {
+        uint64_t figureId;
+        uint64_t pointsVersion;
+        uint64_t version;
+        LodPoints lod; // Puntos simplificados subidos; vacío = los de la figura
+    };
+
+    IVertexBufferBackend &backend;
+    VertexBufferId buffer;
+    GridLayout layout;
+    size_t firstRow;
+    std::vector<ThumbnailInstance> instances; // Solo las celdas visibles
+    std::vector<FigureState> states;
+    // Lo que cambió en pantalla desde ClearDamage(): toda la página o algunas celdas
+    bool pageDamaged;
+    std::vector<bool> damagedCells;
+    std::vector<float> uploadScratch;
+    PolylineLodCache *lodCache;
+    float pixelSize;
+    std::vector<float> lodScratch;
+    std::vector<PolylineLodCache::Lookup> lodLookups; // Una por celda que puede simplificarse
+    std::vector<size_t> lodCells;                     // Celda de cada búsqueda
+    uint64_t uploadCount;
+    uint64_t cellUpdateCount;
+
+    bool SamePage(const FigureListView &figures, const GridLayout &newLayout, size_t newFirstRow) const;
+    void ResetPage(const FigureListView &figures, const GridLayout &newLayout,
+                   size_t newFirstRow);
+    void InvalidateCell(size_t index, const Figure &figure);
+    void UploadGeometry(const FigureListView &figures);
+    void UpdateCell(size_t index, const Figure &figure);
+    int ChooseLodLevel(size_t index, const Figure &figure) const; // -1 = todos los puntos
+    bool UpdateLods(const FigureListView &figures);
+
+public:
+    explicit ThumbnailGrid(IVertexBufferBackend &vertexBackend);
+    ~ThumbnailGrid();
+
+    ThumbnailGrid(const ThumbnailGrid &) = delete;
+    ThumbnailGrid &operator=(const ThumbnailGrid &) = delete;
+
+    // Con una caché, las figuras grandes se suben simplificadas según la escala de su celda: el nivel
+    // más simple cuyo error no pase de medio píxel. Mientras un nivel se calcula se sube la figura
+    // completa; el nivel se usa en el siguiente Update una vez listo, así que quien dibuja debe contar
+    // cache->GetCompletedVersion() en la versión de su escena. nullptr = siempre completas.
+    void SetLodCache(PolylineLodCache *cache) { lodCache = cache; }
+    // Tamaño de un píxel en coordenadas OpenGL (2 / lado mayor del viewport)
+    void SetPixelSize(float glUnitsPerPixel) { pixelSize = glUnitsPerPixel; }
+
+    // Sincroniza la página que empieza en firstVisibleRow (se ajusta a un valor válido) con la lista de
+    // figuras. Solo se miran las figuras visibles: los vértices de la página se vuelven a subir si
+    // cambió la página, la distribución, los puntos o el nivel de detalle de alguna figura visible, y una celda se
+    // recalcula solo si cambió la versión de su figura. El coste es O(celdas visibles), sin importar
+    // cuántas figuras haya en la lista. Todos los elementos de figures deben existir.
+    void Update(const FigureListView &figures, size_t firstVisibleRow = 0);
+
+    // Redibujo parcial: rectángulo (coordenadas OpenGL) que cubre las celdas que cambiaron desde el
+    // último ClearDamage(). false si no hay nada o si cambió la página entera (desplazamiento,
+    // distribución o lista de figuras): entonces hay que redibujar todo.
+    bool GetDamageRect(float &left, float &top, float &right, float &bottom) const;
+    bool HasDamage() const;
+    void ClearDamage();
+
+    const std::vector<ThumbnailInstance> &GetInstances() const { return instances; }
+    const GridLayout &GetLayout() const { return layout; }
+    size_t GetFirstRow() const { return firstRow; }
+
+    void DrawLineStrip(const ThumbnailInstance &instance);
+    void DrawPoints(const ThumbnailInstance &instance);
+
+    uint64_t GetUploadCount() const { return uploadCount; }
+    uint64_t GetCellUpdateCount() const { return cellUpdateCount; }
+};
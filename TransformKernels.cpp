@@ -0,0 +1,583 @@
+// TransformKernels.cpp
+#include "TransformKernels.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORM_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(TRANSFORM_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TRANSFORM_TARGET_SSE2 __attribute__((target("sse2")))
+#define TRANSFORM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TRANSFORM_TARGET_SSE2
+#define TRANSFORM_TARGET_AVX2
+#endif
+
+// Los kernels SIMD leen el array como floats x, y, w consecutivos
+static_assert(sizeof(HomogenVector) == 3 * sizeof(float), "HomogenVector must be tightly packed");
+
+namespace
+{
+    // Múltiplo del bloque más ancho (AVX2 = 8 puntos) para que el reparto no cambie el resultado
+    const size_t PARALLEL_CHUNK_ALIGNMENT = 64;
+
+    std::atomic<size_t> parallelThreshold(DEFAULT_PARALLEL_TRANSFORM_THRESHOLD);
+
+    // Los kernels son plantillas sobre el tipo de matriz: el switch se resuelve al compilar y el
+    // bucle interno no tiene ramas. Mismo orden de operaciones en todos: (a*x + b*y) + c*w
+    template <TransformKind Kind>
+    void TransformScalar(const TransformMatrix &t, const HomogenVector *in, HomogenVector *out, size_t count)
+    {
+        // Coeficientes en locales: out puede solapar con t y, leídos por referencia, se recargarían
+        // de memoria en cada punto
+        const float m00 = t.m[0][0], m01 = t.m[0][1], m02 = t.m[0][2];
+        const float m10 = t.m[1][0], m11 = t.m[1][1], m12 = t.m[1][2];
+        switch (Kind)
+        {
+        case TransformKind::Translation:
+            for (size_t i = 0; i < count; ++i)
+            {
+                float x = in[i].x, y = in[i].y, w = in[i].w;
+                out[i].x = x + m02 * w;
+                out[i].y = y + m12 * w;
+                out[i].w = w;
+            }
+            break;
+
+        case TransformKind::AxisAligned:
+            for (size_t i = 0; i < count; ++i)
+            {
+                float x = in[i].x, y = in[i].y, w = in[i].w;
+                out[i].x = m00 * x + m02 * w;
+                out[i].y = m11 * y + m12 * w;
+                out[i].w = w;
+            }
+            break;
+
+        case TransformKind::Affine:
+            for (size_t i = 0; i < count; ++i)
+            {
+                float x = in[i].x, y = in[i].y, w = in[i].w;
+                out[i].x = m00 * x + m01 * y + m02 * w;
+                out[i].y = m10 * x + m11 * y + m12 * w;
+                out[i].w = w;
+            }
+            break;
+
+        case TransformKind::Projective:
+        {
+            const TransformMatrix local = t;
+            for (size_t i = 0; i < count; ++i)
+                out[i] = local.Apply(in[i]);
+            break;
+        }
+        }
+    }
+
+    template <TransformKind Kind>
+    void TransformColumnsScalar(const TransformMatrix &t, const float *xs, const float *ys, const float *ws,
+                                float *outX, float *outY, size_t count)
+    {
+        const float m00 = t.m[0][0], m01 = t.m[0][1], m02 = t.m[0][2];
+        const float m10 = t.m[1][0], m11 = t.m[1][1], m12 = t.m[1][2];
+        for (size_t i = 0; i < count; ++i)
+        {
+            float x = xs[i], y = ys[i], w = ws ? ws[i] : 1.0f;
+            switch (Kind)
+            {
+            case TransformKind::Translation:
+                outX[i] = x + m02 * w;
+                outY[i] = y + m12 * w;
+                break;
+            case TransformKind::AxisAligned:
+                outX[i] = m00 * x + m02 * w;
+                outY[i] = m11 * y + m12 * w;
+                break;
+            default:
+                outX[i] = m00 * x + m01 * y + m02 * w;
+                outY[i] = m10 * x + m11 * y + m12 * w;
+                break;
+            }
+        }
+    }
+
+    void TransformColumnsProjective(const TransformMatrix &t, const float *xs, const float *ys, const float *ws,
+                                    float *outX, float *outY, float *outW, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            HomogenVector point = t.Apply(HomogenVector(xs[i], ys[i], ws ? ws[i] : 1.0f));
+            if (outW)
+            {
+                outX[i] = point.x;
+                outY[i] = point.y;
+                outW[i] = point.w;
+            }
+            else
+            {
+                point.ToOpenGL(outX[i], outY[i]);
+            }
+        }
+    }
+
+#ifdef TRANSFORM_KERNELS_X86
+
+// _mm_shuffle_ps con los índices en orden de carril (0..3)
+#define LANES(i0, i1, i2, i3) _MM_SHUFFLE(i3, i2, i1, i0)
+
+    // 4 puntos entrelazados [x0 y0 w0 x1][y1 w1 x2 y2][w2 x3 y3 w3] -> columnas X, Y, W
+    TRANSFORM_TARGET_SSE2 inline void Deinterleave4(__m128 v0, __m128 v1, __m128 v2, __m128 &X, __m128 &Y, __m128 &W)
+    {
+        X = _mm_shuffle_ps(_mm_shuffle_ps(v0, v0, LANES(0, 3, 0, 3)), _mm_shuffle_ps(v1, v2, LANES(2, 2, 1, 1)), LANES(0, 1, 0, 2));
+        Y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, LANES(1, 1, 0, 0)), _mm_shuffle_ps(v1, v2, LANES(3, 3, 2, 2)), LANES(0, 2, 0, 2));
+        W = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, LANES(2, 2, 1, 1)), _mm_shuffle_ps(v2, v2, LANES(0, 0, 3, 3)), LANES(0, 2, 0, 2));
+    }
+
+    TRANSFORM_TARGET_SSE2 inline void Interleave4(__m128 X, __m128 Y, __m128 W, __m128 &o0, __m128 &o1, __m128 &o2)
+    {
+        o0 = _mm_shuffle_ps(_mm_shuffle_ps(X, Y, LANES(0, 0, 0, 0)), _mm_shuffle_ps(W, X, LANES(0, 0, 1, 1)), LANES(0, 2, 0, 2));
+        o1 = _mm_shuffle_ps(_mm_shuffle_ps(Y, W, LANES(1, 1, 1, 1)), _mm_shuffle_ps(X, Y, LANES(2, 2, 2, 2)), LANES(0, 2, 0, 2));
+        o2 = _mm_shuffle_ps(_mm_shuffle_ps(W, X, LANES(2, 2, 3, 3)), _mm_shuffle_ps(Y, W, LANES(3, 3, 3, 3)), LANES(0, 2, 0, 2));
+    }
+
+    template <TransformKind Kind>
+    TRANSFORM_TARGET_SSE2 void TransformSSE2(const TransformMatrix &t, const HomogenVector *in, HomogenVector *out, size_t count)
+    {
+        const auto &m = t.m;
+        const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+        const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+
+        const float *src = reinterpret_cast<const float *>(in);
+        float *dst = reinterpret_cast<float *>(out);
+        const size_t blocks = count / 4;
+
+        for (size_t b = 0; b < blocks; ++b, src += 12, dst += 12)
+        {
+            __m128 X, Y, W;
+            Deinterleave4(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), X, Y, W);
+
+            __m128 nX, nY;
+            switch (Kind)
+            {
+            case TransformKind::Translation:
+                nX = _mm_add_ps(X, _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(Y, _mm_mul_ps(m12, W));
+                break;
+            case TransformKind::AxisAligned:
+                nX = _mm_add_ps(_mm_mul_ps(m00, X), _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(_mm_mul_ps(m11, Y), _mm_mul_ps(m12, W));
+                break;
+            default:
+                nX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, X), _mm_mul_ps(m01, Y)), _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, X), _mm_mul_ps(m11, Y)), _mm_mul_ps(m12, W));
+                break;
+            }
+
+            __m128 o0, o1, o2;
+            Interleave4(nX, nY, W, o0, o1, o2);
+            _mm_storeu_ps(dst, o0);
+            _mm_storeu_ps(dst + 4, o1);
+            _mm_storeu_ps(dst + 8, o2);
+        }
+
+        size_t done = blocks * 4;
+        TransformScalar<Kind>(t, in + done, out + done, count - done);
+    }
+
+    // Cada carril de 128 bits contiene un bloque de 4 puntos; _mm256_shuffle_ps opera por carril
+    TRANSFORM_TARGET_AVX2 inline __m256 Load2x4(const float *lo, const float *hi)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+    }
+
+    TRANSFORM_TARGET_AVX2 inline void Store2x4(float *lo, float *hi, __m256 v)
+    {
+        _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+        _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+    }
+
+    template <TransformKind Kind>
+    TRANSFORM_TARGET_AVX2 void TransformAVX2(const TransformMatrix &t, const HomogenVector *in, HomogenVector *out, size_t count)
+    {
+        const auto &m = t.m;
+        const __m256 m00 = _mm256_set1_ps(m[0][0]), m01 = _mm256_set1_ps(m[0][1]), m02 = _mm256_set1_ps(m[0][2]);
+        const __m256 m10 = _mm256_set1_ps(m[1][0]), m11 = _mm256_set1_ps(m[1][1]), m12 = _mm256_set1_ps(m[1][2]);
+
+        const float *src = reinterpret_cast<const float *>(in);
+        float *dst = reinterpret_cast<float *>(out);
+        const size_t blocks = count / 8;
+
+        for (size_t b = 0; b < blocks; ++b, src += 24, dst += 24)
+        {
+            __m256 v0 = Load2x4(src, src + 12);
+            __m256 v1 = Load2x4(src + 4, src + 16);
+            __m256 v2 = Load2x4(src + 8, src + 20);
+
+            __m256 X = _mm256_shuffle_ps(_mm256_shuffle_ps(v0, v0, LANES(0, 3, 0, 3)), _mm256_shuffle_ps(v1, v2, LANES(2, 2, 1, 1)), LANES(0, 1, 0, 2));
+            __m256 Y = _mm256_shuffle_ps(_mm256_shuffle_ps(v0, v1, LANES(1, 1, 0, 0)), _mm256_shuffle_ps(v1, v2, LANES(3, 3, 2, 2)), LANES(0, 2, 0, 2));
+            __m256 W = _mm256_shuffle_ps(_mm256_shuffle_ps(v0, v1, LANES(2, 2, 1, 1)), _mm256_shuffle_ps(v2, v2, LANES(0, 0, 3, 3)), LANES(0, 2, 0, 2));
+
+            __m256 nX, nY;
+            switch (Kind)
+            {
+            case TransformKind::Translation:
+                nX = _mm256_add_ps(X, _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(Y, _mm256_mul_ps(m12, W));
+                break;
+            case TransformKind::AxisAligned:
+                nX = _mm256_add_ps(_mm256_mul_ps(m00, X), _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(_mm256_mul_ps(m11, Y), _mm256_mul_ps(m12, W));
+                break;
+            default:
+                nX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, X), _mm256_mul_ps(m01, Y)), _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, X), _mm256_mul_ps(m11, Y)), _mm256_mul_ps(m12, W));
+                break;
+            }
+
+            __m256 o0 = _mm256_shuffle_ps(_mm256_shuffle_ps(nX, nY, LANES(0, 0, 0, 0)), _mm256_shuffle_ps(W, nX, LANES(0, 0, 1, 1)), LANES(0, 2, 0, 2));
+            __m256 o1 = _mm256_shuffle_ps(_mm256_shuffle_ps(nY, W, LANES(1, 1, 1, 1)), _mm256_shuffle_ps(nX, nY, LANES(2, 2, 2, 2)), LANES(0, 2, 0, 2));
+            __m256 o2 = _mm256_shuffle_ps(_mm256_shuffle_ps(W, nX, LANES(2, 2, 3, 3)), _mm256_shuffle_ps(nY, W, LANES(3, 3, 3, 3)), LANES(0, 2, 0, 2));
+
+            Store2x4(dst, dst + 12, o0);
+            Store2x4(dst + 4, dst + 16, o1);
+            Store2x4(dst + 8, dst + 20, o2);
+        }
+
+        size_t done = blocks * 8;
+        TransformSSE2<Kind>(t, in + done, out + done, count - done);
+    }
+
+    // Por columnas no hace falta reordenar: cada carga trae 4 (u 8) coordenadas de la misma columna
+    template <TransformKind Kind>
+    TRANSFORM_TARGET_SSE2 void TransformColumnsSSE2(const TransformMatrix &t, const float *xs, const float *ys, const float *ws,
+                                                    float *outX, float *outY, size_t count)
+    {
+        const auto &m = t.m;
+        const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+        const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 X = _mm_loadu_ps(xs + i);
+            __m128 Y = _mm_loadu_ps(ys + i);
+            __m128 W = ws ? _mm_loadu_ps(ws + i) : one;
+
+            __m128 nX, nY;
+            switch (Kind)
+            {
+            case TransformKind::Translation:
+                nX = _mm_add_ps(X, _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(Y, _mm_mul_ps(m12, W));
+                break;
+            case TransformKind::AxisAligned:
+                nX = _mm_add_ps(_mm_mul_ps(m00, X), _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(_mm_mul_ps(m11, Y), _mm_mul_ps(m12, W));
+                break;
+            default:
+                nX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, X), _mm_mul_ps(m01, Y)), _mm_mul_ps(m02, W));
+                nY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, X), _mm_mul_ps(m11, Y)), _mm_mul_ps(m12, W));
+                break;
+            }
+            _mm_storeu_ps(outX + i, nX);
+            _mm_storeu_ps(outY + i, nY);
+        }
+
+        TransformColumnsScalar<Kind>(t, xs + i, ys + i, ws ? ws + i : nullptr, outX + i, outY + i, count - i);
+    }
+
+    template <TransformKind Kind>
+    TRANSFORM_TARGET_AVX2 void TransformColumnsAVX2(const TransformMatrix &t, const float *xs, const float *ys, const float *ws,
+                                                    float *outX, float *outY, size_t count)
+    {
+        const auto &m = t.m;
+        const __m256 m00 = _mm256_set1_ps(m[0][0]), m01 = _mm256_set1_ps(m[0][1]), m02 = _mm256_set1_ps(m[0][2]);
+        const __m256 m10 = _mm256_set1_ps(m[1][0]), m11 = _mm256_set1_ps(m[1][1]), m12 = _mm256_set1_ps(m[1][2]);
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 X = _mm256_loadu_ps(xs + i);
+            __m256 Y = _mm256_loadu_ps(ys + i);
+            __m256 W = ws ? _mm256_loadu_ps(ws + i) : one;
+
+            __m256 nX, nY;
+            switch (Kind)
+            {
+            case TransformKind::Translation:
+                nX = _mm256_add_ps(X, _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(Y, _mm256_mul_ps(m12, W));
+                break;
+            case TransformKind::AxisAligned:
+                nX = _mm256_add_ps(_mm256_mul_ps(m00, X), _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(_mm256_mul_ps(m11, Y), _mm256_mul_ps(m12, W));
+                break;
+            default:
+                nX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, X), _mm256_mul_ps(m01, Y)), _mm256_mul_ps(m02, W));
+                nY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, X), _mm256_mul_ps(m11, Y)), _mm256_mul_ps(m12, W));
+                break;
+            }
+            _mm256_storeu_ps(outX + i, nX);
+            _mm256_storeu_ps(outY + i, nY);
+        }
+
+        TransformColumnsSSE2<Kind>(t, xs + i, ys + i, ws ? ws + i : nullptr, outX + i, outY + i, count - i);
+    }
+
+#undef LANES
+
+    bool CpuHasSSE2()
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+
+    bool CpuHasAVX2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx)
+            return false;
+
+        // El sistema operativo debe guardar los registros YMM
+        if ((_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+#endif // TRANSFORM_KERNELS_X86
+
+    template <TransformKind Kind>
+    void TransformWithKernel(TransformKernel kernel, const TransformMatrix &t, const HomogenVector *in, HomogenVector *out, size_t count)
+    {
+        switch (kernel)
+        {
+#ifdef TRANSFORM_KERNELS_X86
+        case TransformKernel::AVX2:
+            TransformAVX2<Kind>(t, in, out, count);
+            break;
+        case TransformKernel::SSE2:
+            TransformSSE2<Kind>(t, in, out, count);
+            break;
+#endif
+        default:
+            TransformScalar<Kind>(t, in, out, count);
+            break;
+        }
+    }
+
+    template <TransformKind Kind>
+    void TransformColumnsWithKernel(TransformKernel kernel, const TransformMatrix &t, const float *xs, const float *ys, const float *ws,
+                                    float *outX, float *outY, size_t count)
+    {
+        switch (kernel)
+        {
+#ifdef TRANSFORM_KERNELS_X86
+        case TransformKernel::AVX2:
+            TransformColumnsAVX2<Kind>(t, xs, ys, ws, outX, outY, count);
+            break;
+        case TransformKernel::SSE2:
+            TransformColumnsSSE2<Kind>(t, xs, ys, ws, outX, outY, count);
+            break;
+#endif
+        default:
+            TransformColumnsScalar<Kind>(t, xs, ys, ws, outX, outY, count);
+            break;
+        }
+    }
+
+    TransformKernel DetectTransformKernel()
+    {
+#ifdef TRANSFORM_KERNELS_X86
+        if (CpuHasAVX2())
+            return TransformKernel::AVX2;
+        if (CpuHasSSE2())
+            return TransformKernel::SSE2;
+#endif
+        return TransformKernel::Scalar;
+    }
+}
+
+TransformKernel GetActiveTransformKernel()
+{
+    static const TransformKernel active = DetectTransformKernel();
+    return active;
+}
+
+bool IsTransformKernelSupported(TransformKernel kernel)
+{
+    return static_cast<int>(kernel) <= static_cast<int>(GetActiveTransformKernel());
+}
+
+const char *GetTransformKernelName(TransformKernel kernel)
+{
+    switch (kernel)
+    {
+    case TransformKernel::SSE2:
+        return "SSE2";
+    case TransformKernel::AVX2:
+        return "AVX2";
+    default:
+        return "Scalar";
+    }
+}
+
+void TransformPoints(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count)
+{
+    TransformPoints(matrix, matrix.GetKind(), in, out, count, GetActiveTransformKernel());
+}
+
+void TransformPoints(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count, TransformKernel kernel)
+{
+    TransformPoints(matrix, matrix.GetKind(), in, out, count, kernel);
+}
+
+void TransformPoints(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count)
+{
+    TransformPoints(matrix, kind, in, out, count, GetActiveTransformKernel());
+}
+
+void TransformPoints(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count,
+                     TransformKernel kernel)
+{
+    if (count == 0)
+        return;
+
+    if (!IsTransformKernelSupported(kernel))
+        kernel = TransformKernel::Scalar;
+
+    switch (kind)
+    {
+    case TransformKind::Translation:
+        TransformWithKernel<TransformKind::Translation>(kernel, matrix, in, out, count);
+        break;
+    case TransformKind::AxisAligned:
+        TransformWithKernel<TransformKind::AxisAligned>(kernel, matrix, in, out, count);
+        break;
+    case TransformKind::Affine:
+        TransformWithKernel<TransformKind::Affine>(kernel, matrix, in, out, count);
+        break;
+    case TransformKind::Projective:
+        TransformScalar<TransformKind::Projective>(matrix, in, out, count);
+        break;
+    }
+}
+
+void TransformPoints(const TransformMatrix &matrix, PointList &points)
+{
+    TransformPoints(matrix, points.data(), points.data(), points.size());
+}
+
+void TransformColumns(const TransformMatrix &matrix, const float *xs, const float *ys, const float *ws,
+                      float *outX, float *outY, float *outW, size_t count)
+{
+    TransformColumns(matrix, matrix.GetKind(), xs, ys, ws, outX, outY, outW, count);
+}
+
+void TransformColumns(const TransformMatrix &matrix, TransformKind kind, const float *xs, const float *ys, const float *ws,
+                      float *outX, float *outY, float *outW, size_t count)
+{
+    if (count == 0)
+        return;
+
+    TransformKernel kernel = GetActiveTransformKernel();
+    switch (kind)
+    {
+    case TransformKind::Projective:
+        TransformColumnsProjective(matrix, xs, ys, ws, outX, outY, outW, count);
+        return;
+    case TransformKind::Translation:
+        TransformColumnsWithKernel<TransformKind::Translation>(kernel, matrix, xs, ys, ws, outX, outY, count);
+        break;
+    case TransformKind::AxisAligned:
+        TransformColumnsWithKernel<TransformKind::AxisAligned>(kernel, matrix, xs, ys, ws, outX, outY, count);
+        break;
+    case TransformKind::Affine:
+        TransformColumnsWithKernel<TransformKind::Affine>(kernel, matrix, xs, ys, ws, outX, outY, count);
+        break;
+    }
+
+    // Afín: w' = w
+    if (outW && outW != ws)
+    {
+        if (ws)
+            std::copy(ws, ws + count, outW);
+        else
+            std::fill(outW, outW + count, 1.0f);
+    }
+}
+
+void SetParallelTransformThreshold(size_t pointCount)
+{
+    parallelThreshold = pointCount;
+}
+
+size_t GetParallelTransformThreshold()
+{
+    return parallelThreshold;
+}
+
+void TransformPointsParallel(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count)
+{
+    TransformPointsParallel(matrix, matrix.GetKind(), in, out, count);
+}
+
+void TransformPointsParallel(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count)
+{
+    if (count < parallelThreshold)
+    {
+        TransformPoints(matrix, kind, in, out, count);
+        return;
+    }
+
+    ParallelFor(count, PARALLEL_CHUNK_ALIGNMENT, [&](size_t begin, size_t end)
+                { TransformPoints(matrix, kind, in + begin, out + begin, end - begin); });
+}
+
+void TransformColumnsParallel(const TransformMatrix &matrix, const float *xs, const float *ys, const float *ws,
+                              float *outX, float *outY, float *outW, size_t count)
+{
+    TransformColumnsParallel(matrix, matrix.GetKind(), xs, ys, ws, outX, outY, outW, count);
+}
+
+void TransformColumnsParallel(const TransformMatrix &matrix, TransformKind kind, const float *xs, const float *ys, const float *ws,
+                              float *outX, float *outY, float *outW, size_t count)
+{
+    if (count < parallelThreshold)
+    {
+        TransformColumns(matrix, kind, xs, ys, ws, outX, outY, outW, count);
+        return;
+    }
+
+    ParallelFor(count, PARALLEL_CHUNK_ALIGNMENT, [&](size_t begin, size_t end)
+                { TransformColumns(matrix, kind, xs + begin, ys + begin, ws ? ws + begin : nullptr,
+                                   outX + begin, outY + begin, outW ? outW + begin : nullptr, end - begin); });
+}
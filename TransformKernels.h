@@ -0,0 +1,60 @@
+// TransformKernels.h - Batch transformation of HomogenVector arrays (scalar / SSE2 / AVX2)
+#pragma once
+#include "HomogenVector.h"
+#include "PointPool.h"
+#include "TransformMatrix.h"
+#include <cstddef>
+#include <vector>
+
+enum class TransformKernel
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Mejor kernel soportado por la CPU actual (se detecta una sola vez)
+TransformKernel GetActiveTransformKernel();
+bool IsTransformKernelSupported(TransformKernel kernel);
+const char *GetTransformKernelName(TransformKernel kernel);
+
+// out[i] = matrix * in[i] para count puntos. in y out pueden ser el mismo buffer.
+// Las traslaciones puras y las escalas sin rotación usan un camino reducido.
+void TransformPoints(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count);
+
+// Igual que el anterior pero forzando un kernel (si no está soportado se usa el escalar)
+void TransformPoints(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count, TransformKernel kernel);
+
+// Igual, con la forma de la matriz ya conocida (por ejemplo la de un tipo de Transforms2D): no se
+// clasifica la matriz. kind no puede ser más estrecho que matrix.GetKind().
+void TransformPoints(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count);
+void TransformPoints(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count,
+                     TransformKernel kernel);
+
+// Transforma points en su lugar
+void TransformPoints(const TransformMatrix &matrix, PointList &points);
+
+// A partir de este número de puntos TransformPointsParallel reparte el trabajo entre hilos
+const size_t DEFAULT_PARALLEL_TRANSFORM_THRESHOLD = 256 * 1024;
+void SetParallelTransformThreshold(size_t pointCount);
+size_t GetParallelTransformThreshold();
+
+// Igual que TransformPoints pero en paralelo para arrays grandes. El resultado es idéntico
+// bit a bit al de la versión serie: los trozos empiezan en múltiplos del bloque SIMD.
+void TransformPointsParallel(const TransformMatrix &matrix, const HomogenVector *in, HomogenVector *out, size_t count);
+void TransformPointsParallel(const TransformMatrix &matrix, TransformKind kind, const HomogenVector *in, HomogenVector *out, size_t count);
+
+// Versión por columnas (SoA): ws puede ser nullptr (w == 1) y outW recibe w', como en
+// TransformPoints. Con una matriz afín w no cambia: outW puede ser nullptr (si no, se le copia ws
+// o se llena con 1). Con una proyectiva cada punto pasa por TransformMatrix::Apply; si outW es
+// nullptr se escriben x'/w' e y'/w' (el mismo punto con w = 1). Las salidas pueden coincidir con
+// las entradas.
+void TransformColumns(const TransformMatrix &matrix, const float *xs, const float *ys, const float *ws,
+                      float *outX, float *outY, float *outW, size_t count);
+void TransformColumns(const TransformMatrix &matrix, TransformKind kind, const float *xs, const float *ys, const float *ws,
+                      float *outX, float *outY, float *outW, size_t count);
+
+void TransformColumnsParallel(const TransformMatrix &matrix, const float *xs, const float *ys, const float *ws,
+                              float *outX, float *outY, float *outW, size_t count);
+void TransformColumnsParallel(const TransformMatrix &matrix, TransformKind kind, const float *xs, const float *ys, const float *ws,
+                              float *outX, float *outY, float *outW, size_t count);
@@ -0,0 +1,132 @@
+// TransformMatrix.h - 3x3 homogeneous matrix for composing 2D transformations
+#pragma once
+#include "HomogenVector.h"
+#include <cmath>
+
+// Forma de una matriz, de más estrecha a más general. Un tipo más general también sirve para las
+// más estrechas, así que componer dos transformaciones da el mayor de los dos.
+enum class TransformKind
+{
+    Translation, // parte lineal identidad: x' = x + tx*w
+    AxisAligned, // escala + traslación: x' = sx*x + tx*w
+    Affine,      // fila inferior (0, 0, 1): w' = w
+    Projective
+};
+
+inline TransformKind WidestTransformKind(TransformKind a, TransformKind b)
+{
+    return static_cast<int>(a) > static_cast<int>(b) ? a : b;
+}
+
+struct TransformMatrix
+{
+    float m[3][3] = {
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}};
+
+    static TransformMatrix Identity()
+    {
+        return TransformMatrix();
+    }
+
+    static TransformMatrix Translation(float tx, float ty)
+    {
+        TransformMatrix t;
+        t.m[0][2] = tx;
+        t.m[1][2] = ty;
+        return t;
+    }
+
+    static TransformMatrix Scaling(float sx, float sy)
+    {
+        TransformMatrix t;
+        t.m[0][0] = sx;
+        t.m[1][1] = sy;
+        return t;
+    }
+
+    // Rotación en grados, sentido antihorario
+    static TransformMatrix Rotation(float degrees)
+    {
+        const double PI = 3.14159265358979323846;
+        float angle = static_cast<float>(degrees * PI / 180.0);
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+
+        TransformMatrix t;
+        t.m[0][0] = c;
+        t.m[0][1] = -s;
+        t.m[1][0] = s;
+        t.m[1][1] = c;
+        return t;
+    }
+
+    // this * rhs: aplica primero rhs y después this
+    TransformMatrix operator*(const TransformMatrix &rhs) const
+    {
+        TransformMatrix r;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                r.m[i][j] = m[i][0] * rhs.m[0][j] + m[i][1] * rhs.m[1][j] + m[i][2] * rhs.m[2][j];
+            }
+        }
+        return r;
+    }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        HomogenVector r;
+        r.x = m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.w;
+        r.y = m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.w;
+        r.w = m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.w;
+        return r;
+    }
+
+    // Matriz 4x4 en orden de columnas para glLoadMatrixf/glMultMatrixf (z queda intacta)
+    void ToColumnMajor4x4(float out[16]) const
+    {
+        out[0] = m[0][0];
+        out[1] = m[1][0];
+        out[2] = 0.0f;
+        out[3] = m[2][0];
+        out[4] = m[0][1];
+        out[5] = m[1][1];
+        out[6] = 0.0f;
+        out[7] = m[2][1];
+        out[8] = 0.0f;
+        out[9] = 0.0f;
+        out[10] = 1.0f;
+        out[11] = 0.0f;
+        out[12] = m[0][2];
+        out[13] = m[1][2];
+        out[14] = 0.0f;
+        out[15] = m[2][2];
+    }
+
+    // Fila inferior (0, 0, 1): w no cambia
+    bool IsAffine() const
+    {
+        return m[2][0] == 0.0f && m[2][1] == 0.0f && m[2][2] == 1.0f;
+    }
+
+    TransformKind GetKind() const
+    {
+        if (!IsAffine())
+            return TransformKind::Projective;
+        if (m[0][1] != 0.0f || m[1][0] != 0.0f)
+            return TransformKind::Affine;
+        if (m[0][0] == 1.0f && m[1][1] == 1.0f)
+            return TransformKind::Translation;
+        return TransformKind::AxisAligned;
+    }
+
+    bool IsIdentity() const
+    {
+        return m[0][0] == 1.0f && m[0][1] == 0.0f && m[0][2] == 0.0f &&
+               m[1][0] == 0.0f && m[1][1] == 1.0f && m[1][2] == 0.0f &&
+               m[2][0] == 0.0f && m[2][1] == 0.0f && m[2][2] == 1.0f;
+    }
+};
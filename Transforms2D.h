@@ -0,0 +1,253 @@
+// Transforms2D.h - 2D transformations with their kind encoded in the type
+//
+// Cada tipo guarda solo los coeficientes que necesita y su Apply() hace el mínimo de operaciones:
+//   Translate2D       x' = x + tx*w
+//   Scale2D           x' = sx*x
+//   ScaleTranslate2D  x' = sx*x + tx*w
+//   Rotate2D          x' = c*x - s*y
+//   Affine2D          x' = a*x + b*y + tx*w
+// Componer (a * b: primero b, después a) devuelve el tipo más estrecho que representa el resultado.
+// Kind() dice a los kernels por lotes (TransformKernels.h) qué camino usar sin mirar la matriz:
+// Figure::ApplyTransform lo acumula junto con la matriz y lo pasa en cada transformación.
+#pragma once
+#include "HomogenVector.h"
+#include "TransformMatrix.h"
+#include <cmath>
+#include <type_traits>
+
+struct Translate2D
+{
+    float tx = 0.0f, ty = 0.0f;
+
+    Translate2D() = default;
+    Translate2D(float x, float y) : tx(x), ty(y) {}
+
+    static TransformKind Kind() { return TransformKind::Translation; }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        return HomogenVector(p.x + tx * p.w, p.y + ty * p.w, p.w);
+    }
+
+    Translate2D Inverse() const { return Translate2D(-tx, -ty); }
+
+    TransformMatrix ToMatrix() const { return TransformMatrix::Translation(tx, ty); }
+};
+
+struct Scale2D
+{
+    float sx = 1.0f, sy = 1.0f;
+
+    Scale2D() = default;
+    Scale2D(float x, float y) : sx(x), sy(y) {}
+
+    static TransformKind Kind() { return TransformKind::AxisAligned; }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        return HomogenVector(sx * p.x, sy * p.y, p.w);
+    }
+
+    TransformMatrix ToMatrix() const { return TransformMatrix::Scaling(sx, sy); }
+};
+
+struct ScaleTranslate2D
+{
+    float sx = 1.0f, sy = 1.0f;
+    float tx = 0.0f, ty = 0.0f;
+
+    ScaleTranslate2D() = default;
+    ScaleTranslate2D(float scaleX, float scaleY, float x, float y) : sx(scaleX), sy(scaleY), tx(x), ty(y) {}
+    ScaleTranslate2D(const Translate2D &t) : tx(t.tx), ty(t.ty) {}
+    ScaleTranslate2D(const Scale2D &s) : sx(s.sx), sy(s.sy) {}
+
+    static TransformKind Kind() { return TransformKind::AxisAligned; }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        return HomogenVector(sx * p.x + tx * p.w, sy * p.y + ty * p.w, p.w);
+    }
+
+    TransformMatrix ToMatrix() const
+    {
+        TransformMatrix m = TransformMatrix::Scaling(sx, sy);
+        m.m[0][2] = tx;
+        m.m[1][2] = ty;
+        return m;
+    }
+};
+
+struct Rotate2D
+{
+    float c = 1.0f, s = 0.0f; // coseno y seno del ángulo
+
+    Rotate2D() = default;
+
+    // Rotación en grados, sentido antihorario (misma convención que TransformMatrix::Rotation)
+    static Rotate2D FromDegrees(float degrees)
+    {
+        const double PI = 3.14159265358979323846;
+        float angle = static_cast<float>(degrees * PI / 180.0);
+        Rotate2D r;
+        r.c = std::cos(angle);
+        r.s = std::sin(angle);
+        return r;
+    }
+
+    static TransformKind Kind() { return TransformKind::Affine; }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        return HomogenVector(c * p.x - s * p.y, s * p.x + c * p.y, p.w);
+    }
+
+    TransformMatrix ToMatrix() const
+    {
+        TransformMatrix m;
+        m.m[0][0] = c;
+        m.m[0][1] = -s;
+        m.m[1][0] = s;
+        m.m[1][1] = c;
+        return m;
+    }
+};
+
+struct Affine2D
+{
+    float a = 1.0f, b = 0.0f, tx = 0.0f; // fila x
+    float c = 0.0f, d = 1.0f, ty = 0.0f; // fila y
+
+    Affine2D() = default;
+    Affine2D(float a_, float b_, float tx_, float c_, float d_, float ty_)
+        : a(a_), b(b_), tx(tx_), c(c_), d(d_), ty(ty_) {}
+    Affine2D(const Translate2D &t) : tx(t.tx), ty(t.ty) {}
+    Affine2D(const Scale2D &s) : a(s.sx), d(s.sy) {}
+    Affine2D(const ScaleTranslate2D &st) : a(st.sx), tx(st.tx), d(st.sy), ty(st.ty) {}
+    Affine2D(const Rotate2D &r) : a(r.c), b(-r.s), c(r.s), d(r.c) {}
+
+    static TransformKind Kind() { return TransformKind::Affine; }
+
+    HomogenVector Apply(const HomogenVector &p) const
+    {
+        return HomogenVector(a * p.x + b * p.y + tx * p.w, c * p.x + d * p.y + ty * p.w, p.w);
+    }
+
+    TransformMatrix ToMatrix() const
+    {
+        TransformMatrix m;
+        m.m[0][0] = a;
+        m.m[0][1] = b;
+        m.m[0][2] = tx;
+        m.m[1][0] = c;
+        m.m[1][1] = d;
+        m.m[1][2] = ty;
+        return m;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Composición entre transformaciones del mismo tipo (se mantiene el tipo)
+// ---------------------------------------------------------------------------
+
+inline Translate2D operator*(const Translate2D &l, const Translate2D &r)
+{
+    return Translate2D(l.tx + r.tx, l.ty + r.ty);
+}
+
+inline Scale2D operator*(const Scale2D &l, const Scale2D &r)
+{
+    return Scale2D(l.sx * r.sx, l.sy * r.sy);
+}
+
+inline ScaleTranslate2D operator*(const ScaleTranslate2D &l, const ScaleTranslate2D &r)
+{
+    return ScaleTranslate2D(l.sx * r.sx, l.sy * r.sy, l.sx * r.tx + l.tx, l.sy * r.ty + l.ty);
+}
+
+inline Rotate2D operator*(const Rotate2D &l, const Rotate2D &r)
+{
+    Rotate2D result;
+    result.c = l.c * r.c - l.s * r.s;
+    result.s = l.s * r.c + l.c * r.s;
+    return result;
+}
+
+inline Affine2D operator*(const Affine2D &l, const Affine2D &r)
+{
+    return Affine2D(l.a * r.a + l.b * r.c, l.a * r.b + l.b * r.d, l.a * r.tx + l.b * r.ty + l.tx,
+                    l.c * r.a + l.d * r.c, l.c * r.b + l.d * r.d, l.c * r.tx + l.d * r.ty + l.ty);
+}
+
+// ---------------------------------------------------------------------------
+// Composición entre tipos distintos: se promueven ambos al tipo resultado
+// ---------------------------------------------------------------------------
+
+template <typename T>
+struct IsTransform2D : std::false_type {};
+template <>
+struct IsTransform2D<Translate2D> : std::true_type {};
+template <>
+struct IsTransform2D<Scale2D> : std::true_type {};
+template <>
+struct IsTransform2D<ScaleTranslate2D> : std::true_type {};
+template <>
+struct IsTransform2D<Rotate2D> : std::true_type {};
+template <>
+struct IsTransform2D<Affine2D> : std::true_type {};
+
+// Traslaciones y escalas combinadas siguen siendo ScaleTranslate2D; cualquier mezcla con
+// rotación o con una afín general da Affine2D
+template <typename L, typename R>
+struct ComposeResult
+{
+    using type = Affine2D;
+};
+template <>
+struct ComposeResult<Translate2D, Scale2D> { using type = ScaleTranslate2D; };
+template <>
+struct ComposeResult<Scale2D, Translate2D> { using type = ScaleTranslate2D; };
+template <>
+struct ComposeResult<ScaleTranslate2D, Translate2D> { using type = ScaleTranslate2D; };
+template <>
+struct ComposeResult<Translate2D, ScaleTranslate2D> { using type = ScaleTranslate2D; };
+template <>
+struct ComposeResult<ScaleTranslate2D, Scale2D> { using type = ScaleTranslate2D; };
+template <>
+struct ComposeResult<Scale2D, ScaleTranslate2D> { using type = ScaleTranslate2D; };
+
+template <typename L, typename R,
+          typename = typename std::enable_if<IsTransform2D<L>::value && IsTransform2D<R>::value &&
+                                             !std::is_same<L, R>::value>::type>
+typename ComposeResult<L, R>::type operator*(const L &l, const R &r)
+{
+    using Result = typename ComposeResult<L, R>::type;
+    return Result(l) * Result(r);
+}
+
+// ---------------------------------------------------------------------------
+// Transformación alrededor de un punto: T(p) * t * T(-p) fusionada en una sola afín,
+// así cada punto se transforma con una sola pasada (sin restar/sumar el pivote aparte)
+// ---------------------------------------------------------------------------
+
+inline Translate2D AboutPoint(const Translate2D &t, float, float)
+{
+    return t; // Una traslación no depende del pivote
+}
+
+inline ScaleTranslate2D AboutPoint(const Scale2D &s, float pivotX, float pivotY)
+{
+    return ScaleTranslate2D(s.sx, s.sy, pivotX - s.sx * pivotX, pivotY - s.sy * pivotY);
+}
+
+inline Affine2D AboutPoint(const Rotate2D &r, float pivotX, float pivotY)
+{
+    return Affine2D(r.c, -r.s, pivotX - (r.c * pivotX - r.s * pivotY),
+                    r.s, r.c, pivotY - (r.s * pivotX + r.c * pivotY));
+}
+
+// Caso general (ScaleTranslate2D, Affine2D): composición explícita
+template <typename T>
+auto AboutPoint(const T &transform, float pivotX, float pivotY) -> decltype(Translate2D() * transform * Translate2D())
+{
+    return Translate2D(pivotX, pivotY) * transform * Translate2D(-pivotX, -pivotY);
+}
@@ -0,0 +1,161 @@
+// ViewerInput.cpp
+#include "ViewerInput.h"
+
+ViewerInput::ViewerInput()
+    : translateHeld(false), scaleHeld(false), rotateHeld(false), rotationStep(0.0f),
+      hasPivot(false), pivotX(0.0f), pivotY(0.0f)
+{
+}
+
+ViewerAction ViewerInput::KeyDown(ViewerKey key)
+{
+    switch (key)
+    {
+    case ViewerKey::Translate:
+        translateHeld = true;
+        return ViewerAction::None;
+    case ViewerKey::Scale:
+        scaleHeld = true;
+        return ViewerAction::None;
+    case ViewerKey::Rotate:
+        rotateHeld = true;
+        return ViewerAction::None;
+
+    case ViewerKey::Undo:
+        return ViewerAction::Undo;
+
+    case ViewerKey::Escape:
+        return ViewerAction::Close;
+
+    case ViewerKey::Right:
+        if (translateHeld)
+            Translate(TRANSLATE_STEP, 0);
+        else if (scaleHeld)
+            Scale(SCALE_FACTOR, 1);
+        else if (rotateHeld)
+            Rotate(1);
+        else
+            return ViewerAction::NavigateNext;
+        return ViewerAction::Transform;
+
+    case ViewerKey::Left:
+        if (scaleHeld)
+            Scale(1.0f / SCALE_FACTOR, 1);
+        else if (rotateHeld)
+            Rotate(-1);
+        else if (translateHeld)
+            Translate(-TRANSLATE_STEP, 0);
+        else
+            return ViewerAction::NavigatePrevious;
+        return ViewerAction::Transform;
+
+    case ViewerKey::Up:
+        if (scaleHeld)
+            Scale(1, SCALE_FACTOR);
+        else if (translateHeld)
+            Translate(0, TRANSLATE_STEP);
+        else
+            return ViewerAction::None;
+        return ViewerAction::Transform;
+
+    case ViewerKey::Down:
+        if (scaleHeld)
+            Scale(1, 1.0f / SCALE_FACTOR);
+        else if (translateHeld)
+            Translate(0, -TRANSLATE_STEP);
+        else
+            return ViewerAction::None;
+        return ViewerAction::Transform;
+
+    default:
+        return ViewerAction::None;
+    }
+}
+
+void ViewerInput::KeyUp(ViewerKey key)
+{
+    switch (key)
+    {
+    case ViewerKey::Translate:
+        translateHeld = false;
+        break;
+    case ViewerKey::Scale:
+        scaleHeld = false;
+        break;
+    case ViewerKey::Rotate:
+        rotateHeld = false;
+        break;
+    default:
+        break;
+    }
+}
+
+void ViewerInput::ReleaseModifiers()
+{
+    translateHeld = false;
+    scaleHeld = false;
+    rotateHeld = false;
+}
+
+void ViewerInput::SetPivot(float x, float y)
+{
+    hasPivot = true;
+    pivotX = x;
+    pivotY = y;
+}
+
+void ViewerInput::ClearPivot()
+{
+    hasPivot = false;
+}
+
+FrameIntent ViewerInput::TakeIntent()
+{
+    FrameIntent intent = pending;
+    pending = FrameIntent();
+    return intent;
+}
+
+void ViewerInput::DiscardIntent()
+{
+    pending = FrameIntent();
+}
+
+void ViewerInput::Translate(float tx, float ty)
+{
+    Translate2D translation(tx, ty);
+    pending.transform = Affine2D(translation) * pending.transform;
+    pending.axisAligned = translation * pending.axisAligned;
+    pending.translateX += tx;
+    pending.translateY += ty;
+    pending.eventCount++;
+}
+
+void ViewerInput::Scale(float sx, float sy)
+{
+    Scale2D scaling(sx, sy);
+    ScaleTranslate2D step = hasPivot ? AboutPoint(scaling, pivotX, pivotY) : ScaleTranslate2D(scaling);
+    pending.transform = Affine2D(step) * pending.transform;
+    pending.axisAligned = step * pending.axisAligned;
+    pending.scaleX *= sx;
+    pending.scaleY *= sy;
+    pending.eventCount++;
+}
+
+void ViewerInput::Rotate(int direction)
+{
+    // Cada pulsación aumenta el paso antes de aplicarlo
+    rotationStep += ROTATION_INCREMENT;
+    if (rotationStep >= 360)
+        rotationStep -= 360;
+    float degrees = direction < 0 ? -rotationStep : rotationStep;
+
+    Rotate2D rotation = Rotate2D::FromDegrees(degrees);
+    if (hasPivot)
+        pending.transform = AboutPoint(rotation, pivotX, pivotY) * pending.transform;
+    else
+        pending.transform = Affine2D(rotation) * pending.transform;
+    pending.rotates = true;
+    pending.rotateDegrees += degrees;
+    pending.eventCount++;
+}
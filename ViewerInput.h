@@ -0,0 +1,80 @@
+// ViewerInput.h - Coalesces viewer key events into one transform per displayed frame
+#pragma once
+#include "Transforms2D.h"
+
+// Teclas que le interesan al visor, independientes de la plataforma
+enum class ViewerKey
+{
+    Left,
+    Right,
+    Up,
+    Down,
+    Translate, // T
+    Scale,     // S
+    Rotate,    // R
+    Escape,
+    Undo,      // Ctrl+Z
+    Other
+};
+
+enum class ViewerAction
+{
+    None,
+    Transform, // Se acumuló una transformación: pedir un frame
+    NavigatePrevious,
+    NavigateNext,
+    Undo,
+    Close
+};
+
+// Todo lo que pidió el usuario desde el último frame dibujado
+struct FrameIntent
+{
+    Affine2D transform; // Composición en orden de todos los eventos (incluye el pivote)
+    // La misma composición mientras no haya rotaciones: así se aplica con el kernel de escala
+    ScaleTranslate2D axisAligned;
+    bool rotates = false;
+    float translateX = 0.0f, translateY = 0.0f;
+    float scaleX = 1.0f, scaleY = 1.0f;
+    float rotateDegrees = 0.0f;
+    unsigned eventCount = 0;
+
+    bool IsEmpty() const { return eventCount == 0; }
+};
+
+class ViewerInput
+{
+private:
+    const float TRANSLATE_STEP = 0.02f;
+    const float SCALE_FACTOR = 1.01f;
+    const float ROTATION_INCREMENT = 0.2f;
+
+    bool translateHeld;
+    bool scaleHeld;
+    bool rotateHeld;
+    float rotationStep; // Crece con cada pulsación: la rotación se acelera mientras se mantiene R
+
+    bool hasPivot;
+    float pivotX, pivotY;
+
+    FrameIntent pending;
+
+    void Translate(float tx, float ty);
+    void Scale(float sx, float sy);
+    void Rotate(int direction); // +1 antihorario, -1 horario
+
+public:
+    ViewerInput();
+
+    ViewerAction KeyDown(ViewerKey key);
+    void KeyUp(ViewerKey key);
+    void ReleaseModifiers();
+
+    // Las escalas y rotaciones posteriores se hacen alrededor de este punto
+    void SetPivot(float x, float y);
+    void ClearPivot();
+
+    bool HasPendingIntent() const { return !pending.IsEmpty(); }
+    FrameIntent TakeIntent(); // Devuelve lo acumulado y lo vacía
+    void DiscardIntent();
+};
@@ -0,0 +1,22 @@
+// WglContextPlatform.cpp
+#include "WglContextPlatform.h"
+
+bool WglContextPlatform::MakeCurrent(GLSurfaceHandle surface, GLContextHandle context)
+{
+    HDC hdc = static_cast<HDC>(const_cast<void *>(surface));
+    HGLRC hrc = static_cast<HGLRC>(const_cast<void *>(context));
+    return wglMakeCurrent(hdc, hrc) != FALSE;
+}
+
+void WglContextPlatform::ReleaseCurrent()
+{
+    wglMakeCurrent(nullptr, nullptr);
+}
+
+GLContextManager &GLContextManager::Main()
+{
+    // wglMakeCurrent es por hilo: cada hilo (interfaz, render) lleva su propio contexto actual
+    static WglContextPlatform platform;
+    static thread_local GLContextManager manager(platform);
+    return manager;
+}
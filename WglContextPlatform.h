@@ -0,0 +1,11 @@
+// WglContextPlatform.h - IGLContextPlatform over wglMakeCurrent
+#pragma once
+#include "GLContextManager.h"
+#include <windows.h>
+
+class WglContextPlatform : public IGLContextPlatform
+{
+public:
+    bool MakeCurrent(GLSurfaceHandle surface, GLContextHandle context) override;
+    void ReleaseCurrent() override;
+};
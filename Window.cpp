@@ -1,17 +1,24 @@
 // Window.cpp
 #include "Window.h"
+#include "FrameScheduler.h"
+#include "OpenGLRenderBackend.h"
+#include "GLContextManager.h"
+#include "FigureRendering.h"
 #include <iostream>
 
 const wchar_t *WINDOW_CLASS_NAME = L"OpenGLWindowClass";
 
+int Window::liveWindowCount = 0;
+
 Window::Window(const WindowConfig &cfg)
-    : hwnd(nullptr), config(cfg), active(false)
+    : hwnd(nullptr), config(cfg), active(false), statsOverlayVisible(false)
 {
     renderer = std::make_unique<OpenGLRenderer>();
 }
 
 Window::~Window()
 {
+    MarkInactive();
     if (hwnd)
     {
         DestroyWindow(hwnd);
@@ -60,7 +67,13 @@ bool Window::Create()
     }
 
     renderer->SetClearColor(0.2f, 0.3f, 0.4f);
+
+    // Cada ventana tiene su propio contexto, así que también sus propios buffers
+    renderBackend = std::make_unique<OpenGLRenderBackend>(renderer->GetGLRC(), renderer->PreservesBackBuffer());
+    figureBuffers = std::make_unique<FigureBufferCache>(renderBackend->GetVertexBuffers());
+
     active = true;
+    liveWindowCount++;
 
     return true;
 }
@@ -100,6 +113,72 @@ bool Window::IsActive() const
     return active;
 }
 
+void Window::MarkInactive()
+{
+    if (active)
+    {
+        active = false;
+        liveWindowCount--;
+    }
+    FrameScheduler::Main().RemoveTarget(this);
+}
+
+bool Window::HandleStatsKey(WPARAM key)
+{
+    if (key == VK_F3)
+    {
+        statsOverlayVisible = !statsOverlayVisible;
+        frameTracker.Invalidate(); // La escena no cambió, pero la imagen sí
+        InvalidateRect(hwnd, nullptr, FALSE);
+        return true;
+    }
+
+    if (key == VK_F4)
+    {
+        // Nombre de archivo a partir del título, solo con caracteres ASCII seguros
+        std::string name;
+        for (wchar_t c : config.title)
+        {
+            bool safe = (c >= L'a' && c <= L'z') || (c >= L'A' && c <= L'Z') || (c >= L'0' && c <= L'9');
+            name += safe ? static_cast<char>(c) : '_';
+        }
+        std::string path = "frame_stats_" + name + ".json";
+
+        if (frameStats.WriteJson(path, name))
+            std::wcout << L"Frame stats written to " << path.c_str() << std::endl;
+        else
+            std::wcout << L"Failed to write frame stats to " << path.c_str() << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+FrameRecorder Window::BeginFrameStats() const
+{
+    return FrameRecorder(GLContextManager::Main().GetSwitchCount());
+}
+
+void Window::EndFrameStats(const FrameRecorder &recorder)
+{
+    frameStats.Record(recorder.Finish(GLContextManager::Main().GetSwitchCount()));
+}
+
+void Window::DrawStatsOverlay()
+{
+    if (!statsOverlayVisible || !renderBackend)
+        return;
+
+    RECT rect;
+    GetClientRect(hwnd, &rect);
+    RenderFrameStatsOverlay(*renderBackend, frameStats.GetSummary(), rect.right, rect.bottom);
+}
+
+void Window::RequestFrame()
+{
+    FrameScheduler::Main().RequestFrame(this);
+}
+
 void Window::SetRenderColor(float r, float g, float b)
 {
     renderer->SetClearColor(r, g, b);
@@ -154,13 +233,18 @@ LRESULT Window::HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         return 0;
     }
 
+    case WM_KEYDOWN:
+        if (HandleStatsKey(wParam))
+            return 0;
+        break;
+
     case WM_CLOSE:
-        active = false;
+        MarkInactive();
         DestroyWindow(hwnd);
         return 0;
 
     case WM_DESTROY:
-        active = false;
+        MarkInactive();
         return 0;
     }
 
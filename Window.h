@@ -4,6 +4,10 @@
 #include "IMessageHandler.h"
 #include "WindowConfig.h"
 #include "OpenGLRenderer.h"
+#include "IRenderBackend.h"
+#include "FigureBufferCache.h"
+#include "SceneVersion.h"
+#include "FrameStats.h"
 #include <memory>
 
 class Window : public IWindow, public IMessageHandler
@@ -12,8 +16,27 @@ protected:
     HWND hwnd;
     WindowConfig config;
     std::unique_ptr<OpenGLRenderer> renderer;
+    std::unique_ptr<IRenderBackend> renderBackend; // Dibujo sobre el contexto de esta ventana
+    std::unique_ptr<FigureBufferCache> figureBuffers; // Buffers de vértices de este contexto
     bool active;
 
+    // Última versión de la escena dibujada: WM_PAINT sin cambios no dibuja ni intercambia buffers
+    FrameSkipTracker frameTracker;
+    // Máximo de las versiones de lo que muestra la ventana (figuras, pivote, paleta...)
+    virtual uint64_t GetSceneVersion() const { return 0; }
+
+    // Tiempo, llamadas de dibujo, vértices, cambios de contexto y transformaciones de cada frame.
+    // F3 muestra u oculta la superposición; F4 vuelca las estadísticas a frame_stats_<título>.json
+    FrameStats frameStats;
+    bool statsOverlayVisible;
+    bool HandleStatsKey(WPARAM key);
+    FrameRecorder BeginFrameStats() const;
+    void EndFrameStats(const FrameRecorder &recorder);
+    void DrawStatsOverlay(); // Después del contenido y antes de SwapBuffers
+
+    static int liveWindowCount;
+    void MarkInactive();
+
     static LRESULT CALLBACK StaticWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 public:
@@ -29,6 +52,17 @@ public:
     HWND GetHandle() const override;
     bool IsActive() const override;
 
+    // Ventanas creadas y todavía no cerradas (O(1), lo usa el bucle de mensajes)
+    static int GetLiveWindowCount() { return liveWindowCount; }
+
+    // Redibujar en el próximo tick del FrameScheduler en lugar de inmediatamente
+    void RequestFrame();
+
+    // Frames dibujados y frames saltados por no haber cambios
+    uint64_t GetFramesRendered() const { return frameTracker.GetFramesRendered(); }
+    uint64_t GetFramesSkipped() const { return frameTracker.GetFramesSkipped(); }
+    const FrameStats &GetFrameStats() const { return frameStats; }
+
     // IMessageHandler interface
     LRESULT HandleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) override;
 
@@ -38,4 +72,7 @@ public:
     // Public methods for window handle access
     HWND GetWindowHandle() const { return hwnd; }
     OpenGLRenderer* GetRenderer() const { return renderer.get(); }
+    FigureBufferCache* GetFigureBuffers() const { return figureBuffers.get(); }
+    IRenderBackend* GetRenderBackend() const { return renderBackend.get(); }
+    IVertexBufferBackend* GetVertexBackend() const { return renderBackend ? &renderBackend->GetVertexBuffers() : nullptr; }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 // WindowBuilder.cpp
 #include "WindowBuilder.h"
+#include "EventLoop.h"
 #include <iostream>
 
 WindowBuilder::WindowBuilder()
@@ -56,37 +57,6 @@ const std::vector<std::shared_ptr<Window>> &WindowBuilder::GetWindows() const
 
 void WindowBuilder::MessageLoop()
 {
-    MSG msg = {};
-
-    while (true)
-    {
-        // Verificar si todas las ventanas están cerradas
-        bool anyActive = false;
-        for (const auto &window : windows)
-        {
-            if (window->IsActive())
-            {
-                anyActive = true;
-                break;
-            }
-        }
-
-        if (!anyActive)
-            break;
-
-        // Procesar mensajes
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
-        {
-            if (msg.message == WM_QUIT)
-                break;
-
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }
-        else
-        {
-            // Solo invalidar ventanas que necesiten redibujado
-            // Removemos la invalidación constante para evitar parpadeo
-        }
-    }
+    // Mismo bucle que la aplicación principal: termina cuando no queda ninguna ventana viva
+    EventLoop::Run();
 }
\ No newline at end of file
@@ -1,43 +1,164 @@
 // main.cpp
 #include "MainWindow.h"
 #include "WindowBuilder.h"
+#include "EventLoop.h"
+#include "FigureExporter.h"
+#include "FigureImporter.h"
+#include "FigureLibrary.h"
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <vector>
 
-int main()
+namespace
 {
-    // Crear ventana principal sime
-    WindowConfig mainConfig(L"Transformaciones Geométricas - Principal", 1000, 700, 100, 100);
-    auto mainWindow = std::make_unique<MainWindow>(mainConfig);
+    // Exportación sin ventanas: figuras de --library y --import a imágenes con el rasterizador software
+    struct HeadlessExport
+    {
+        std::string imagesPrefix; // --export-images <prefijo>: una imagen por figura
+        std::string sheetsPrefix; // --export-sheets <prefijo>: hojas de miniaturas
+        ExportOptions options;
 
-    if (!mainWindow->Create())
+        bool IsRequested() const { return !imagesPrefix.empty() || !sheetsPrefix.empty(); }
+    };
+
+    int RunHeadlessExport(const HeadlessExport &request, const std::string &libraryPath, const std::vector<std::string> &imports)
     {
-        std::wcout << L"Error: No se pudo crear la ventana principal" << std::endl;
-        return -1;
+        FigureStore store;
+        std::vector<FigureHandle> figures;
+
+        if (!libraryPath.empty() && !ReadFigureLibrary(libraryPath, store, figures))
+        {
+            std::wcout << L"Error: Could not read figure library " << libraryPath.c_str() << std::endl;
+            return 1;
+        }
+        for (const auto &path : imports)
+        {
+            ImportResult result = ImportFigureFile(path, ImportOptions(), store, figures);
+            std::wcout << L"Imported " << path.c_str() << L": " << result.figureCount << L" figures" << std::endl;
+            for (const auto &error : result.errors)
+                std::wcout << L"  " << path.c_str() << L":" << error.line << L":" << error.column << L": " << error.message.c_str() << std::endl;
+        }
+
+        FigureListView view(store, figures);
+        if (!request.imagesPrefix.empty())
+        {
+            size_t written = ExportFigureImages(view, request.imagesPrefix, request.options);
+            std::wcout << L"Exported " << written << L" of " << view.Size() << L" figure images" << std::endl;
+            if (written != view.Size())
+                return 1;
+        }
+        if (!request.sheetsPrefix.empty())
+        {
+            size_t sheets = GetThumbnailSheetCount(view.Size());
+            size_t written = ExportThumbnailSheets(view, request.sheetsPrefix, request.options);
+            std::wcout << L"Exported " << written << L" of " << sheets << L" thumbnail sheets" << std::endl;
+            if (written != sheets)
+                return 1;
+        }
+        return 0;
     }
 
-    mainWindow->SetRenderColor(0.1f, 0.1f, 0.2f);
-    mainWindow->Show();
+    void PrintUsage()
+    {
+        std::wcout << L"Usage: app [--render-thread] [--library <file>] [--import <file>]...\n"
+                      L"           [--export-images <prefix>] [--export-sheets <prefix>]\n"
+                      L"           [--size <width>x<height>] [--format png|ppm] [--full-size]"
+                   << std::endl;
+    }
+}
 
-    // Loop de mensajes simple
-    MSG msg = {};
-    while (true)
+int main(int argc, char *argv[])
+{
+    // --render-thread: la ventana principal dibuja en su propio hilo
+    // --library <archivo>: cargar las figuras al empezar y guardarlas al salir
+    // --import <archivo>: añadir las figuras de un CSV, WKT o SVG (se puede repetir)
+    // --export-images <prefijo> / --export-sheets <prefijo>: exportar sin abrir ventanas, con
+    //   --size <ancho>x<alto>, --format png|ppm y --full-size (sin recentrar cada figura)
+    std::vector<std::string> imports;
+    std::string libraryPath;
+    bool renderThread = false;
+    HeadlessExport headless;
+    for (int i = 1; i < argc; ++i)
     {
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        std::string argument = argv[i];
+        // Un error en la línea de órdenes no debe acabar abriendo la interfaz (y bloqueando un
+        // proceso por lotes): se informa y se sale
+        bool takesValue = argument == "--library" || argument == "--import" || argument == "--export-images" ||
+                          argument == "--export-sheets" || argument == "--size" || argument == "--format";
+        if (takesValue && i + 1 >= argc)
         {
-            if (msg.message == WM_QUIT)
-                break;
+            std::wcout << L"Error: " << argument.c_str() << L" expects a value" << std::endl;
+            PrintUsage();
+            return -1;
+        }
 
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+        if (argument == "--render-thread")
+            renderThread = true;
+        else if (argument == "--library")
+            libraryPath = argv[++i];
+        else if (argument == "--import")
+            imports.push_back(argv[++i]);
+        else if (argument == "--export-images")
+            headless.imagesPrefix = argv[++i];
+        else if (argument == "--export-sheets")
+            headless.sheetsPrefix = argv[++i];
+        else if (argument == "--size")
+        {
+            int width = 0, height = 0;
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+            {
+                std::wcout << L"Error: --size expects <width>x<height>" << std::endl;
+                return -1;
+            }
+            headless.options.width = width;
+            headless.options.height = height;
         }
+        else if (argument == "--format")
+        {
+            std::string format = argv[++i];
+            if (format == "png")
+                headless.options.format = ImageFormat::PNG;
+            else if (format == "ppm")
+                headless.options.format = ImageFormat::PPM;
+            else
+            {
+                std::wcout << L"Error: --format expects png or ppm" << std::endl;
+                return -1;
+            }
+        }
+        else if (argument == "--full-size")
+            headless.options.mode = ExportMode::FullSize;
         else
         {
-            // Verificar si alguna ventana (principal o de dibujo) sigue activa
-            if (!mainWindow->HasActiveWindows())
-                break;
-
-            Sleep(1);
+            std::wcout << L"Error: Unknown option " << argument.c_str() << std::endl;
+            PrintUsage();
+            return -1;
         }
     }
-    return 0;
+
+    if (headless.IsRequested())
+        return RunHeadlessExport(headless, libraryPath, imports);
+
+    // Crear ventana principal sime
+    WindowConfig mainConfig(L"Transformaciones Geométricas - Principal", 1000, 700, 100, 100);
+    auto mainWindow = std::make_unique<MainWindow>(mainConfig);
+    mainWindow->SetRenderThreadEnabled(renderThread);
+    if (!libraryPath.empty())
+        mainWindow->SetLibraryPath(libraryPath);
+
+    if (!mainWindow->Create())
+    {
+        std::wcout << L"Error: No se pudo crear la ventana principal" << std::endl;
+        return -1;
+    }
+
+    for (const auto &path : imports)
+        mainWindow->ImportFigureFile(path);
+
+    mainWindow->SetRenderColor(0.1f, 0.1f, 0.2f);
+    mainWindow->Show();
+
+    // Loop de mensajes: bloquea mientras no haya eventos y termina al cerrarse todas las ventanas
+    return EventLoop::Run();
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+// BenchUtil.h - Timing helpers shared by the benchmarks
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Mejor tiempo (ms) de repetitions ejecuciones de body: el mínimo es lo menos ruidoso
+template <typename Body>
+double BestOfMs(int repetitions, Body body)
+{
+    double best = 1e300;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = (std::min)(best, ms);
+    }
+    return best;
+}
+
+// Evita que el compilador elimine un resultado que no se usa
+template <typename T>
+void KeepAlive(const T &value)
+{
+    static const void *volatile sink;
+    sink = &value;
+    (void)sink;
+}
+
+inline void PrintBench(const char *name, double ms)
+{
+    std::printf("  %-40s %9.3f ms\n", name, ms);
+}
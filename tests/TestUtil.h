@@ -0,0 +1,32 @@
+// TestUtil.h - Minimal assertions for the portable tests (one executable per test file)
+#pragma once
+#include <cstdio>
+
+namespace testing
+{
+    inline int &FailureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline int Finish(const char *testName)
+    {
+        if (FailureCount() == 0)
+            std::printf("%s: OK\n", testName);
+        else
+            std::printf("%s: %d FAILED\n", testName, FailureCount());
+        return FailureCount() == 0 ? 0 : 1;
+    }
+}
+
+// Sigue con el resto de comprobaciones aunque falle
+#define CHECK(condition)                                                                   \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(condition))                                                                  \
+        {                                                                                  \
+            std::printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+            testing::FailureCount()++;                                                     \
+        }                                                                                  \
+    } while (0)
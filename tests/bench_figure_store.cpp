@@ -0,0 +1,122 @@
+// bench_figure_store.cpp - FigureStore + PointPool vs the old vector<shared_ptr<Figure>> (100k small figures)
+#include "BenchUtil.h"
+#include "../FigureStore.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const size_t FIGURE_COUNT = 100 * 1000;
+    const int POINTS_PER_FIGURE = 20;
+    const int REPETITIONS = 7;
+
+    // Como una figura dibujada a mano: punto a punto
+    Figure MakeFigure(size_t index)
+    {
+        Figure figure("bench");
+        for (int i = 0; i < POINTS_PER_FIGURE; ++i)
+            figure.AddPoint(static_cast<float>(index % 100) * 0.01f + i * 0.001f, static_cast<float>(i) * 0.01f);
+        return figure;
+    }
+
+    // Lo que mira el grid de cada figura
+    double Visit(const Figure &figure)
+    {
+        return figure.GetBounds().GetWidth() + static_cast<double>(figure.GetPointCount()) +
+               static_cast<double>(figure.GetVersion() & 1);
+    }
+
+    void RunSharedPointers()
+    {
+        std::printf("vector<shared_ptr<Figure>>\n");
+        double createMs = 1e300, iterateMs = 1e300, deleteMs = 1e300;
+        for (int r = 0; r < REPETITIONS; ++r)
+        {
+            std::vector<std::shared_ptr<Figure>> figures;
+            createMs = (std::min)(createMs, BestOfMs(1, [&]
+                                                     {
+                                                         figures.reserve(FIGURE_COUNT);
+                                                         for (size_t i = 0; i < FIGURE_COUNT; ++i)
+                                                             figures.push_back(std::make_shared<Figure>(MakeFigure(i))); }));
+            iterateMs = (std::min)(iterateMs, BestOfMs(1, [&]
+                                                       {
+                                                           double sum = 0.0;
+                                                           for (const auto &figure : figures)
+                                                               sum += Visit(*figure);
+                                                           KeepAlive(sum); }));
+            deleteMs = (std::min)(deleteMs, BestOfMs(1, [&]
+                                                     { figures.clear(); }));
+        }
+        PrintBench("create", createMs);
+        PrintBench("iterate", iterateMs);
+        PrintBench("delete", deleteMs);
+    }
+
+    void RunFigureStore()
+    {
+        std::printf("FigureStore + PointPool\n");
+        double createMs = 1e300, iterateMs = 1e300, forEachMs = 1e300, deleteMs = 1e300;
+        for (int r = 0; r < REPETITIONS; ++r)
+        {
+            FigureStore store;
+            std::vector<FigureHandle> handles;
+            createMs = (std::min)(createMs, BestOfMs(1, [&]
+                                                     {
+                                                         handles.reserve(FIGURE_COUNT);
+                                                         for (size_t i = 0; i < FIGURE_COUNT; ++i)
+                                                             handles.push_back(store.Add(MakeFigure(i))); }));
+            // En el orden del grid, resolviendo cada handle
+            iterateMs = (std::min)(iterateMs, BestOfMs(1, [&]
+                                                       {
+                                                           double sum = 0.0;
+                                                           for (FigureHandle handle : handles)
+                                                               sum += Visit(*store.Get(handle));
+                                                           KeepAlive(sum); }));
+            forEachMs = (std::min)(forEachMs, BestOfMs(1, [&]
+                                                       {
+                                                           double sum = 0.0;
+                                                           store.ForEach([&](FigureHandle, Figure &figure)
+                                                                         { sum += Visit(figure); });
+                                                           KeepAlive(sum); }));
+            // Una a una, como al borrar desde la interfaz
+            deleteMs = (std::min)(deleteMs, BestOfMs(1, [&]
+                                                     {
+                                                         for (FigureHandle handle : handles)
+                                                             store.Remove(handle);
+                                                         handles.clear(); }));
+        }
+        PrintBench("create", createMs);
+        PrintBench("iterate (handles)", iterateMs);
+        PrintBench("iterate (ForEach)", forEachMs);
+        PrintBench("delete", deleteMs);
+    }
+
+    void RunPointPool()
+    {
+        // Bloques del tamaño de una figura pequeña, pedidos y devueltos en ráfagas
+        std::printf("PointPool vs operator new, %zu blocks of %zu bytes\n", FIGURE_COUNT, POINT_POOL_MIN_BLOCK_BYTES);
+        std::vector<void *> blocks(FIGURE_COUNT);
+        PrintBench("AllocatePointBlock + FreePointBlock", BestOfMs(REPETITIONS, [&]
+                                                                    {
+                                                                        for (auto &block : blocks)
+                                                                            block = AllocatePointBlock(POINT_POOL_MIN_BLOCK_BYTES);
+                                                                        for (auto *block : blocks)
+                                                                            FreePointBlock(block, POINT_POOL_MIN_BLOCK_BYTES); }));
+        PrintBench("operator new + operator delete", BestOfMs(REPETITIONS, [&]
+                                                              {
+                                                                  for (auto &block : blocks)
+                                                                      block = ::operator new(POINT_POOL_MIN_BLOCK_BYTES);
+                                                                  for (auto *block : blocks)
+                                                                      ::operator delete(block); }));
+    }
+}
+
+int main()
+{
+    std::printf("%zu figures of %d points, best of %d\n", FIGURE_COUNT, POINTS_PER_FIGURE, REPETITIONS);
+    RunSharedPointers();
+    RunFigureStore();
+    RunPointPool();
+    return 0;
+}
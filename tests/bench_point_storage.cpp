@@ -0,0 +1,63 @@
+// bench_point_storage.cpp - Memory and bandwidth of interleaved vs columnar figures (4M points)
+#include "BenchUtil.h"
+#include "../Figure.h"
+#include "../TransformKernels.h"
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    const size_t POINT_COUNT = 4 * 1024 * 1024;
+    const int REPETITIONS = 11;
+
+    Figure MakeFigure(PointStorageMode mode)
+    {
+        std::vector<HomogenVector> points(POINT_COUNT);
+        for (size_t i = 0; i < POINT_COUNT; ++i)
+            points[i] = HomogenVector(static_cast<float>(i % 2048) / 1024.0f - 1.0f, static_cast<float>(i / 2048) / 1024.0f - 1.0f);
+
+        Figure figure("storage");
+        figure.SetStorageMode(mode);
+        figure.AddPoints(points.data(), points.size());
+        return figure;
+    }
+
+    void RunMode(const char *name, PointStorageMode mode)
+    {
+        Figure figure = MakeFigure(mode);
+        std::printf("%s: %.1f MB of point storage (%.1f bytes/point)\n", name,
+                    static_cast<double>(figure.GetStorageBytes()) / (1024.0 * 1024.0),
+                    static_cast<double>(figure.GetStorageBytes()) / POINT_COUNT);
+
+        // Lo que hacen Figure::BakeTransform y los kernels: un rotate+translate en su sitio
+        TransformMatrix matrix = TransformMatrix::Translation(0.01f, 0.0f) * TransformMatrix::Rotation(0.5f);
+        double transformMs = BestOfMs(REPETITIONS, [&]
+                                      {
+                                          if (mode == PointStorageMode::Columnar)
+                                          {
+                                              PointColumns &columns = const_cast<PointColumns &>(figure.GetColumns());
+                                              TransformColumns(matrix, columns.X(), columns.Y(), columns.W(), columns.X(), columns.Y(), columns.W(), columns.Size());
+                                          }
+                                          else
+                                          {
+                                              PointList &points = const_cast<PointList &>(figure.GetPoints());
+                                              TransformPoints(matrix, points);
+                                          } });
+        PrintBench("rotate+translate in place", transformMs);
+
+        // Lo que sube FigureBufferCache/ThumbnailGrid: pares (x/w, y/w)
+        std::vector<float> xy(POINT_COUNT * 2);
+        PrintBench("WriteOpenGLVertices", BestOfMs(REPETITIONS, [&]
+                                                   {
+                                                       figure.WriteOpenGLVertices(xy.data());
+                                                       KeepAlive(xy[0]); }));
+    }
+}
+
+int main()
+{
+    std::printf("Point storage, %zu points, best of %d\n", POINT_COUNT, REPETITIONS);
+    RunMode("interleaved", PointStorageMode::Interleaved);
+    RunMode("columnar", PointStorageMode::Columnar);
+    return 0;
+}
@@ -0,0 +1,75 @@
+// bench_transform_kernels.cpp - Batch transform kernels against the old per-point path
+//
+// Dos tamaños: 1M puntos (12 MB de entrada y 12 MB de salida, limitado por el ancho de banda de
+// memoria) y 16K puntos repetidos 64 veces (los datos caben en la caché: mide la aritmética).
+#include "BenchUtil.h"
+#include "../TransformKernels.h"
+#include <cstdio>
+
+namespace
+{
+    const size_t LARGE_POINT_COUNT = 1000000;
+    const size_t CACHED_POINT_COUNT = 16 * 1024;
+    const int CACHED_PASSES = 64; // 16K * 64: el mismo número de puntos que el caso grande
+    const int REPETITIONS = 31;
+
+    // El camino anterior: FigureViewerWindow::matrix_prod, una matriz float[3][3] por valor y un punto por llamada
+    HomogenVector MatrixProd(float ma[3][3], HomogenVector mb)
+    {
+        float x = mb.x;
+        float y = mb.y;
+        float nx = ma[0][0] * x + ma[0][1] * y + ma[0][2] * 1;
+        float ny = ma[1][0] * x + ma[1][1] * y + ma[1][2] * 1;
+        return HomogenVector(nx, ny, 1.0f);
+    }
+
+    void RunCase(const char *caseName, const TransformMatrix &matrix, const PointList &input, PointList &output, int passes)
+    {
+        std::printf("%s\n", caseName);
+
+        float ma[3][3];
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                ma[r][c] = matrix.m[r][c];
+        PrintBench("per-point matrix_prod (before)", BestOfMs(REPETITIONS, [&]
+                                                            {
+                                                                for (int pass = 0; pass < passes; ++pass)
+                                                                    for (size_t i = 0; i < input.size(); ++i)
+                                                                        output[i] = MatrixProd(ma, input[i]);
+                                                                KeepAlive(output[0]); }));
+
+        const TransformKernel kernels[] = {TransformKernel::Scalar, TransformKernel::SSE2, TransformKernel::AVX2};
+        for (TransformKernel kernel : kernels)
+        {
+            if (!IsTransformKernelSupported(kernel))
+                continue;
+            char name[64];
+            std::snprintf(name, sizeof(name), "TransformPoints %s", GetTransformKernelName(kernel));
+            PrintBench(name, BestOfMs(REPETITIONS, [&]
+                                      {
+                                          for (int pass = 0; pass < passes; ++pass)
+                                              TransformPoints(matrix, input.data(), output.data(), input.size(), kernel);
+                                          KeepAlive(output[0]); }));
+        }
+    }
+
+    void RunSize(size_t pointCount, int passes)
+    {
+        PointList input(pointCount), output(pointCount);
+        for (size_t i = 0; i < pointCount; ++i)
+            input[i] = HomogenVector(static_cast<float>(i % 1000) * 0.001f, static_cast<float>(i / 1000) * 0.001f);
+
+        std::printf("\n%zu points x %d passes, best of %d\n", pointCount, passes, REPETITIONS);
+        RunCase("translation", TransformMatrix::Translation(0.1f, -0.2f), input, output, passes);
+        RunCase("scale", TransformMatrix::Scaling(1.5f, 0.5f), input, output, passes);
+        RunCase("rotation", TransformMatrix::Rotation(30.0f), input, output, passes);
+    }
+}
+
+int main()
+{
+    std::printf("Transform kernels (active: %s)\n", GetTransformKernelName(GetActiveTransformKernel()));
+    RunSize(LARGE_POINT_COUNT, 1);
+    RunSize(CACHED_POINT_COUNT, CACHED_PASSES);
+    return 0;
+}
@@ -0,0 +1,187 @@
+// test_figure_bounds.cpp - Incrementally kept bounds and centroid against a full recomputation
+#include "TestUtil.h"
+#include "../Figure.h"
+#include <cmath>
+
+namespace
+{
+    bool Near(float a, float b)
+    {
+        return std::fabs(a - b) <= 1e-5f * (1.0f + std::fabs(a) + std::fabs(b));
+    }
+
+    bool SameBounds(const FigureBounds &a, const FigureBounds &b)
+    {
+        return Near(a.minX, b.minX) && Near(a.minY, b.minY) && Near(a.maxX, b.maxX) && Near(a.maxY, b.maxY);
+    }
+
+    // Lo que se mantiene en O(1), recalculado recorriendo los puntos
+    void Recompute(const Figure &figure, bool transformed, FigureBounds &bounds, HomogenVector &centroid)
+    {
+        bounds = FigureBounds();
+        double sumX = 0.0, sumY = 0.0;
+        size_t count = figure.GetPointCount();
+        for (size_t i = 0; i < count; ++i)
+        {
+            HomogenVector point = transformed ? figure.GetTransformedPoints()[i] : figure.GetPoint(i);
+            float x, y;
+            point.ToOpenGL(x, y);
+            bounds.Include(x, y);
+            sumX += x;
+            sumY += y;
+        }
+        centroid = count ? HomogenVector(static_cast<float>(sumX / count), static_cast<float>(sumY / count))
+                         : HomogenVector(0.0f, 0.0f);
+    }
+
+    bool StatsMatch(const Figure &figure)
+    {
+        FigureBounds bounds, transformedBounds;
+        HomogenVector centroid, transformedCentroid;
+        Recompute(figure, false, bounds, centroid);
+        Recompute(figure, true, transformedBounds, transformedCentroid);
+        HomogenVector keptCentroid = figure.GetCentroid();
+        HomogenVector keptTransformedCentroid = figure.GetTransformedCentroid();
+        return SameBounds(figure.GetBounds(), bounds) && SameBounds(figure.GetTransformedBounds(), transformedBounds) &&
+               Near(keptCentroid.x, centroid.x) && Near(keptCentroid.y, centroid.y) &&
+               Near(keptTransformedCentroid.x, transformedCentroid.x) &&
+               Near(keptTransformedCentroid.y, transformedCentroid.y);
+    }
+
+    Figure MakeFigure()
+    {
+        Figure figure;
+        figure.AddPoint(-0.5f, 0.25f);
+        figure.AddPoint(0.75f, -0.5f);
+        figure.AddPoint(0.1f, 0.9f);
+        figure.AddPoint(0.3f, 0.3f);
+        return figure;
+    }
+
+    void CheckAddPoints()
+    {
+        Figure figure;
+        CHECK(figure.GetBounds().IsEmpty() && figure.GetTransformedBounds().IsEmpty());
+        CHECK(figure.GetCentroid().x == 0.0f && figure.GetCentroid().y == 0.0f);
+
+        figure.AddPoint(0.5f, -0.25f);
+        CHECK(figure.GetBounds().minX == 0.5f && figure.GetBounds().maxX == 0.5f);
+        CHECK(figure.GetCentroid().x == 0.5f && figure.GetCentroid().y == -0.25f);
+        figure.AddPoint(-0.5f, 0.75f);
+        CHECK(figure.GetBounds().minX == -0.5f && figure.GetBounds().maxY == 0.75f);
+        CHECK(figure.GetCentroid().x == 0.0f && figure.GetCentroid().y == 0.25f);
+        CHECK(StatsMatch(figure));
+
+        // En un solo lote, lo mismo que punto a punto
+        const HomogenVector batch[] = {HomogenVector(0.5f, -0.25f), HomogenVector(-0.5f, 0.75f)};
+        Figure batched;
+        batched.AddPoints(batch, 2);
+        CHECK(SameBounds(batched.GetBounds(), figure.GetBounds()));
+        CHECK(batched.GetCentroid().x == figure.GetCentroid().x && batched.GetCentroid().y == figure.GetCentroid().y);
+
+        // Cambiar de almacenamiento no cambia nada
+        batched.SetStorageMode(PointStorageMode::Columnar);
+        batched.AddPoint(0.2f, 0.2f);
+        CHECK(StatsMatch(batched));
+    }
+
+    void CheckHomogeneousPoints()
+    {
+        // (2, 4, 2) es el punto (1, 2): cuentan x/w e y/w
+        Figure figure;
+        figure.AddPoint(HomogenVector(2.0f, 4.0f, 2.0f));
+        figure.AddPoint(HomogenVector(-3.0f, 0.0f, 3.0f));
+        CHECK(figure.GetBounds().minX == -1.0f && figure.GetBounds().maxX == 1.0f);
+        CHECK(figure.GetBounds().minY == 0.0f && figure.GetBounds().maxY == 2.0f);
+        CHECK(figure.GetCentroid().x == 0.0f && figure.GetCentroid().y == 1.0f);
+
+        figure.ApplyTransform(TransformMatrix::Translation(0.5f, 0.0f) * TransformMatrix::Scaling(2.0f, 1.0f));
+        CHECK(StatsMatch(figure));
+        figure.ApplyTransform(TransformMatrix::Rotation(30.0f));
+        CHECK(StatsMatch(figure));
+    }
+
+    void CheckAxisAlignedCorners()
+    {
+        Figure figure = MakeFigure();
+        figure.ApplyTransform(TransformMatrix::Translation(0.25f, -1.0f));
+        CHECK(StatsMatch(figure));
+
+        // Escala negativa: las esquinas cambian de lado
+        figure.ApplyTransform(TransformMatrix::Scaling(-2.0f, 0.5f));
+        CHECK(figure.GetTransformKind() == TransformKind::AxisAligned);
+        CHECK(StatsMatch(figure));
+        FigureBounds transformed = figure.GetTransformedBounds();
+        CHECK(Near(transformed.minX, -2.0f * (0.75f + 0.25f)) && Near(transformed.maxX, -2.0f * (-0.5f + 0.25f)));
+    }
+
+    void CheckRotatedRecompute()
+    {
+        Figure figure = MakeFigure();
+        figure.ApplyTransform(TransformMatrix::Rotation(45.0f));
+        CHECK(StatsMatch(figure));
+        FigureBounds transformed = figure.GetTransformedBounds();
+
+        // Otra versión: se vuelve a calcular
+        figure.ApplyTransform(TransformMatrix::Rotation(30.0f));
+        CHECK(StatsMatch(figure));
+        figure.AddPoint(2.0f, 2.0f);
+        CHECK(StatsMatch(figure));
+        CHECK(figure.GetTransformedBounds().maxY > transformed.maxY);
+    }
+
+    void CheckBakeTransform()
+    {
+        Figure figure = MakeFigure();
+        figure.ApplyTransform(TransformMatrix::Translation(0.1f, 0.2f) * TransformMatrix::Rotation(60.0f));
+        FigureBounds before = figure.GetTransformedBounds();
+        HomogenVector centroid = figure.GetTransformedCentroid();
+
+        figure.BakeTransform();
+        CHECK(figure.GetTransform().IsIdentity());
+        CHECK(SameBounds(figure.GetBounds(), before) && SameBounds(figure.GetTransformedBounds(), before));
+        CHECK(Near(figure.GetCentroid().x, centroid.x) && Near(figure.GetCentroid().y, centroid.y));
+        CHECK(StatsMatch(figure));
+
+        // Una copia que añade puntos no cambia las estadísticas de la original
+        Figure copy = figure;
+        copy.AddPoint(5.0f, 5.0f);
+        CHECK(SameBounds(figure.GetBounds(), before) && copy.GetBounds().maxX == 5.0f);
+        CHECK(StatsMatch(figure) && StatsMatch(copy));
+
+        figure.Clear();
+        CHECK(figure.GetBounds().IsEmpty() && figure.GetCentroid().x == 0.0f);
+    }
+
+    void CheckProjectiveCentroid()
+    {
+        Figure figure;
+        figure.AddPoint(0.0f, 0.0f);
+        figure.AddPoint(1.0f, 0.0f);
+        figure.AddPoint(1.0f, 1.0f);
+        figure.AddPoint(0.0f, 1.0f);
+        TransformMatrix projective;
+        projective.m[2][0] = 1.0f; // w' = x + w
+        figure.ApplyTransform(projective);
+        CHECK(StatsMatch(figure));
+
+        // La transformada de la media (0.5, 0.5) sería (1/3, 1/3); la media de los puntos
+        // transformados (0,0), (0.5,0), (0.5,0.5), (0,1) es (0.25, 0.375)
+        HomogenVector centroid = figure.GetTransformedCentroid();
+        CHECK(Near(centroid.x, 0.25f) && Near(centroid.y, 0.375f));
+
+        figure.AddPoint(3.0f, 0.0f);
+        CHECK(StatsMatch(figure));
+    }
+}
+
+int main()
+{
+    CheckAddPoints();
+    CheckHomogeneousPoints();
+    CheckAxisAlignedCorners();
+    CheckRotatedRecompute();
+    CheckBakeTransform();
+    CheckProjectiveCentroid();
+    return testing::Finish("test_figure_bounds");
+}
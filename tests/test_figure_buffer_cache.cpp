@@ -0,0 +1,112 @@
+// test_figure_buffer_cache.cpp - Buffer reuse across frames, versions and copies
+#include "TestUtil.h"
+#include "../FigureBufferCache.h"
+#include "../RecordingVertexBufferBackend.h"
+
+namespace
+{
+    typedef RecordingVertexBufferBackend::Operation Operation;
+
+    Figure MakeFigure(int points)
+    {
+        Figure figure;
+        for (int i = 0; i < points; ++i)
+            figure.AddPoint(i * 0.1f, 0.0f);
+        return figure;
+    }
+
+    void CheckUploadOnlyOnChange()
+    {
+        RecordingVertexBufferBackend backend;
+        FigureBufferCache cache(backend);
+        Figure figure = MakeFigure(10);
+
+        FigureBuffer first = cache.Prepare(figure);
+        CHECK(first.count == 10);
+        cache.Sweep();
+
+        // Cambiar la transformación no vuelve a subir los puntos
+        figure.ApplyTransform(TransformMatrix::Translation(1.0f, 0.0f));
+        CHECK(cache.Prepare(figure).buffer == first.buffer);
+        cache.Sweep();
+        CHECK(cache.GetUploadCount() == 1);
+
+        // Dibujo incremental: mismo buffer, datos nuevos
+        figure.AddPoint(5.0f, 5.0f);
+        FigureBuffer grown = cache.Prepare(figure);
+        CHECK(grown.buffer == first.buffer && grown.count == 11);
+        cache.Sweep();
+        CHECK(cache.GetUploadCount() == 2);
+        CHECK(backend.CountOperations(Operation::Create) == 1);
+        CHECK(backend.GetBufferData(first.buffer).size() == 22);
+    }
+
+    void CheckTwoVersionsInOneFrame()
+    {
+        RecordingVertexBufferBackend backend;
+        FigureBufferCache cache(backend);
+        Figure current = MakeFigure(10);
+        Figure previous = current; // Misma id
+        current.AddPoint(9.0f, 9.0f);
+        CHECK(previous.GetId() == current.GetId());
+
+        for (int frame = 0; frame < 5; ++frame)
+        {
+            FigureBuffer a = cache.Prepare(previous);
+            FigureBuffer b = cache.Prepare(current);
+            CHECK(a.buffer != b.buffer);
+            CHECK(a.count == 10 && b.count == 11);
+            cache.Sweep();
+        }
+        // Una subida por versión, no una por frame
+        CHECK(cache.GetUploadCount() == 2);
+        CHECK(cache.GetBufferCount() == 2);
+
+        // Una copia sin cambios en los puntos comparte el buffer
+        Figure copy = current;
+        copy.SetColor(Color(1.0f, 0.0f, 0.0f));
+        cache.Prepare(current);
+        cache.Prepare(copy);
+        CHECK(cache.GetUploadCount() == 2);
+        cache.Sweep();
+
+        // La versión anterior deja de dibujarse: su buffer se libera
+        CHECK(cache.GetBufferCount() == 1);
+        CHECK(backend.GetLiveBufferCount() == 1);
+    }
+
+    void CheckSweepAndRelease()
+    {
+        RecordingVertexBufferBackend backend;
+        FigureBufferCache cache(backend);
+        Figure a = MakeFigure(3), b = MakeFigure(4);
+        Figure olderA = a;
+        a.AddPoint(1.0f, 1.0f);
+
+        cache.Prepare(a);
+        cache.Prepare(olderA);
+        cache.Prepare(b);
+        CHECK(cache.GetBufferCount() == 3);
+
+        cache.Release(a.GetId()); // Todas las versiones de a
+        CHECK(cache.GetBufferCount() == 1);
+        CHECK(backend.GetLiveBufferCount() == 1);
+
+        cache.Sweep();
+        cache.Sweep(); // b no se usó en este frame
+        CHECK(cache.GetBufferCount() == 0);
+        CHECK(backend.GetLiveBufferCount() == 0);
+
+        cache.Prepare(b);
+        cache.Clear();
+        CHECK(cache.GetBufferCount() == 0 && backend.GetLiveBufferCount() == 0);
+    }
+}
+
+int main()
+{
+    CheckUploadOnlyOnChange();
+    CheckTwoVersionsInOneFrame();
+    CheckSweepAndRelease();
+    return testing::Finish("test_figure_buffer_cache");
+}
@@ -0,0 +1,108 @@
+// test_figure_importer.cpp - Coordinates that do not fit in a float are rejected with their position
+#include "TestUtil.h"
+#include "../FigureImporter.h"
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+    ImportResult Import(const std::string &text, ImportFormat format, FigureStore &store,
+                        std::vector<FigureHandle> &handles, bool normalize = false)
+    {
+        std::istringstream input(text);
+        ImportOptions options;
+        options.normalize = normalize;
+        return ImportFigures(input, format, options, store, handles);
+    }
+
+    bool AllPointsFinite(const FigureStore &store, const std::vector<FigureHandle> &handles)
+    {
+        for (FigureHandle handle : handles)
+        {
+            const Figure *figure = store.Get(handle);
+            for (size_t i = 0; i < figure->GetPointCount(); ++i)
+            {
+                HomogenVector point = figure->GetPoint(i);
+                if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.w))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool HasError(const ImportResult &result, size_t line, size_t column)
+    {
+        for (const auto &error : result.errors)
+        {
+            if (error.line == line && error.column == column && error.message == "coordinate out of range")
+                return true;
+        }
+        return false;
+    }
+
+    void CheckCsv()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        ImportResult result = Import("0,0\n1e99999,1\n2,2\n", ImportFormat::CSV, store, handles);
+        CHECK(result.errorCount == 1);
+        CHECK(HasError(result, 2, 1));
+        // La línea se salta; las demás se quedan
+        CHECK(result.pointCount == 2);
+        CHECK(AllPointsFinite(store, handles));
+
+        // También w, y en cualquier columna
+        result = Import("0,0,1\n1,2,-1e39\n", ImportFormat::CSV, store, handles);
+        CHECK(result.errorCount == 1 && HasError(result, 2, 5));
+    }
+
+    void CheckSvg()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        ImportResult result = Import("M0 0 L1e39 0", ImportFormat::SVG, store, handles);
+        CHECK(result.errorCount == 1);
+        CHECK(HasError(result, 1, 7));
+        CHECK(AllPointsFinite(store, handles));
+
+        // Números válidos cuyo punto (relativo) ya no cabe en un float
+        handles.clear();
+        result = Import("M0 0 L1 1\nm3e38 0 l3e38 0", ImportFormat::SVG, store, handles);
+        CHECK(result.errorCount == 1 && HasError(result, 2, 9));
+        CHECK(AllPointsFinite(store, handles));
+    }
+
+    void CheckWkt()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        ImportResult result = Import("LINESTRING (0 0, 1 1e40)\nLINESTRING (0 0, 1 1)\n", ImportFormat::WKT, store, handles);
+        CHECK(result.errorCount == 1 && HasError(result, 1, 20));
+        CHECK(result.figureCount == 1 && handles.size() == 1);
+
+        // Z no se guarda: no importa su rango
+        result = Import("LINESTRING Z (0 0 1e40, 1 1 0)\n", ImportFormat::WKT, store, handles);
+        CHECK(result.errorCount == 0);
+    }
+
+    void CheckLargeFiniteNormalize()
+    {
+        // Cerca de FLT_MAX: el ancho no cabe en float, pero el resultado sigue siendo finito
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        ImportResult result = Import("-3e38,-3e38\n3e38,3e38\n", ImportFormat::CSV, store, handles, true);
+        CHECK(result.errorCount == 0 && result.pointCount == 2);
+        CHECK(AllPointsFinite(store, handles));
+        HomogenVector corner = store.Get(handles[0])->GetPoint(1);
+        CHECK(std::fabs(corner.x - 1.0f) < 1e-4f && std::fabs(corner.y - 1.0f) < 1e-4f);
+    }
+}
+
+int main()
+{
+    CheckCsv();
+    CheckSvg();
+    CheckWkt();
+    CheckLargeFiniteNormalize();
+    return testing::Finish("test_figure_importer");
+}
@@ -0,0 +1,98 @@
+// test_figure_library.cpp - Library round trip and replacing an existing library file
+#include "TestUtil.h"
+#include "../FigureLibrary.h"
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    const char *LIBRARY_PATH = "test_figure_library.flib";
+
+    bool Exists(const std::string &path)
+    {
+        return static_cast<bool>(std::ifstream(path));
+    }
+
+    void AddFigures(FigureStore &store, std::vector<FigureHandle> &handles, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            Figure figure("f" + std::to_string(i));
+            for (int j = 0; j <= i; ++j)
+                figure.AddPoint(j * 0.1f, i * 0.1f);
+            handles.push_back(store.Add(std::move(figure)));
+        }
+    }
+
+    void CheckRoundTrip()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 3);
+        CHECK(WriteFigureLibrary(LIBRARY_PATH, FigureListView(store, handles)));
+        CHECK(!Exists(std::string(LIBRARY_PATH) + ".tmp"));
+
+        FigureStore loaded;
+        std::vector<FigureHandle> loadedHandles;
+        CHECK(ReadFigureLibrary(LIBRARY_PATH, loaded, loadedHandles));
+        CHECK(loadedHandles.size() == 3);
+        CHECK(loaded.Get(loadedHandles[2])->GetName() == "f2" && loaded.Get(loadedHandles[2])->GetPointCount() == 3);
+    }
+
+    void CheckReplaceExisting()
+    {
+        // Guardar encima de una biblioteca que ya existe la sustituye entera
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 5);
+        CHECK(WriteFigureLibrary(LIBRARY_PATH, FigureListView(store, handles)));
+        CHECK(!Exists(std::string(LIBRARY_PATH) + ".tmp"));
+
+        FigureLibrary library;
+        CHECK(library.Open(LIBRARY_PATH));
+        CHECK(library.GetFigureCount() == 5 && library.GetPointCount() == 15);
+    }
+
+    void CheckFailedWriteLeavesNothing()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 2);
+        CHECK(!WriteFigureLibrary("missing_directory/library.flib", FigureListView(store, handles)));
+        CHECK(!Exists("missing_directory/library.flib.tmp"));
+
+        // Un archivo que no es una biblioteca no se carga
+        {
+            std::ofstream garbage(LIBRARY_PATH, std::ios::binary | std::ios::trunc);
+            garbage << "not a library";
+        }
+        FigureStore loaded;
+        std::vector<FigureHandle> loadedHandles;
+        CHECK(!ReadFigureLibrary(LIBRARY_PATH, loaded, loadedHandles));
+    }
+
+    void CheckFailedFlushIsReported()
+    {
+        // /dev/full acepta abrir y escribir en el buffer; el error (ENOSPC) llega al volcarlo al cerrar
+        if (!Exists("/dev/full"))
+            return;
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 3);
+        FigureLibraryWriter writer;
+        CHECK(writer.Open("/dev/full"));
+        for (FigureHandle handle : handles)
+            writer.Add(*store.Get(handle));
+        CHECK(!writer.Finish());
+    }
+}
+
+int main()
+{
+    CheckRoundTrip();
+    CheckReplaceExisting();
+    CheckFailedWriteLeavesNothing();
+    CheckFailedFlushIsReported();
+    std::remove(LIBRARY_PATH);
+    return testing::Finish("test_figure_library");
+}
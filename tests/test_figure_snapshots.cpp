@@ -0,0 +1,124 @@
+// test_figure_snapshots.cpp - Copy-on-write points: copies are immutable versions, also across threads
+#include "TestUtil.h"
+#include "../Figure.h"
+#include "../SpscQueue.h"
+#include <memory>
+#include <thread>
+
+namespace
+{
+    Figure MakeFigure(int points)
+    {
+        Figure figure("snapshot");
+        for (int i = 0; i < points; ++i)
+            figure.AddPoint(i * 0.1f, 0.0f);
+        return figure;
+    }
+
+    void CheckCopiesShareUntilWritten()
+    {
+        Figure figure = MakeFigure(10);
+        Figure copy = figure;
+        CHECK(copy.SharesPointsWith(figure));
+
+        // Transformar no toca los puntos: siguen compartidos
+        figure.ApplyTransform(TransformMatrix::Translation(1.0f, 0.0f));
+        CHECK(copy.SharesPointsWith(figure));
+
+        figure.AddPoint(5.0f, 5.0f);
+        CHECK(!copy.SharesPointsWith(figure));
+        CHECK(copy.GetPointCount() == 10 && figure.GetPointCount() == 11);
+
+        // Hornear en la figura no cambia la versión guardada
+        Figure baked = copy;
+        baked.ApplyTransform(TransformMatrix::Translation(0.0f, 2.0f));
+        baked.BakeTransform();
+        CHECK(copy.GetPoint(3).y == 0.0f && baked.GetPoint(3).y == 2.0f);
+    }
+
+    void CheckClearAndEmptyFigures()
+    {
+        Figure empty;
+        CHECK(empty.GetPointCount() == 0 && empty.GetPoints().empty());
+        CHECK(empty.GetStorageBytes() == 0);
+
+        Figure figure = MakeFigure(10);
+        Figure copy = figure;
+        figure.Clear();
+        CHECK(figure.GetPointCount() == 0 && copy.GetPointCount() == 10);
+
+        // Con un solo dueño se vacía en su sitio
+        copy.Clear();
+        CHECK(copy.GetPointCount() == 0);
+        copy.AddPoint(1.0f, 1.0f);
+        CHECK(copy.GetPointCount() == 1);
+
+        Figure moved = std::move(copy);
+        CHECK(moved.GetPointCount() == 1);
+    }
+
+    void CheckPoolBlocksAreReturned()
+    {
+        PointPoolStats before = GetPointPoolStats();
+        {
+            Figure figure = MakeFigure(100);
+            std::vector<Figure> versions;
+            for (int i = 0; i < 50; ++i)
+            {
+                versions.push_back(figure);
+                figure.AddPoint(i * 0.01f, 1.0f);
+            }
+        }
+        PointPoolStats after = GetPointPoolStats();
+        CHECK(after.allocations == before.allocations);
+        CHECK(after.pooledBytes == before.pooledBytes);
+    }
+
+    // Como los snapshots del hilo de render: el otro hilo lee copias y las suelta mientras este
+    // sigue añadiendo puntos a la original (que copia solo mientras el bloque esté compartido)
+    void CheckSnapshotsAcrossThreads()
+    {
+        SpscQueue<std::shared_ptr<const Figure>> queue(16);
+        const int versions = 2000;
+        bool ok = true;
+
+        std::thread reader([&]()
+                           {
+                               int received = 0;
+                               while (received < versions)
+                               {
+                                   std::shared_ptr<const Figure> snapshot;
+                                   if (!queue.TryPop(snapshot))
+                                   {
+                                       std::this_thread::yield();
+                                       continue;
+                                   }
+                                   // Cada versión tiene exactamente los puntos que tenía al copiarse
+                                   size_t count = snapshot->GetPointCount();
+                                   for (size_t i = 0; i < count; ++i)
+                                       ok = ok && snapshot->GetPoint(i).x == static_cast<float>(i);
+                                   received++;
+                               } });
+
+        Figure figure("live");
+        for (int i = 0; i < versions; ++i)
+        {
+            figure.AddPoint(static_cast<float>(figure.GetPointCount()), 0.0f);
+            auto snapshot = std::make_shared<const Figure>(figure);
+            while (!queue.TryPush(snapshot))
+                std::this_thread::yield();
+        }
+        reader.join();
+        CHECK(ok);
+        CHECK(figure.GetPointCount() == static_cast<size_t>(versions));
+    }
+}
+
+int main()
+{
+    CheckCopiesShareUntilWritten();
+    CheckClearAndEmptyFigures();
+    CheckPoolBlocksAreReturned();
+    CheckSnapshotsAcrossThreads();
+    return testing::Finish("test_figure_snapshots");
+}
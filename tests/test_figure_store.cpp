@@ -0,0 +1,119 @@
+// test_figure_store.cpp - Handles, slot reuse and the per-thread caches of the point pool
+#include "TestUtil.h"
+#include "../FigureStore.h"
+#include <thread>
+
+namespace
+{
+    Figure MakeFigure(const char *name, int points)
+    {
+        Figure figure(name);
+        for (int i = 0; i < points; ++i)
+            figure.AddPoint(i * 0.1f, 0.0f);
+        return figure;
+    }
+
+    void CheckHandles()
+    {
+        FigureStore store;
+        FigureHandle a = store.Add(MakeFigure("a", 3));
+        FigureHandle b = store.Add(MakeFigure("b", 5));
+        CHECK(store.GetCount() == 2);
+        CHECK(store.Get(a)->GetName() == "a" && store.Get(b)->GetPointCount() == 5);
+
+        const Figure *stable = store.Get(b);
+        CHECK(store.Remove(a));
+        CHECK(!store.Remove(a));
+        CHECK(store.Get(a) == nullptr);
+        CHECK(store.Get(b) == stable);
+
+        // El hueco se reutiliza con otra generación: el handle viejo no la ve
+        FigureHandle c = store.Add(MakeFigure("c", 2));
+        CHECK(c.index == a.index && c.generation != a.generation);
+        CHECK(store.Get(a) == nullptr);
+        CHECK(store.Get(c)->GetName() == "c");
+        CHECK(store.Get(FigureHandle()) == nullptr);
+    }
+
+    void CheckForEachAndClear()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        for (int i = 0; i < 600; ++i)
+            handles.push_back(store.Add(MakeFigure("f", 4)));
+        for (size_t i = 0; i < handles.size(); i += 3)
+            store.Remove(handles[i]);
+        CHECK(store.GetCount() == 400);
+        CHECK(store.GetCapacity() == 3 * FigureStore::CHUNK_SIZE);
+
+        size_t visited = 0;
+        store.ForEach([&](FigureHandle handle, Figure &figure)
+                      {
+                          CHECK(store.Get(handle) == &figure);
+                          visited++; });
+        CHECK(visited == 400);
+
+        store.Clear();
+        CHECK(store.GetCount() == 0 && store.GetCapacity() == 0);
+        CHECK(store.Get(handles[1]) == nullptr);
+    }
+
+    void CheckPoolStats()
+    {
+        PointPoolStats before = GetPointPoolStats();
+        {
+            FigureStore store;
+            for (int i = 0; i < 1000; ++i)
+                store.Add(MakeFigure("f", 10));
+            PointPoolStats during = GetPointPoolStats();
+            CHECK(during.allocations >= before.allocations + 1000);
+            CHECK(during.pooledBytes >= before.pooledBytes + 1000 * POINT_POOL_MIN_BLOCK_BYTES);
+        }
+        PointPoolStats after = GetPointPoolStats();
+        CHECK(after.allocations == before.allocations);
+        CHECK(after.pooledBytes == before.pooledBytes);
+    }
+
+    void CheckThreadsReturnTheirBlocks()
+    {
+        // Cada hilo se lleva un lote de bloques de 64 KB; si no los devolviera al terminar, cada
+        // hilo nuevo tendría que sacar otro slab
+        const size_t bytes = size_t(1) << 16;
+        for (int warmup = 0; warmup < 2; ++warmup)
+        {
+            std::thread([bytes]()
+                        { FreePointBlock(AllocatePointBlock(bytes), bytes); })
+                .join();
+        }
+
+        size_t slabBytes = GetPointPoolStats().slabBytes;
+        for (int i = 0; i < 64; ++i)
+        {
+            std::thread([bytes]()
+                        { FreePointBlock(AllocatePointBlock(bytes), bytes); })
+                .join();
+        }
+        CHECK(GetPointPoolStats().slabBytes == slabBytes);
+
+        // Bloques que pide un hilo y libera otro
+        std::vector<void *> blocks;
+        std::thread([&blocks]()
+                    {
+                        for (int i = 0; i < 500; ++i)
+                            blocks.push_back(AllocatePointBlock(POINT_POOL_MIN_BLOCK_BYTES)); })
+            .join();
+        size_t allocations = GetPointPoolStats().allocations;
+        for (void *block : blocks)
+            FreePointBlock(block, POINT_POOL_MIN_BLOCK_BYTES);
+        CHECK(GetPointPoolStats().allocations == allocations - 500);
+    }
+}
+
+int main()
+{
+    CheckHandles();
+    CheckForEachAndClear();
+    CheckPoolStats();
+    CheckThreadsReturnTheirBlocks();
+    return testing::Finish("test_figure_store");
+}
@@ -0,0 +1,139 @@
+// test_frame_scheduler.cpp - Frame pacing against a fake clock
+#include "TestUtil.h"
+#include "../FrameScheduler.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    class FakeClock : public IFrameClock
+    {
+    public:
+        uint64_t now = 1000000;
+        uint64_t NowMicroseconds() const override { return now; }
+    };
+
+    const uint64_t INTERVAL = 16667;
+
+    int targetA, targetB, targetC;
+
+    bool Has(const std::vector<FrameTarget> &targets, FrameTarget target)
+    {
+        return std::find(targets.begin(), targets.end(), target) != targets.end();
+    }
+
+    void CheckIdle()
+    {
+        FakeClock clock;
+        FrameScheduler scheduler(clock, INTERVAL);
+        std::vector<FrameTarget> targets;
+
+        // Sin nada pedido el bucle puede dormir indefinidamente
+        CHECK(!scheduler.HasWork());
+        CHECK(scheduler.GetWaitMicroseconds() == FrameScheduler::WAIT_FOREVER);
+        clock.now += 10 * INTERVAL;
+        CHECK(!scheduler.TakeDueFrame(targets));
+        CHECK(targets.empty());
+        CHECK(scheduler.GetFrameCount() == 0);
+    }
+
+    void CheckCoalescing()
+    {
+        FakeClock clock;
+        FrameScheduler scheduler(clock, INTERVAL);
+        std::vector<FrameTarget> targets;
+
+        // El primer frame no espera
+        scheduler.RequestFrame(&targetA);
+        CHECK(scheduler.GetWaitMicroseconds() == 0);
+        CHECK(scheduler.TakeDueFrame(targets));
+        CHECK(targets.size() == 1 && targets[0] == &targetA);
+
+        // Muchas peticiones dentro del intervalo: un solo frame, cada destino una vez
+        for (int i = 0; i < 50; ++i)
+        {
+            scheduler.RequestFrame(&targetA);
+            scheduler.RequestFrame(&targetB);
+        }
+        clock.now += 5000;
+        CHECK(scheduler.GetWaitMicroseconds() == static_cast<int64_t>(INTERVAL - 5000));
+        CHECK(!scheduler.TakeDueFrame(targets));
+
+        clock.now += INTERVAL - 5000;
+        CHECK(scheduler.TakeDueFrame(targets));
+        CHECK(targets.size() == 2 && Has(targets, &targetA) && Has(targets, &targetB));
+        CHECK(scheduler.GetFrameCount() == 2);
+
+        // Atendido todo, vuelve a poder dormir
+        CHECK(scheduler.GetWaitMicroseconds() == FrameScheduler::WAIT_FOREVER);
+    }
+
+    void CheckCadence()
+    {
+        FakeClock clock;
+        FrameScheduler scheduler(clock, INTERVAL);
+        std::vector<FrameTarget> targets;
+
+        scheduler.SetAnimating(&targetA, true);
+        CHECK(scheduler.TakeDueFrame(targets));
+        uint64_t start = clock.now;
+
+        // Despertar con retraso no desplaza la cadencia: los frames siguen en múltiplos del intervalo
+        int frames = 1;
+        for (int i = 1; i <= 60; ++i)
+        {
+            clock.now = start + i * INTERVAL + 3000;
+            if (scheduler.TakeDueFrame(targets))
+            {
+                frames++;
+                CHECK(scheduler.GetWaitMicroseconds() == static_cast<int64_t>(INTERVAL - 3000));
+            }
+        }
+        CHECK(frames == 61);
+
+        // Muy atrás (p. ej. tras un bloqueo largo) no hay ráfaga para recuperar
+        clock.now += 20 * INTERVAL;
+        CHECK(scheduler.TakeDueFrame(targets));
+        CHECK(!scheduler.TakeDueFrame(targets));
+        CHECK(scheduler.GetWaitMicroseconds() == static_cast<int64_t>(INTERVAL));
+    }
+
+    void CheckAnimatingAndRemove()
+    {
+        FakeClock clock;
+        FrameScheduler scheduler(clock, INTERVAL);
+        std::vector<FrameTarget> targets;
+
+        scheduler.SetAnimating(&targetB, true);
+        scheduler.SetAnimating(&targetB, true);
+        scheduler.RequestFrame(&targetB);
+        scheduler.RequestFrame(&targetC);
+        CHECK(scheduler.TakeDueFrame(targets));
+        CHECK(targets.size() == 2 && Has(targets, &targetB) && Has(targets, &targetC));
+
+        // El animado sigue recibiendo frames sin pedirlos
+        clock.now += INTERVAL;
+        CHECK(scheduler.TakeDueFrame(targets));
+        CHECK(targets.size() == 1 && targets[0] == &targetB);
+
+        scheduler.SetAnimating(&targetB, false);
+        clock.now += INTERVAL;
+        CHECK(!scheduler.TakeDueFrame(targets));
+        CHECK(scheduler.GetWaitMicroseconds() == FrameScheduler::WAIT_FOREVER);
+
+        // Una ventana destruida no recibe el frame que había pedido
+        scheduler.RequestFrame(&targetA);
+        scheduler.SetAnimating(&targetA, true);
+        scheduler.RemoveTarget(&targetA);
+        CHECK(!scheduler.HasWork());
+    }
+}
+
+int main()
+{
+    CheckIdle();
+    CheckCoalescing();
+    CheckCadence();
+    CheckAnimatingAndRemove();
+    return testing::Finish("test_frame_scheduler");
+}
@@ -0,0 +1,176 @@
+// test_frame_stats.cpp - Rolling histograms, per-frame counter deltas and the JSON dump
+#include "TestUtil.h"
+#include "../FrameStats.h"
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    void CheckHistogramStatistics()
+    {
+        RollingHistogram histogram(16);
+        CHECK(histogram.GetCount() == 0);
+        CHECK(histogram.GetPercentile(0.5) == 0.0 && histogram.GetMean() == 0.0 && histogram.GetLast() == 0.0);
+
+        // Desordenados: los percentiles no dependen del orden de llegada
+        const double values[] = {7, 3, 10, 1, 5, 9, 2, 8, 4, 6};
+        for (double value : values)
+            histogram.Add(value);
+        CHECK(histogram.GetCount() == 10);
+        CHECK(histogram.GetMin() == 1.0 && histogram.GetMax() == 10.0);
+        CHECK(histogram.GetMean() == 5.5);
+        CHECK(histogram.GetLast() == 6.0);
+        // Rango redondeado: fraction * (count - 1) + 0.5
+        CHECK(histogram.GetPercentile(0.0) == 1.0);
+        CHECK(histogram.GetPercentile(0.5) == 6.0);
+        CHECK(histogram.GetPercentile(0.95) == 10.0);
+        CHECK(histogram.GetPercentile(1.0) == 10.0);
+        CHECK(histogram.GetPercentile(-1.0) == 1.0 && histogram.GetPercentile(2.0) == 10.0);
+    }
+
+    void CheckBuckets()
+    {
+        // Cubeta 0: < 1; cubeta i: [2^(i-1), 2^i)
+        CHECK(RollingHistogram::GetBucketIndex(0.0) == 0);
+        CHECK(RollingHistogram::GetBucketIndex(0.999) == 0);
+        CHECK(RollingHistogram::GetBucketIndex(-5.0) == 0);
+        CHECK(RollingHistogram::GetBucketIndex(std::numeric_limits<double>::quiet_NaN()) == 0);
+        CHECK(RollingHistogram::GetBucketIndex(1.0) == 1);
+        CHECK(RollingHistogram::GetBucketIndex(1.999) == 1);
+        CHECK(RollingHistogram::GetBucketIndex(2.0) == 2);
+        CHECK(RollingHistogram::GetBucketIndex(1023.0) == 10);
+        CHECK(RollingHistogram::GetBucketIndex(1024.0) == 11);
+        CHECK(RollingHistogram::GetBucketIndex(1e300) == RollingHistogram::BUCKET_COUNT - 1);
+        CHECK(RollingHistogram::GetBucketUpperBound(0) == 1.0 && RollingHistogram::GetBucketUpperBound(11) == 2048.0);
+
+        RollingHistogram histogram(8);
+        histogram.Add(0.5);
+        histogram.Add(1.5);
+        histogram.Add(3.0);
+        histogram.Add(3.5);
+        CHECK(histogram.GetBucket(0) == 1 && histogram.GetBucket(1) == 1 && histogram.GetBucket(2) == 2);
+        CHECK(histogram.GetBucket(3) == 0);
+    }
+
+    void CheckWindowEviction()
+    {
+        RollingHistogram histogram(4);
+        for (double value : {1.0, 2.0, 3.0, 100.0})
+            histogram.Add(value);
+        CHECK(histogram.GetBucket(1) == 1);
+
+        // El quinto valor sustituye al más antiguo (1) y su cubeta se descuenta
+        histogram.Add(200.0);
+        CHECK(histogram.GetCount() == 4);
+        CHECK(histogram.GetMin() == 2.0 && histogram.GetMax() == 200.0);
+        CHECK(histogram.GetLast() == 200.0);
+        CHECK(histogram.GetMean() == (2.0 + 3.0 + 100.0 + 200.0) / 4.0);
+        CHECK(histogram.GetBucket(1) == 0 && histogram.GetBucket(2) == 2 && histogram.GetBucket(7) == 1);
+        CHECK(histogram.GetBucket(8) == 1);
+
+        uint32_t total = 0;
+        for (int i = 0; i < RollingHistogram::BUCKET_COUNT; ++i)
+            total += histogram.GetBucket(i);
+        CHECK(total == 4);
+
+        histogram.Clear();
+        CHECK(histogram.GetCount() == 0 && histogram.GetBucket(2) == 0);
+        histogram.Add(5.0);
+        CHECK(histogram.GetMin() == 5.0 && histogram.GetMax() == 5.0 && histogram.GetLast() == 5.0);
+    }
+
+    void CheckRecorderDeltas()
+    {
+        // Lo contado antes del recorder no es del frame
+        CountDrawCall(1000);
+        FrameRecorder recorder(5);
+        CountDrawCall(10);
+        CountDrawCall(20);
+        CountDrawCall(0);
+        {
+            ScopedTransformTimer timer;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // Otro hilo tiene sus propios contadores
+        std::thread([]()
+                    { CountDrawCall(99); })
+            .join();
+
+        FrameSample sample = recorder.Finish(8);
+        CHECK(sample.drawCalls == 3);
+        CHECK(sample.vertices == 30);
+        CHECK(sample.contextSwitches == 3);
+        CHECK(sample.transformMicroseconds >= 1000.0);
+        CHECK(sample.paintMicroseconds >= sample.transformMicroseconds);
+
+        // Finish no reinicia nada: una segunda lectura incluye lo nuevo
+        CountDrawCall(4);
+        FrameSample later = recorder.Finish(8);
+        CHECK(later.drawCalls == 4 && later.vertices == 34);
+    }
+
+    void CheckSummaryAndJson()
+    {
+        FrameStats stats(2);
+        FrameSample sample;
+        sample.paintMicroseconds = 1500.0;
+        sample.drawCalls = 3;
+        sample.vertices = 12;
+        sample.contextSwitches = 1;
+        sample.transformMicroseconds = 0.5;
+        stats.Record(sample);
+        sample.paintMicroseconds = 2500.0;
+        stats.Record(sample);
+        sample.paintMicroseconds = 3500.0;
+        stats.Record(sample);
+
+        FrameStatsSummary summary = stats.GetSummary();
+        CHECK(summary.frames == 3);
+        CHECK(summary.paintMicroseconds.count == 2);
+        CHECK(summary.paintMicroseconds.min == 2500.0 && summary.paintMicroseconds.max == 3500.0);
+        CHECK(summary.drawCalls.p50 == 3.0 && summary.vertices.mean == 12.0);
+
+        std::string json = stats.ToJson("main \"grid\"\n");
+        const char *expected =
+            "{\n"
+            "  \"name\": \"main \\\"grid\\\"\\u000a\",\n"
+            "  \"frames\": 3,\n"
+            "  \"paintMicroseconds\": {\"count\": 2, \"last\": 3500, \"min\": 2500, \"max\": 3500, \"mean\": 3000, "
+            "\"p50\": 3500, \"p95\": 3500, \"p99\": 3500, \"buckets\": [{\"below\": 1, \"count\": 0}, "
+            "{\"below\": 2, \"count\": 0}, {\"below\": 4, \"count\": 0}, {\"below\": 8, \"count\": 0}, "
+            "{\"below\": 16, \"count\": 0}, {\"below\": 32, \"count\": 0}, {\"below\": 64, \"count\": 0}, "
+            "{\"below\": 128, \"count\": 0}, {\"below\": 256, \"count\": 0}, {\"below\": 512, \"count\": 0}, "
+            "{\"below\": 1024, \"count\": 0}, {\"below\": 2048, \"count\": 0}, {\"below\": 4096, \"count\": 2}]},\n"
+            "  \"drawCalls\": {\"count\": 2, \"last\": 3, \"min\": 3, \"max\": 3, \"mean\": 3, "
+            "\"p50\": 3, \"p95\": 3, \"p99\": 3, \"buckets\": [{\"below\": 1, \"count\": 0}, "
+            "{\"below\": 2, \"count\": 0}, {\"below\": 4, \"count\": 2}]},\n"
+            "  \"vertices\": {\"count\": 2, \"last\": 12, \"min\": 12, \"max\": 12, \"mean\": 12, "
+            "\"p50\": 12, \"p95\": 12, \"p99\": 12, \"buckets\": [{\"below\": 1, \"count\": 0}, "
+            "{\"below\": 2, \"count\": 0}, {\"below\": 4, \"count\": 0}, {\"below\": 8, \"count\": 0}, "
+            "{\"below\": 16, \"count\": 2}]},\n"
+            "  \"contextSwitches\": {\"count\": 2, \"last\": 1, \"min\": 1, \"max\": 1, \"mean\": 1, "
+            "\"p50\": 1, \"p95\": 1, \"p99\": 1, \"buckets\": [{\"below\": 1, \"count\": 0}, "
+            "{\"below\": 2, \"count\": 2}]},\n"
+            "  \"transformMicroseconds\": {\"count\": 2, \"last\": 0.5, \"min\": 0.5, \"max\": 0.5, \"mean\": 0.5, "
+            "\"p50\": 0.5, \"p95\": 0.5, \"p99\": 0.5, \"buckets\": [{\"below\": 1, \"count\": 2}]}\n"
+            "}\n";
+        CHECK(json == expected);
+
+        // Sin frames: histogramas vacíos, sin cubetas
+        stats.Clear();
+        json = stats.ToJson("empty");
+        CHECK(json.find("\"frames\": 0") != std::string::npos);
+        CHECK(json.find("\"buckets\": []") != std::string::npos);
+    }
+}
+
+int main()
+{
+    CheckHistogramStatistics();
+    CheckBuckets();
+    CheckWindowEviction();
+    CheckRecorderDeltas();
+    CheckSummaryAndJson();
+    return testing::Finish("test_frame_stats");
+}
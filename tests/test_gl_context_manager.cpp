@@ -0,0 +1,126 @@
+// test_gl_context_manager.cpp - Context tracking against a mock platform
+#include "TestUtil.h"
+#include "../GLContextManager.h"
+#include <vector>
+
+namespace
+{
+    class MockPlatform : public IGLContextPlatform
+    {
+    public:
+        struct Call
+        {
+            GLSurfaceHandle surface;
+            GLContextHandle context;
+        };
+        std::vector<Call> makeCurrentCalls;
+        int releaseCalls = 0;
+        bool failNext = false;
+
+        bool MakeCurrent(GLSurfaceHandle surface, GLContextHandle context) override
+        {
+            makeCurrentCalls.push_back({surface, context});
+            if (failNext)
+            {
+                failNext = false;
+                return false;
+            }
+            return true;
+        }
+
+        void ReleaseCurrent() override { releaseCalls++; }
+    };
+
+    int surfaceA, surfaceB, contextA, contextB;
+
+    void CheckRepeatBindsAreFree()
+    {
+        MockPlatform platform;
+        GLContextManager manager(platform);
+
+        // Varios helpers de dibujo del mismo frame: un solo MakeCurrent real
+        for (int i = 0; i < 6; ++i)
+            CHECK(manager.Bind(&surfaceA, &contextA));
+        CHECK(platform.makeCurrentCalls.size() == 1);
+        CHECK(manager.GetSwitchCount() == 1);
+        CHECK(manager.GetSkippedBindCount() == 5);
+        CHECK(manager.IsCurrent(&contextA));
+        CHECK(!manager.IsCurrent(&contextB));
+        CHECK(!manager.IsCurrent(nullptr));
+    }
+
+    void CheckSwitchesPerFrame()
+    {
+        MockPlatform platform;
+        GLContextManager manager(platform);
+
+        // Dos ventanas dibujadas en el mismo frame
+        manager.Bind(&surfaceA, &contextA);
+        manager.Bind(&surfaceA, &contextA);
+        manager.Bind(&surfaceB, &contextB);
+        manager.Bind(&surfaceB, &contextB);
+        CHECK(manager.GetFrameSwitchCount() == 2);
+        manager.EndFrame();
+        CHECK(manager.GetLastFrameSwitchCount() == 2);
+        CHECK(manager.GetFrameSwitchCount() == 0);
+
+        // Frame siguiente solo con la segunda ventana: ya estaba activa
+        manager.Bind(&surfaceB, &contextB);
+        manager.EndFrame();
+        CHECK(manager.GetLastFrameSwitchCount() == 0);
+        CHECK(manager.GetSwitchCount() == 2);
+        CHECK(platform.makeCurrentCalls.size() == 2);
+        CHECK(platform.makeCurrentCalls[1].surface == &surfaceB && platform.makeCurrentCalls[1].context == &contextB);
+    }
+
+    void CheckFailureAndInvalidate()
+    {
+        MockPlatform platform;
+        GLContextManager manager(platform);
+
+        CHECK(!manager.Bind(nullptr, &contextA));
+        CHECK(!manager.Bind(&surfaceA, nullptr));
+        CHECK(platform.makeCurrentCalls.empty());
+
+        // Si falla no queda como actual: el siguiente Bind lo vuelve a intentar
+        platform.failNext = true;
+        CHECK(!manager.Bind(&surfaceA, &contextA));
+        CHECK(manager.GetCurrentContext() == nullptr);
+        CHECK(manager.Bind(&surfaceA, &contextA));
+        CHECK(platform.makeCurrentCalls.size() == 2);
+
+        // Alguien cambió el contexto por su cuenta
+        manager.Invalidate();
+        CHECK(manager.Bind(&surfaceA, &contextA));
+        CHECK(platform.makeCurrentCalls.size() == 3);
+    }
+
+    void CheckForget()
+    {
+        MockPlatform platform;
+        GLContextManager manager(platform);
+
+        manager.Bind(&surfaceA, &contextA);
+        // Olvidar otro contexto no suelta el actual
+        manager.Forget(&contextB);
+        CHECK(platform.releaseCalls == 0);
+        CHECK(manager.IsCurrent(&contextA));
+
+        manager.Forget(&contextA);
+        CHECK(platform.releaseCalls == 1);
+        CHECK(manager.GetCurrentContext() == nullptr);
+
+        // El mismo puntero reutilizado por un contexto nuevo se vuelve a activar
+        CHECK(manager.Bind(&surfaceA, &contextA));
+        CHECK(platform.makeCurrentCalls.size() == 2);
+    }
+}
+
+int main()
+{
+    CheckRepeatBindsAreFree();
+    CheckSwitchesPerFrame();
+    CheckFailureAndInvalidate();
+    CheckForget();
+    return testing::Finish("test_gl_context_manager");
+}
@@ -0,0 +1,262 @@
+// test_image_export.cpp - PPM/PNG files (header, chunk CRCs, zlib stream) and headless batch export
+#include "TestUtil.h"
+#include "../ImageWriter.h"
+#include "../FigureExporter.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char *PREFIX = "test_image_export_";
+
+    std::vector<uint8_t> ReadFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    bool Exists(const std::string &path)
+    {
+        return static_cast<bool>(std::ifstream(path));
+    }
+
+    uint32_t ReadUInt32(const uint8_t *p)
+    {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    // Bit a bit, sin tabla: independiente de la de ImageWriter
+    uint32_t ReferenceCrc32(const uint8_t *data, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc ^= data[i];
+            for (int k = 0; k < 8; ++k)
+                crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+        return ~crc;
+    }
+
+    std::vector<uint8_t> MakePixels(int width, int height)
+    {
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < rgba.size(); ++i)
+            rgba[i] = static_cast<uint8_t>(i * 7 + i / 13);
+        return rgba;
+    }
+
+    // Filas PNG esperadas: byte de filtro 0 y RGB
+    std::vector<uint8_t> ExpectedScanlines(const std::vector<uint8_t> &rgba, int width, int height)
+    {
+        std::vector<uint8_t> rows;
+        for (int y = 0; y < height; ++y)
+        {
+            rows.push_back(0);
+            for (int x = 0; x < width; ++x)
+            {
+                const uint8_t *pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+                rows.insert(rows.end(), pixel, pixel + 3);
+            }
+        }
+        return rows;
+    }
+
+    void CheckPpm()
+    {
+        const int width = 3, height = 2;
+        std::vector<uint8_t> rgba = MakePixels(width, height);
+        std::string path = std::string(PREFIX) + "image.ppm";
+        CHECK(WriteImage(path, rgba.data(), width, height, ImageFormat::PPM));
+
+        std::vector<uint8_t> file = ReadFile(path);
+        const char header[] = "P6\n3 2\n255\n";
+        size_t headerSize = sizeof(header) - 1;
+        CHECK(file.size() == headerSize + width * height * 3);
+        CHECK(std::memcmp(file.data(), header, headerSize) == 0);
+        bool pixelsMatch = true;
+        for (int i = 0; i < width * height; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+                pixelsMatch = pixelsMatch && file[headerSize + i * 3 + c] == rgba[i * 4 + c];
+        }
+        CHECK(pixelsMatch);
+        std::remove(path.c_str());
+    }
+
+    // Más de 64 KB de filas: varios bloques stored
+    void CheckPng()
+    {
+        const int width = 200, height = 120;
+        std::vector<uint8_t> rgba = MakePixels(width, height);
+        std::string path = std::string(PREFIX) + "image.png";
+        CHECK(WriteImage(path, rgba.data(), width, height, ImageFormat::PNG));
+        std::vector<uint8_t> file = ReadFile(path);
+        std::remove(path.c_str());
+
+        const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        CHECK(file.size() > 8 && std::memcmp(file.data(), signature, 8) == 0);
+
+        // Bloques: longitud, tipo, datos y CRC de tipo + datos
+        std::vector<std::string> types;
+        std::vector<uint8_t> idat;
+        bool crcsMatch = true, sawIhdr = false;
+        size_t position = 8;
+        while (position + 12 <= file.size())
+        {
+            uint32_t length = ReadUInt32(&file[position]);
+            if (position + 12 + length > file.size())
+                break;
+            const uint8_t *type = &file[position + 4];
+            const uint8_t *data = type + 4;
+            crcsMatch = crcsMatch && ReferenceCrc32(type, length + 4) == ReadUInt32(data + length);
+            std::string typeName(reinterpret_cast<const char *>(type), 4);
+            types.push_back(typeName);
+            if (typeName == "IHDR")
+            {
+                sawIhdr = length == 13 && ReadUInt32(data) == uint32_t(width) && ReadUInt32(data + 4) == uint32_t(height) &&
+                          data[8] == 8 && data[9] == 2 && data[10] == 0 && data[11] == 0 && data[12] == 0;
+            }
+            else if (typeName == "IDAT")
+                idat.insert(idat.end(), data, data + length);
+            position += 12 + length;
+        }
+        CHECK(position == file.size());
+        CHECK(crcsMatch);
+        CHECK(sawIhdr && !types.empty() && types.front() == "IHDR" && types.back() == "IEND");
+
+        // zlib: cabecera válida (múltiplo de 31, sin diccionario) y bloques stored con LEN/NLEN
+        CHECK(idat.size() > 6);
+        CHECK(((idat[0] << 8) | idat[1]) % 31 == 0 && (idat[0] & 0x0F) == 8 && (idat[1] & 0x20) == 0);
+        std::vector<uint8_t> inflated;
+        size_t offset = 2;
+        bool blocksValid = true, final = false;
+        int blocks = 0;
+        while (!final && offset + 5 <= idat.size())
+        {
+            uint8_t flags = idat[offset];
+            final = (flags & 1) != 0;
+            blocksValid = blocksValid && (flags >> 1) == 0; // BTYPE 00
+            uint16_t len = static_cast<uint16_t>(idat[offset + 1] | (idat[offset + 2] << 8));
+            uint16_t nlen = static_cast<uint16_t>(idat[offset + 3] | (idat[offset + 4] << 8));
+            blocksValid = blocksValid && static_cast<uint16_t>(~len) == nlen && offset + 5 + len <= idat.size();
+            if (!blocksValid)
+                break;
+            inflated.insert(inflated.end(), idat.begin() + offset + 5, idat.begin() + offset + 5 + len);
+            offset += 5 + len;
+            blocks++;
+        }
+        CHECK(blocksValid && final && blocks >= 2);
+        CHECK(inflated == ExpectedScanlines(rgba, width, height));
+
+        // Adler-32 de los datos descomprimidos, big-endian, y nada detrás
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : inflated)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        CHECK(offset + 4 == idat.size() && ReadUInt32(&idat[offset]) == ((b << 16) | a));
+    }
+
+    void CheckWriteFailures()
+    {
+        std::vector<uint8_t> rgba = MakePixels(4, 4);
+        CHECK(!WriteImage("missing_directory/image.png", rgba.data(), 4, 4, ImageFormat::PNG));
+        // Todo cabe en el buffer: el fallo (ENOSPC) solo se ve al cerrar
+        if (Exists("/dev/full"))
+            CHECK(!WriteImage("/dev/full", rgba.data(), 4, 4, ImageFormat::PPM));
+    }
+
+    void AddFigures(FigureStore &store, std::vector<FigureHandle> &handles, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            Figure figure;
+            figure.AddPoint(-0.5f, -0.5f);
+            figure.AddPoint(0.5f, 0.1f * i);
+            figure.AddPoint(0.0f, 0.5f);
+            handles.push_back(store.Add(std::move(figure)));
+        }
+    }
+
+    std::string OutputPath(const char *kind, size_t index, const char *extension)
+    {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%05zu", index);
+        return std::string(PREFIX) + kind + number + extension;
+    }
+
+    void CheckExportFigureImages()
+    {
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 4);
+        store.Remove(handles[2]); // Se salta, sin archivo
+
+        ExportOptions options;
+        options.width = 16;
+        options.height = 8;
+        options.format = ImageFormat::PPM;
+        std::string prefix = std::string(PREFIX) + "figure_";
+        CHECK(ExportFigureImages(FigureListView(store, handles), prefix, options) == 3);
+
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+            std::string path = OutputPath("figure_", i, ".ppm");
+            if (i == 2)
+            {
+                CHECK(!Exists(path));
+                continue;
+            }
+            std::vector<uint8_t> file = ReadFile(path);
+            const char header[] = "P6\n16 8\n255\n";
+            CHECK(file.size() == sizeof(header) - 1 + 16 * 8 * 3);
+            CHECK(std::memcmp(file.data(), header, sizeof(header) - 1) == 0);
+            std::remove(path.c_str());
+        }
+
+        // Sin dónde escribir, ninguna
+        CHECK(ExportFigureImages(FigureListView(store, handles), "missing_directory/figure_", options) == 0);
+    }
+
+    void CheckExportThumbnailSheets()
+    {
+        CHECK(GetThumbnailSheetCount(0) == 0);
+        CHECK(GetThumbnailSheetCount(9) == 1);
+        CHECK(GetThumbnailSheetCount(10) == 2);
+
+        FigureStore store;
+        std::vector<FigureHandle> handles;
+        AddFigures(store, handles, 10);
+        ExportOptions options;
+        options.width = 32;
+        options.height = 32;
+        FigureListView view(store, handles);
+        std::string prefix = std::string(PREFIX) + "sheet_";
+        CHECK(ExportThumbnailSheets(view, prefix, options) == GetThumbnailSheetCount(view.Size()));
+        for (size_t s = 0; s < 2; ++s)
+        {
+            std::string path = OutputPath("sheet_", s, ".png");
+            CHECK(ReadFile(path).size() > 8);
+            std::remove(path.c_str());
+        }
+        CHECK(!Exists(OutputPath("sheet_", 2, ".png")));
+
+        CHECK(ExportThumbnailSheets(view, "missing_directory/sheet_", options) == 0);
+    }
+}
+
+int main()
+{
+    CheckPpm();
+    CheckPng();
+    CheckWriteFailures();
+    CheckExportFigureImages();
+    CheckExportThumbnailSheets();
+    return testing::Finish("test_image_export");
+}
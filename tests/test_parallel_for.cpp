@@ -0,0 +1,166 @@
+// test_parallel_for.cpp - The parallel transform path gives the same bits as the serial one
+#include "TestUtil.h"
+#include "../ParallelFor.h"
+#include "../TransformKernels.h"
+#include "../Figure.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    PointList MakePoints(size_t count)
+    {
+        PointList points(count);
+        for (size_t i = 0; i < count; ++i)
+            points[i] = HomogenVector(std::sin(static_cast<float>(i)), std::cos(static_cast<float>(i) * 0.3f), i % 7 == 0 ? 2.0f : 1.0f);
+        return points;
+    }
+
+    bool SameBits(const PointList &a, const PointList &b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(HomogenVector)) == 0);
+    }
+
+    const unsigned WORKER_COUNTS[] = {1, 2, 3, 7, 16};
+
+    void CheckCoverage()
+    {
+        const size_t sizes[] = {1, 5, 63, 64, 65, 1000, 4097};
+        for (unsigned workers : WORKER_COUNTS)
+        {
+            SetWorkerThreadCount(workers);
+            for (size_t count : sizes)
+            {
+                std::vector<std::atomic<int>> visits(count);
+                for (auto &visit : visits)
+                    visit = 0;
+                std::atomic<bool> aligned(true);
+                ParallelFor(count, 64, [&](size_t begin, size_t end)
+                            {
+                                if (begin % 64 != 0)
+                                    aligned = false;
+                                for (size_t i = begin; i < end; ++i)
+                                    visits[i]++;
+                            });
+                bool once = true;
+                for (auto &visit : visits)
+                    once = once && visit == 1;
+                CHECK(once);
+                CHECK(aligned);
+            }
+        }
+    }
+
+    void CheckTransformBits(const TransformMatrix &matrix)
+    {
+        SetParallelTransformThreshold(1);
+        const size_t sizes[] = {1, 9, 1023, 1024, 1025, 100003};
+        for (size_t count : sizes)
+        {
+            PointList input = MakePoints(count);
+            PointList serial(count);
+            TransformPoints(matrix, input.data(), serial.data(), count);
+
+            for (unsigned workers : WORKER_COUNTS)
+            {
+                SetWorkerThreadCount(workers);
+                PointList parallel(count);
+                TransformPointsParallel(matrix, input.data(), parallel.data(), count);
+                CHECK(SameBits(parallel, serial));
+
+                PointList inPlace = input;
+                TransformPointsParallel(matrix, inPlace.data(), inPlace.data(), count);
+                CHECK(SameBits(inPlace, serial));
+            }
+        }
+    }
+
+    // El camino que usan rotate/scale del visor: transformación acumulada y BakeTransform
+    void CheckFigureBits()
+    {
+        SetParallelTransformThreshold(1);
+        PointList input = MakePoints(200001);
+
+        std::vector<PointList> results;
+        for (unsigned workers : WORKER_COUNTS)
+        {
+            SetWorkerThreadCount(workers);
+            Figure figure;
+            figure.AddPoints(input.data(), input.size());
+            figure.ApplyTransform(TransformMatrix::Rotation(17.0f));
+            figure.ApplyTransform(TransformMatrix::Scaling(1.5f, 0.75f));
+            PointList transformed = figure.GetTransformedPoints();
+            figure.BakeTransform();
+            CHECK(SameBits(figure.GetPoints(), transformed));
+            results.push_back(transformed);
+        }
+        for (const PointList &result : results)
+            CHECK(SameBits(result, results.front()));
+    }
+
+    void CheckException()
+    {
+        SetWorkerThreadCount(4);
+        for (size_t throwingChunk = 0; throwingChunk < 4; ++throwingChunk)
+        {
+            std::atomic<int> finished(0);
+            bool caught = false;
+            try
+            {
+                ParallelFor(4000, 1000, [&](size_t begin, size_t)
+                            {
+                                if (begin / 1000 == throwingChunk)
+                                    throw std::runtime_error("chunk");
+                                finished++;
+                            });
+            }
+            catch (const std::runtime_error &)
+            {
+                caught = true;
+            }
+            CHECK(caught);
+            // Se espera a los demás trozos antes de relanzar
+            CHECK(finished == 3);
+        }
+
+        // El pool sigue funcionando después
+        std::atomic<size_t> total(0);
+        ParallelFor(4000, 1000, [&](size_t begin, size_t end) { total += end - begin; });
+        CHECK(total == 4000);
+    }
+
+    void CheckNested()
+    {
+        SetWorkerThreadCount(4);
+        std::atomic<size_t> total(0);
+        ParallelFor(8, 1, [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            ParallelFor(1000, 10, [&](size_t b, size_t e) { total += e - b; });
+                    });
+        CHECK(total == 8000);
+    }
+}
+
+int main()
+{
+    CheckCoverage();
+
+    CheckTransformBits(TransformMatrix::Translation(0.25f, -1.5f));
+    CheckTransformBits(TransformMatrix::Scaling(2.0f, -0.5f));
+    CheckTransformBits(TransformMatrix::Translation(0.3f, 0.1f) * TransformMatrix::Rotation(33.0f));
+    TransformMatrix projective = TransformMatrix::Rotation(10.0f);
+    projective.m[2][0] = 0.25f;
+    projective.m[2][2] = 1.5f;
+    CheckTransformBits(projective);
+
+    CheckFigureBits();
+    CheckException();
+    CheckNested();
+
+    SetWorkerThreadCount(0);
+    return testing::Finish("test_parallel_for");
+}
@@ -0,0 +1,119 @@
+// test_point_columns.cpp - Columnar and interleaved figures give the same points, also for projective matrices
+#include "TestUtil.h"
+#include "../Figure.h"
+#include "../TransformKernels.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    Figure MakeFigure(PointStorageMode mode, size_t count, bool withW)
+    {
+        Figure figure("columns");
+        figure.SetStorageMode(mode);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float t = static_cast<float>(i) * 0.01f;
+            figure.AddPoint(HomogenVector(std::cos(t), std::sin(t * 3.0f), withW && i % 3 == 0 ? 2.0f : 1.0f));
+        }
+        return figure;
+    }
+
+    bool SamePoints(const Figure &a, const Figure &b)
+    {
+        if (a.GetPointCount() != b.GetPointCount())
+            return false;
+        for (size_t i = 0; i < a.GetPointCount(); ++i)
+        {
+            HomogenVector p = a.GetPoint(i), q = b.GetPoint(i);
+            if (std::memcmp(&p, &q, sizeof(p)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    bool SameList(const PointList &a, const PointList &b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(HomogenVector)) == 0);
+    }
+
+    TransformMatrix MakeProjective()
+    {
+        TransformMatrix projective = TransformMatrix::Rotation(20.0f) * TransformMatrix::Translation(0.1f, 0.2f);
+        projective.m[2][0] = 0.3f;
+        projective.m[2][1] = -0.2f;
+        projective.m[2][2] = 1.25f;
+        return projective;
+    }
+
+    void CheckLayoutsAgree(const TransformMatrix &matrix, bool withW)
+    {
+        const size_t count = 1037;
+        Figure interleaved = MakeFigure(PointStorageMode::Interleaved, count, withW);
+        Figure columnar = MakeFigure(PointStorageMode::Columnar, count, withW);
+        interleaved.ApplyTransform(matrix);
+        columnar.ApplyTransform(matrix);
+
+        CHECK(SameList(interleaved.GetTransformedPoints(), columnar.GetTransformedPoints()));
+
+        std::vector<float> xyInterleaved(count * 2), xyColumnar(count * 2);
+        interleaved.WriteOpenGLVertices(xyInterleaved.data());
+        columnar.WriteOpenGLVertices(xyColumnar.data());
+        CHECK(xyInterleaved == xyColumnar);
+
+        interleaved.BakeTransform();
+        columnar.BakeTransform();
+        CHECK(SamePoints(interleaved, columnar));
+        CHECK(columnar.GetTransform().IsIdentity());
+    }
+
+    void CheckProjectiveColumns()
+    {
+        // Lo mismo que TransformPoints punto a punto, con w' escrito en su columna
+        const size_t count = 100;
+        std::vector<float> xs(count), ys(count), ws(count);
+        PointList points(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            xs[i] = static_cast<float>(i) * 0.1f;
+            ys[i] = 1.0f - static_cast<float>(i) * 0.05f;
+            ws[i] = 1.0f;
+            points[i] = HomogenVector(xs[i], ys[i], ws[i]);
+        }
+
+        TransformMatrix projective = MakeProjective();
+        TransformPoints(projective, points);
+
+        std::vector<float> outX(count), outY(count), outW(count);
+        TransformColumns(projective, xs.data(), ys.data(), nullptr, outX.data(), outY.data(), outW.data(), count);
+        for (size_t i = 0; i < count; ++i)
+            CHECK(outX[i] == points[i].x && outY[i] == points[i].y && outW[i] == points[i].w);
+
+        // Sin columna de salida para w: el mismo punto ya dividido
+        TransformColumns(projective, xs.data(), ys.data(), nullptr, outX.data(), outY.data(), nullptr, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float glX, glY;
+            points[i].ToOpenGL(glX, glY);
+            CHECK(outX[i] == glX && outY[i] == glY);
+        }
+    }
+}
+
+int main()
+{
+    CheckLayoutsAgree(TransformMatrix::Translation(0.5f, -0.25f), false);
+    CheckLayoutsAgree(TransformMatrix::Rotation(37.0f) * TransformMatrix::Scaling(2.0f, 0.5f), false);
+    CheckLayoutsAgree(TransformMatrix::Rotation(37.0f), true);
+    CheckLayoutsAgree(MakeProjective(), false);
+    CheckLayoutsAgree(MakeProjective(), true);
+    CheckProjectiveColumns();
+
+    // La columna w solo existe si algún punto la necesita
+    Figure plain = MakeFigure(PointStorageMode::Columnar, 10, false);
+    CHECK(!plain.GetColumns().HasW());
+    CHECK(plain.GetStorageBytes() < MakeFigure(PointStorageMode::Interleaved, 10, false).GetStorageBytes());
+
+    return testing::Finish("test_point_columns");
+}
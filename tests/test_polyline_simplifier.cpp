@@ -0,0 +1,162 @@
+// test_polyline_simplifier.cpp - Douglas-Peucker: kept endpoints, tolerance bound, closed rings and short inputs
+#include "TestUtil.h"
+#include "../PolylineSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    // Distancia de p al segmento a-b, en double para no depender de la del simplificador
+    double DistanceToSegment(const float *p, const float *a, const float *b)
+    {
+        double dx = double(b[0]) - a[0], dy = double(b[1]) - a[1];
+        double px = double(p[0]) - a[0], py = double(p[1]) - a[1];
+        double lengthSquared = dx * dx + dy * dy;
+        double t = lengthSquared > 0.0 ? (px * dx + py * dy) / lengthSquared : 0.0;
+        t = (std::min)(1.0, (std::max)(0.0, t));
+        return std::hypot(px - t * dx, py - t * dy);
+    }
+
+    // Índices de los puntos conservados: el resultado es una subsecuencia de la entrada
+    bool MatchKept(const std::vector<float> &xy, const std::vector<float> &result, std::vector<size_t> &kept)
+    {
+        kept.clear();
+        size_t next = 0;
+        for (size_t i = 0; i < xy.size() / 2 && next < result.size() / 2; ++i)
+        {
+            if (xy[i * 2] == result[next * 2] && xy[i * 2 + 1] == result[next * 2 + 1])
+            {
+                kept.push_back(i);
+                next++;
+            }
+        }
+        return next == result.size() / 2;
+    }
+
+    // Cada punto descartado queda a menos de tolerance del tramo conservado que lo cubre
+    bool WithinTolerance(const std::vector<float> &xy, const std::vector<size_t> &kept, float tolerance)
+    {
+        for (size_t k = 0; k + 1 < kept.size(); ++k)
+        {
+            const float *a = &xy[kept[k] * 2];
+            const float *b = &xy[kept[k + 1] * 2];
+            for (size_t i = kept[k] + 1; i < kept[k + 1]; ++i)
+            {
+                if (DistanceToSegment(&xy[i * 2], a, b) > tolerance * (1.0 + 1e-5))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool Simplifies(const std::vector<float> &xy, float tolerance, std::vector<float> &result)
+    {
+        size_t count = xy.size() / 2;
+        result = SimplifyPolyline(xy.data(), count, tolerance);
+        std::vector<size_t> kept;
+        return result.size() % 2 == 0 && MatchKept(xy, result, kept) && !kept.empty() && kept.front() == 0 &&
+               kept.back() == count - 1 && WithinTolerance(xy, kept, tolerance);
+    }
+
+    void CheckShortInputs()
+    {
+        CHECK(SimplifyPolyline(nullptr, 0, 0.1f).empty());
+        const float one[] = {0.25f, -0.5f};
+        CHECK(SimplifyPolyline(one, 1, 0.1f) == std::vector<float>(one, one + 2));
+        // Dos puntos, aunque coincidan, vuelven tal cual
+        const float two[] = {1.0f, 2.0f, 1.0f, 2.0f};
+        CHECK(SimplifyPolyline(two, 2, 10.0f) == std::vector<float>(two, two + 4));
+    }
+
+    void CheckStraightLine()
+    {
+        // Colineales: solo quedan los extremos
+        std::vector<float> xy;
+        for (int i = 0; i <= 10; ++i)
+        {
+            xy.push_back(i * 0.1f);
+            xy.push_back(i * 0.2f);
+        }
+        std::vector<float> result;
+        CHECK(Simplifies(xy, 1e-4f, result));
+        CHECK(result.size() == 4);
+        CHECK(result[0] == 0.0f && result[1] == 0.0f && result[2] == xy[20] && result[3] == xy[21]);
+    }
+
+    void CheckKeepsCorners()
+    {
+        // Una L: la esquina está a más de tolerance de la diagonal
+        const float corner[] = {0.0f, 0.0f, 0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 0.5f, 1.0f, 1.0f};
+        std::vector<float> xy(corner, corner + 10);
+        std::vector<float> result;
+        CHECK(Simplifies(xy, 0.1f, result));
+        CHECK(result == std::vector<float>({0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f}));
+
+        // Con tolerancia mayor que la distancia de la esquina, solo los extremos
+        CHECK(Simplifies(xy, 0.8f, result));
+        CHECK(result == std::vector<float>({0.0f, 0.0f, 1.0f, 1.0f}));
+    }
+
+    void CheckClosedRing()
+    {
+        // Primero == último: el segmento de referencia tiene longitud cero y la distancia es al punto
+        std::vector<float> xy;
+        const int steps = 64;
+        for (int i = 0; i <= steps; ++i)
+        {
+            float angle = 6.2831853f * (i % steps) / steps;
+            xy.push_back(std::cos(angle));
+            xy.push_back(std::sin(angle));
+        }
+        std::vector<float> result;
+        CHECK(Simplifies(xy, 0.01f, result));
+        CHECK(result.size() >= 8 && result.size() < xy.size());
+        CHECK(result[0] == result[result.size() - 2] && result[1] == result.back());
+
+        // Tolerancia enorme: el anillo se queda en sus dos extremos
+        CHECK(Simplifies(xy, 10.0f, result));
+        CHECK(result.size() == 4);
+
+        // Todos en el mismo punto: nada supera la tolerancia (los índices no se distinguen, se mira el resultado)
+        std::vector<float> degenerate(10, 0.5f);
+        CHECK(SimplifyPolyline(degenerate.data(), 5, 0.0f) == std::vector<float>(4, 0.5f));
+    }
+
+    void CheckToleranceBound()
+    {
+        // Ruido determinista (LCG fijo) sobre una curva: la cota vale para cada tolerancia
+        std::vector<float> xy;
+        uint32_t state = 2024u;
+        for (int i = 0; i < 5000; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            float noise = (state >> 8) / 16777216.0f - 0.5f;
+            xy.push_back(i * 0.001f);
+            xy.push_back(std::sin(i * 0.01f) + noise * 0.05f);
+        }
+        size_t previous = xy.size() + 1;
+        bool ok = true, monotonic = true;
+        for (float tolerance : {0.0f, 0.001f, 0.01f, 0.05f, 0.2f, 1.0f})
+        {
+            std::vector<float> result;
+            ok = ok && Simplifies(xy, tolerance, result);
+            monotonic = monotonic && result.size() <= previous;
+            previous = result.size();
+        }
+        CHECK(ok);
+        // Más tolerancia nunca conserva más puntos en esta curva
+        CHECK(monotonic);
+    }
+}
+
+int main()
+{
+    CheckShortInputs();
+    CheckStraightLine();
+    CheckKeepsCorners();
+    CheckClosedRing();
+    CheckToleranceBound();
+    return testing::Finish("test_polyline_simplifier");
+}
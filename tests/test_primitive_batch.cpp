@@ -0,0 +1,90 @@
+// test_primitive_batch.cpp - Inspect the command list a batch produces, without a window
+#include "TestUtil.h"
+#include "../PrimitiveBatch.h"
+
+namespace
+{
+    bool HasColor(const BatchVertex &vertex, uint8_t r, uint8_t g, uint8_t b)
+    {
+        return vertex.rgba[0] == r && vertex.rgba[1] == g && vertex.rgba[2] == b && vertex.rgba[3] == 255;
+    }
+
+    // Como la paleta de DrawingWindow: 20 muestras con borde, la seleccionada con borde más grueso
+    void CheckColorPickerShape()
+    {
+        PrimitiveBatch batch;
+        for (int i = 0; i < 20; ++i)
+        {
+            float left = -1.0f + i * 0.1f;
+            float right = left + 0.08f;
+            batch.AddQuad(left, 1.0f, right, 0.9f, Color(i / 20.0f, 0.5f, 1.0f));
+            const float border[] = {left, 1.0f, right, 1.0f, right, 0.9f, left, 0.9f};
+            batch.AddLineLoop(border, 4, Color(1.0f, 1.0f, 1.0f), i == 7 ? 3.0f : 1.0f);
+        }
+        batch.Build();
+
+        // 40 glBegin/glEnd antes; ahora rellenos, bordes finos y el borde grueso
+        const auto &commands = batch.GetCommands();
+        CHECK(commands.size() == 3);
+        CHECK(commands[0].primitive == BatchPrimitive::Quads && commands[0].first == 0 && commands[0].count == 80);
+        CHECK(commands[1].primitive == BatchPrimitive::Lines && commands[1].size == 1.0f && commands[1].count == 19 * 8);
+        CHECK(commands[2].primitive == BatchPrimitive::Lines && commands[2].size == 3.0f && commands[2].count == 8);
+        CHECK(commands[2].first + commands[2].count == batch.GetVertices().size());
+
+        // Los rellenos conservan el orden en que se añadieron
+        const auto &vertices = batch.GetVertices();
+        CHECK(vertices[0].x == -1.0f && HasColor(vertices[0], 0, 128, 255));
+        CHECK(HasColor(vertices[4], 13, 128, 255));
+        // El borde grueso es el de la muestra 7
+        CHECK(vertices[commands[2].first].x == -1.0f + 7 * 0.1f);
+    }
+
+    void CheckOrderAndMerge()
+    {
+        PrimitiveBatch batch;
+        CHECK(batch.IsEmpty());
+        batch.AddPoint(0.0f, 0.0f, Color(1.0f, 0.0f, 0.0f), 8.0f);
+        batch.AddLine(0.0f, 0.0f, 1.0f, 1.0f, Color(0.0f, 1.0f, 0.0f), 2.0f);
+        batch.AddQuad(-0.5f, 0.5f, 0.5f, -0.5f, Color(0.0f, 0.0f, 1.0f));
+        batch.AddPoint(0.5f, 0.5f, Color(1.0f, 0.0f, 0.0f), 8.0f);
+        batch.AddLine(1.0f, 1.0f, 0.5f, 0.0f, Color(0.0f, 1.0f, 0.0f), 2.0f);
+        batch.AddLineLoop(nullptr, 1, Color(), 1.0f); // Menos de dos puntos: nada
+        CHECK(!batch.IsEmpty());
+        batch.Build();
+
+        const auto &commands = batch.GetCommands();
+        CHECK(commands.size() == 3);
+        CHECK(commands[0].primitive == BatchPrimitive::Quads && commands[0].count == 4);
+        CHECK(commands[1].primitive == BatchPrimitive::Lines && commands[1].count == 4 && commands[1].first == 4);
+        CHECK(commands[2].primitive == BatchPrimitive::Points && commands[2].count == 2 && commands[2].size == 8.0f);
+
+        const auto &vertices = batch.GetVertices();
+        CHECK(vertices.size() == 10);
+        CHECK(vertices[8].x == 0.0f && vertices[9].x == 0.5f);
+        CHECK(HasColor(vertices[4], 0, 255, 0));
+
+        // Build otra vez no duplica nada
+        batch.Build();
+        CHECK(batch.GetVertices().size() == 10 && batch.GetCommands().size() == 3);
+
+        batch.Clear();
+        CHECK(batch.IsEmpty());
+        CHECK(batch.GetVertices().empty() && batch.GetCommands().empty());
+    }
+
+    void CheckColorPacking()
+    {
+        PrimitiveBatch batch;
+        batch.AddPoint(0.0f, 0.0f, Color(-1.0f, 2.0f, 0.5f), 1.0f);
+        batch.Build();
+        CHECK(HasColor(batch.GetVertices()[0], 0, 255, 128));
+    }
+}
+
+int main()
+{
+    CheckColorPickerShape();
+    CheckOrderAndMerge();
+    CheckColorPacking();
+    return testing::Finish("test_primitive_batch");
+}
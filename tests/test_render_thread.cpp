@@ -0,0 +1,132 @@
+// test_render_thread.cpp - Stress the SPSC queue and the snapshot handoff between two threads
+#include "TestUtil.h"
+#include "../RenderThread.h"
+#include "../SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    void CheckQueueOrder()
+    {
+        const uint64_t COUNT = 2000000;
+        SpscQueue<uint64_t> queue(64);
+        CHECK(queue.GetCapacity() == 64);
+
+        std::thread producer([&]()
+                             {
+                                 for (uint64_t i = 1; i <= COUNT;)
+                                 {
+                                     if (queue.TryPush(i))
+                                         ++i;
+                                     else
+                                         std::this_thread::yield();
+                                 } });
+
+        // Todo llega, una vez y en orden
+        uint64_t expected = 1;
+        bool ordered = true;
+        while (expected <= COUNT)
+        {
+            uint64_t value;
+            if (queue.TryPop(value))
+            {
+                ordered = ordered && value == expected;
+                ++expected;
+            }
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+        CHECK(ordered);
+        CHECK(queue.IsEmpty());
+    }
+
+    void CheckFullAndLatest()
+    {
+        SpscQueue<int> queue(3); // Se redondea a 4
+        CHECK(queue.GetCapacity() == 4);
+        for (int i = 0; i < 4; ++i)
+            CHECK(queue.TryPush(i));
+        CHECK(!queue.TryPush(99));
+
+        int latest = -1;
+        CHECK(queue.PopLatest(latest) == 4);
+        CHECK(latest == 3);
+        CHECK(queue.PopLatest(latest) == 0);
+        CHECK(latest == 3);
+    }
+
+    void CheckSnapshotHandoff()
+    {
+        const uint64_t FRAMES = 20000;
+
+        // El hilo de la interfaz sigue cambiando su figura mientras el de render lee las copias
+        Figure live("live");
+        for (int i = 0; i < 64; ++i)
+            live.AddPoint(static_cast<float>(i), 0.0f);
+        FrameSnapshotBuilder builder;
+
+        std::atomic<bool> started(false), stopped(false);
+        std::atomic<bool> monotonic(true), consistent(true);
+        uint64_t lastSeen = 0; // Solo lo toca el hilo de render
+
+        RenderThread renderThread(4);
+        renderThread.Start([&]() { started = true; },
+                           [&](const FrameSnapshot &snapshot)
+                           {
+                               if (snapshot.sceneVersion <= lastSeen)
+                                   monotonic = false;
+                               lastSeen = snapshot.sceneVersion;
+
+                               // Una copia es inmutable: el número de puntos es el que tenía al publicarse
+                               const Figure &figure = *snapshot.figures[0];
+                               const PointList &points = figure.GetTransformedPoints();
+                               if (points.size() != static_cast<size_t>(snapshot.width))
+                                   consistent = false;
+                           },
+                           [&]() { stopped = true; });
+
+        for (uint64_t frame = 1; frame <= FRAMES; ++frame)
+        {
+            if (frame % 3 == 0)
+                live.AddPoint(static_cast<float>(frame), 1.0f);
+            else
+                live.ApplyTransform(TransformMatrix::Translation(0.001f, 0.0f));
+
+            auto snapshot = std::make_shared<FrameSnapshot>();
+            snapshot->sceneVersion = frame;
+            snapshot->width = static_cast<int>(live.GetPointCount());
+            snapshot->figures.push_back(builder.Capture(live));
+            builder.Sweep();
+
+            while (!renderThread.Publish(snapshot))
+                std::this_thread::yield();
+        }
+
+        // El último siempre se dibuja
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (renderThread.GetLastRenderedVersion() != FRAMES && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        renderThread.Stop();
+        renderThread.Stop(); // Se puede llamar dos veces
+
+        CHECK(started && stopped);
+        CHECK(monotonic);
+        CHECK(consistent);
+        CHECK(renderThread.GetLastRenderedVersion() == FRAMES);
+        CHECK(renderThread.GetPublishedCount() == FRAMES);
+        CHECK(renderThread.GetRenderedCount() + renderThread.GetDroppedCount() == FRAMES);
+        CHECK(builder.GetCachedCount() == 1);
+        CHECK(!renderThread.IsRunning());
+    }
+}
+
+int main()
+{
+    CheckQueueOrder();
+    CheckFullAndLatest();
+    CheckSnapshotHandoff();
+    return testing::Finish("test_render_thread");
+}
@@ -0,0 +1,139 @@
+// test_software_render_backend.cpp - Rasterizer edge cases: huge coordinates, projective matrices and batch draw calls
+#include "TestUtil.h"
+#include "../FrameStats.h"
+#include "../ParallelFor.h"
+#include "../PrimitiveBatch.h"
+#include "../SoftwareRenderBackend.h"
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    const int SIZE = 64;
+
+    size_t CountLit(SoftwareRenderBackend &backend)
+    {
+        const auto &pixels = backend.GetPixels();
+        size_t lit = 0;
+        for (size_t i = 0; i < pixels.size(); i += 4)
+            lit += pixels[i] != 0 ? 1 : 0;
+        return lit;
+    }
+
+    bool IsLit(SoftwareRenderBackend &backend, int x, int y)
+    {
+        return backend.GetPixels()[(static_cast<size_t>(y) * SIZE + x) * 4] != 0;
+    }
+
+    void CheckHugeCoordinates()
+    {
+        SoftwareRenderBackend backend(SIZE, SIZE);
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        backend.SetColor(Color(1.0f, 1.0f, 1.0f));
+
+        const float inf = std::numeric_limits<float>::infinity();
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        // Antes: conversión de float fuera de rango a int (UB)
+        backend.DrawQuad(-1e30f, 1e30f, 1e30f, -1e30f);
+        CHECK(CountLit(backend) == SIZE * SIZE);
+
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        const float line[] = {-1e15f, 0.0f, 1e15f, 0.0f};
+        backend.DrawLineStrip(line, 2);
+        CHECK(IsLit(backend, 0, SIZE / 2) && IsLit(backend, SIZE - 1, SIZE / 2));
+
+        // Vértices no finitos: nada que pintar, sin fallos
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        const float bad[] = {inf, 0.0f, 0.0f, nan, -inf, inf};
+        backend.DrawLineLoop(bad, 3);
+        backend.DrawPoints(bad, 3);
+        backend.DrawQuad(nan, 0.5f, 0.5f, -0.5f);
+        CHECK(CountLit(backend) == 0);
+
+        // La región dañada también se recorta al framebuffer
+        CHECK(backend.SetDamageRect(-inf, 1e30f, nan, -1e30f));
+        backend.Clear(1.0f, 1.0f, 1.0f);
+        backend.ClearDamageRect();
+        backend.GetPixels();
+    }
+
+    void CheckProjective()
+    {
+        SoftwareRenderBackend backend(SIZE, SIZE);
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        backend.SetColor(Color(1.0f, 1.0f, 1.0f));
+
+        // w = 2 en todo el plano: el cuadrado [-1, 1] queda en [-0.5, 0.5], como con OpenGL
+        TransformMatrix half;
+        half.m[2][2] = 2.0f;
+        backend.SetModelMatrix(half);
+        backend.DrawQuad(-1.0f, 1.0f, 1.0f, -1.0f);
+        CHECK(CountLit(backend) == (SIZE / 2) * (SIZE / 2));
+        CHECK(IsLit(backend, SIZE / 2, SIZE / 2));
+        CHECK(!IsLit(backend, 2, 2));
+
+        // w <= 0 en parte del quad: se descarta en vez de dibujarse reflejado
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        TransformMatrix flip;
+        flip.m[2][0] = 2.0f; // w = 2x + 1
+        backend.SetModelMatrix(flip);
+        backend.DrawQuad(-1.0f, 1.0f, 1.0f, -1.0f);
+        CHECK(CountLit(backend) == 0);
+    }
+
+    void CheckSameAcrossThreadCounts()
+    {
+        std::vector<uint8_t> reference;
+        const unsigned counts[] = {1, 3, 8};
+        for (unsigned threads : counts)
+        {
+            SetWorkerThreadCount(threads);
+            SoftwareRenderBackend backend(97, 61);
+            backend.Clear(0.1f, 0.2f, 0.3f);
+            backend.SetColor(Color(1.0f, 0.5f, 0.0f));
+            backend.SetLineWidth(3.0f);
+            const float strip[] = {-0.9f, -0.8f, 0.7f, 0.9f, 0.2f, -0.6f, -0.3f, 0.4f};
+            backend.DrawLineStrip(strip, 4);
+            backend.SetPointSize(5.0f);
+            backend.DrawPoints(strip, 4);
+            const auto &pixels = backend.GetPixels();
+            if (reference.empty())
+                reference = pixels;
+            else
+                CHECK(pixels == reference);
+        }
+        SetWorkerThreadCount(0);
+    }
+
+    void CheckBatchDrawCalls()
+    {
+        PrimitiveBatch batch;
+        batch.AddQuad(-0.5f, 0.5f, 0.5f, -0.5f, Color(0.0f, 0.0f, 1.0f));
+        batch.AddQuad(0.6f, 0.9f, 0.9f, 0.6f, Color(0.0f, 0.0f, 1.0f));
+        batch.AddLine(-1.0f, -1.0f, 1.0f, 1.0f, Color(0.0f, 1.0f, 0.0f), 1.0f);
+        batch.AddLine(-1.0f, 1.0f, 1.0f, -1.0f, Color(0.0f, 1.0f, 0.0f), 1.0f);
+        batch.AddPoint(0.0f, 0.0f, Color(1.0f, 0.0f, 0.0f), 4.0f);
+        batch.Build();
+        CHECK(batch.GetCommands().size() == 3);
+
+        // Una llamada por comando, no por primitiva, igual que con OpenGL
+        SoftwareRenderBackend backend(SIZE, SIZE);
+        backend.Clear(0.0f, 0.0f, 0.0f);
+        FrameRecorder recorder(0);
+        backend.DrawBatch(batch);
+        FrameSample sample = recorder.Finish(0);
+        CHECK(sample.drawCalls == 3);
+        CHECK(sample.vertices == 8 + 4 + 1);
+        CHECK(IsLit(backend, SIZE / 2, SIZE / 2));
+    }
+}
+
+int main()
+{
+    CheckHugeCoordinates();
+    CheckProjective();
+    CheckSameAcrossThreadCounts();
+    CheckBatchDrawCalls();
+    return testing::Finish("test_software_render_backend");
+}
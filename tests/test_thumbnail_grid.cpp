@@ -0,0 +1,169 @@
+// test_thumbnail_grid.cpp - Damaged cells for partial redraws of the thumbnail grid
+#include "TestUtil.h"
+#include "../ThumbnailGrid.h"
+#include "../RecordingVertexBufferBackend.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    Figure MakeFigure(int points)
+    {
+        Figure figure;
+        for (int i = 0; i < points; ++i)
+            figure.AddPoint(i * 0.1f, (i % 2) * 0.1f);
+        return figure;
+    }
+
+    std::vector<const Figure *> Pointers(const std::vector<Figure> &figures)
+    {
+        std::vector<const Figure *> pointers;
+        for (const auto &figure : figures)
+            pointers.push_back(&figure);
+        return pointers;
+    }
+
+    void CheckFirstFrameIsWholePage()
+    {
+        RecordingVertexBufferBackend backend;
+        ThumbnailGrid grid(backend);
+        std::vector<Figure> figures(4, MakeFigure(5));
+        auto pointers = Pointers(figures);
+
+        grid.Update(FigureListView(pointers));
+        float left, top, right, bottom;
+        CHECK(!grid.GetDamageRect(left, top, right, bottom));
+
+        // Sin cambios no hay nada que redibujar
+        grid.ClearDamage();
+        grid.Update(FigureListView(pointers));
+        CHECK(!grid.GetDamageRect(left, top, right, bottom));
+    }
+
+    void CheckOneFigureDamagesOneCell()
+    {
+        RecordingVertexBufferBackend backend;
+        ThumbnailGrid grid(backend);
+        std::vector<Figure> figures(4, MakeFigure(5));
+        auto pointers = Pointers(figures);
+        grid.Update(FigureListView(pointers));
+        grid.ClearDamage();
+        uint64_t cellUpdates = grid.GetCellUpdateCount();
+
+        // Segunda celda (fila 0, columna 1 de un grid de 3x2)
+        figures[1].ApplyTransform(TransformMatrix::Translation(0.1f, 0.0f));
+        grid.Update(FigureListView(pointers));
+        CHECK(grid.GetCellUpdateCount() == cellUpdates + 1);
+
+        float left, top, right, bottom;
+        CHECK(grid.GetDamageRect(left, top, right, bottom));
+        float cellLeft, cellTop, cellRight, cellBottom;
+        grid.GetLayout().GetCellRect(1, cellLeft, cellTop, cellRight, cellBottom);
+        CHECK(left == cellLeft && top == cellTop && right == cellRight && bottom == cellBottom);
+        CHECK(left > grid.GetLayout().areaLeft && right < grid.GetLayout().areaRight);
+        CHECK(bottom > grid.GetLayout().areaBottom);
+
+        // Puntos nuevos en la misma página: solo se recalcula esa celda
+        grid.ClearDamage();
+        figures[3].AddPoint(1.0f, 1.0f);
+        grid.Update(FigureListView(pointers));
+        CHECK(grid.GetDamageRect(left, top, right, bottom));
+        grid.GetLayout().GetCellRect(3, cellLeft, cellTop, cellRight, cellBottom);
+        CHECK(left == cellLeft && top == cellTop && right == cellRight && bottom == cellBottom);
+        CHECK(grid.GetCellUpdateCount() == cellUpdates + 2);
+    }
+
+    void CheckTwoCellsUnion()
+    {
+        RecordingVertexBufferBackend backend;
+        ThumbnailGrid grid(backend);
+        std::vector<Figure> figures(4, MakeFigure(5));
+        auto pointers = Pointers(figures);
+        grid.Update(FigureListView(pointers));
+        grid.ClearDamage();
+
+        figures[0].ApplyTransform(TransformMatrix::Translation(0.1f, 0.0f));
+        figures[3].ApplyTransform(TransformMatrix::Translation(0.1f, 0.0f));
+        grid.Update(FigureListView(pointers));
+
+        float left, top, right, bottom;
+        CHECK(grid.GetDamageRect(left, top, right, bottom));
+        const GridLayout &layout = grid.GetLayout();
+        // Celdas 0 y 3: la primera columna entera
+        CHECK(std::fabs(left - layout.areaLeft) < 1e-6f);
+        CHECK(std::fabs(right - (layout.areaLeft + layout.CellWidth())) < 1e-6f);
+        CHECK(std::fabs(top - layout.areaTop) < 1e-6f && std::fabs(bottom - layout.areaBottom) < 1e-6f);
+    }
+
+    void CheckPageChangesAreWholePage()
+    {
+        RecordingVertexBufferBackend backend;
+        ThumbnailGrid grid(backend);
+        std::vector<Figure> figures(12, MakeFigure(5));
+        auto pointers = Pointers(figures);
+        grid.Update(FigureListView(pointers));
+        grid.ClearDamage();
+
+        // Desplazamiento: otra página
+        float left, top, right, bottom;
+        grid.Update(FigureListView(pointers), 1);
+        CHECK(!grid.GetDamageRect(left, top, right, bottom));
+        grid.ClearDamage();
+
+        // Otra lista (una figura menos): cambia la distribución
+        pointers.pop_back();
+        grid.Update(FigureListView(pointers), 1);
+        CHECK(!grid.GetDamageRect(left, top, right, bottom));
+        grid.ClearDamage();
+
+        grid.Update(FigureListView(pointers), 1);
+        CHECK(!grid.GetDamageRect(left, top, right, bottom));
+    }
+
+    void CheckFinishedLodIsPickedUp()
+    {
+        RecordingVertexBufferBackend backend;
+        PolylineLodCache cache;
+        ThumbnailGrid grid(backend);
+        grid.SetLodCache(&cache);
+
+        // Una figura grande y casi recta: los niveles simples se quedan en pocos puntos
+        std::vector<Figure> figures(2, MakeFigure(5));
+        for (int i = 0; i < 2000; ++i)
+            figures[1].AddPoint(i * 0.001f, (i % 2) * 1e-5f);
+        auto pointers = Pointers(figures);
+
+        uint64_t before = cache.GetCompletedVersion();
+        grid.Update(FigureListView(pointers));
+        grid.ClearDamage();
+        CHECK(grid.GetInstances()[1].lodLevel == -1);
+
+        for (int i = 0; i < 2000 && cache.HasPendingBuilds(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK(!cache.HasPendingBuilds());
+        CHECK(cache.GetCompletedVersion() > before);
+
+        // El siguiente Update usa el nivel y solo daña esa celda
+        grid.Update(FigureListView(pointers));
+        CHECK(grid.GetInstances()[1].lodLevel >= 0);
+        float left, top, right, bottom, cellLeft, cellTop, cellRight, cellBottom;
+        CHECK(grid.GetDamageRect(left, top, right, bottom));
+        grid.GetLayout().GetCellRect(1, cellLeft, cellTop, cellRight, cellBottom);
+        CHECK(left == cellLeft && right == cellRight);
+
+        grid.ClearDamage();
+        grid.Update(FigureListView(pointers));
+        CHECK(!grid.HasDamage());
+    }
+}
+
+int main()
+{
+    CheckFirstFrameIsWholePage();
+    CheckOneFigureDamagesOneCell();
+    CheckTwoCellsUnion();
+    CheckPageChangesAreWholePage();
+    CheckFinishedLodIsPickedUp();
+    return testing::Finish("test_thumbnail_grid");
+}
@@ -0,0 +1,67 @@
+// test_transform_kernels.cpp - Every kernel gives the same bits, for every matrix kind and size
+#include "TestUtil.h"
+#include "../TransformKernels.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    PointList MakePoints(size_t count)
+    {
+        PointList points(count);
+        for (size_t i = 0; i < count; ++i)
+            points[i] = HomogenVector(std::sin(static_cast<float>(i)), std::cos(static_cast<float>(i) * 0.7f), i % 5 == 0 ? 2.0f : 1.0f);
+        return points;
+    }
+
+    bool SameBits(const PointList &a, const PointList &b)
+    {
+        // memcmp con punteros nulos (listas vacías) es UB aunque el tamaño sea 0
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(HomogenVector)) == 0);
+    }
+
+    void CheckMatrix(const TransformMatrix &matrix)
+    {
+        const size_t sizes[] = {0, 1, 3, 4, 7, 8, 9, 31, 1000, 4099};
+        for (size_t count : sizes)
+        {
+            PointList input = MakePoints(count);
+
+            PointList scalar(count);
+            TransformPoints(matrix, input.data(), scalar.data(), count, TransformKernel::Scalar);
+            for (size_t i = 0; i < count; ++i)
+            {
+                HomogenVector expected = matrix.Apply(input[i]);
+                CHECK(std::fabs(scalar[i].x - expected.x) <= 1e-6f && std::fabs(scalar[i].y - expected.y) <= 1e-6f &&
+                      scalar[i].w == expected.w);
+            }
+
+            const TransformKernel kernels[] = {TransformKernel::SSE2, TransformKernel::AVX2};
+            for (TransformKernel kernel : kernels)
+            {
+                PointList output(count);
+                TransformPoints(matrix, input.data(), output.data(), count, kernel);
+                CHECK(SameBits(output, scalar));
+
+                PointList inPlace = input;
+                TransformPoints(matrix, inPlace.data(), inPlace.data(), count, kernel);
+                CHECK(SameBits(inPlace, scalar));
+            }
+        }
+    }
+}
+
+int main()
+{
+    CheckMatrix(TransformMatrix::Translation(0.25f, -1.5f));
+    CheckMatrix(TransformMatrix::Scaling(2.0f, -0.5f));
+    CheckMatrix(TransformMatrix::Scaling(3.0f, 0.5f) * TransformMatrix::Translation(0.1f, 0.2f));
+    CheckMatrix(TransformMatrix::Translation(0.3f, 0.1f) * TransformMatrix::Rotation(33.0f));
+
+    TransformMatrix projective = TransformMatrix::Rotation(10.0f);
+    projective.m[2][0] = 0.25f;
+    projective.m[2][2] = 1.5f;
+    CheckMatrix(projective);
+
+    return testing::Finish("test_transform_kernels");
+}
@@ -0,0 +1,119 @@
+// test_typed_transforms.cpp - Transforms2D types keep their kind down to the batch kernels
+#include "TestUtil.h"
+#include "../Figure.h"
+#include "../TransformKernels.h"
+#include "../Transforms2D.h"
+#include "../ViewerInput.h"
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_same<decltype(Translate2D() * Scale2D()), ScaleTranslate2D>::value, "translate * scale");
+static_assert(std::is_same<decltype(Scale2D() * ScaleTranslate2D()), ScaleTranslate2D>::value, "scale * scale-translate");
+static_assert(std::is_same<decltype(Rotate2D() * Translate2D()), Affine2D>::value, "rotate * translate");
+static_assert(std::is_same<decltype(AboutPoint(Scale2D(), 1.0f, 2.0f)), ScaleTranslate2D>::value, "scale about point");
+
+namespace
+{
+    PointList MakePoints(size_t count)
+    {
+        PointList points(count);
+        for (size_t i = 0; i < count; ++i)
+            points[i] = HomogenVector(std::sin(static_cast<float>(i)), std::cos(static_cast<float>(i) * 0.3f), 1.0f);
+        return points;
+    }
+
+    bool SameBits(const PointList &a, const PointList &b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(HomogenVector)) == 0);
+    }
+
+    bool Near(const HomogenVector &a, const HomogenVector &b)
+    {
+        return std::fabs(a.x - b.x) <= 1e-5f && std::fabs(a.y - b.y) <= 1e-5f && a.w == b.w;
+    }
+
+    template <typename Transform>
+    void CheckKernelMatchesApply(const Transform &transform)
+    {
+        PointList input = MakePoints(1001);
+        PointList output(input.size());
+        TransformPoints(transform.ToMatrix(), Transform::Kind(), input.data(), output.data(), input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+            CHECK(Near(output[i], transform.Apply(input[i])));
+
+        // Mismo camino que con la matriz clasificada en tiempo de ejecución
+        PointList classified(input.size());
+        TransformPoints(transform.ToMatrix(), input.data(), classified.data(), input.size());
+        if (transform.ToMatrix().GetKind() == Transform::Kind())
+            CHECK(SameBits(output, classified));
+    }
+
+    void CheckFigureKind()
+    {
+        PointList input = MakePoints(5000);
+        Figure figure;
+        figure.AddPoints(input.data(), input.size());
+        CHECK(figure.GetTransformKind() == TransformKind::Translation);
+
+        figure.ApplyTransform(Translate2D(0.5f, -0.25f));
+        CHECK(figure.GetTransformKind() == TransformKind::Translation);
+        figure.ApplyTransform(Scale2D(2.0f, 0.5f));
+        CHECK(figure.GetTransformKind() == TransformKind::AxisAligned);
+
+        // Con el mismo recorrido por matrices sale lo mismo
+        Figure reference;
+        reference.AddPoints(input.data(), input.size());
+        reference.ApplyTransform(TransformMatrix::Translation(0.5f, -0.25f));
+        reference.ApplyTransform(TransformMatrix::Scaling(2.0f, 0.5f));
+        CHECK(SameBits(figure.GetTransformedPoints(), reference.GetTransformedPoints()));
+
+        figure.ApplyTransform(Rotate2D::FromDegrees(30.0f));
+        CHECK(figure.GetTransformKind() == TransformKind::Affine);
+        // Una rotación de 0 grados no vuelve a estrechar la forma: sigue siendo correcta
+        figure.ApplyTransform(Rotate2D::FromDegrees(-30.0f));
+        CHECK(figure.GetTransformKind() == TransformKind::Affine);
+        const PointList &transformed = figure.GetTransformedPoints();
+        for (size_t i = 0; i < input.size(); ++i)
+            CHECK(Near(transformed[i], figure.GetTransform().Apply(input[i])));
+
+        figure.ResetTransform();
+        CHECK(figure.GetTransformKind() == TransformKind::Translation);
+    }
+
+    void CheckViewerIntent()
+    {
+        ViewerInput input;
+        input.SetPivot(0.25f, -0.5f);
+        input.KeyDown(ViewerKey::Translate);
+        input.KeyDown(ViewerKey::Right);
+        input.KeyUp(ViewerKey::Translate);
+        input.KeyDown(ViewerKey::Scale);
+        input.KeyDown(ViewerKey::Up);
+        input.KeyDown(ViewerKey::Left);
+        input.KeyUp(ViewerKey::Scale);
+
+        FrameIntent intent = input.TakeIntent();
+        CHECK(!intent.rotates);
+        HomogenVector p(0.3f, 0.7f, 1.0f);
+        CHECK(Near(intent.axisAligned.Apply(p), intent.transform.Apply(p)));
+
+        input.KeyDown(ViewerKey::Rotate);
+        input.KeyDown(ViewerKey::Right);
+        CHECK(input.TakeIntent().rotates);
+    }
+}
+
+int main()
+{
+    CheckKernelMatchesApply(Translate2D(0.25f, -1.5f));
+    CheckKernelMatchesApply(Scale2D(2.0f, -0.5f));
+    CheckKernelMatchesApply(ScaleTranslate2D(3.0f, 0.5f, 0.1f, 0.2f));
+    CheckKernelMatchesApply(Rotate2D::FromDegrees(33.0f));
+    CheckKernelMatchesApply(AboutPoint(Rotate2D::FromDegrees(-12.0f), 0.5f, 0.5f));
+
+    CheckFigureKind();
+    CheckViewerIntent();
+
+    return testing::Finish("test_typed_transforms");
+}
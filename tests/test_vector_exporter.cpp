@@ -0,0 +1,230 @@
+// test_vector_exporter.cpp - Exact SVG/JSON output, transform modes, escaping and float round trips
+#include "TestUtil.h"
+#include "../FigureVectorExporter.h"
+#include "../TextWriter.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+    const char *EXPORT_PATH = "test_vector_exporter.svg";
+
+    // x' = 1x + 2y + 5, y' = 3x + 4y + 6: en SVG, matrix(1 3 2 4 5 6)
+    TransformMatrix MakeAffine()
+    {
+        TransformMatrix t;
+        t.m[0][0] = 1.0f;
+        t.m[0][1] = 2.0f;
+        t.m[0][2] = 5.0f;
+        t.m[1][0] = 3.0f;
+        t.m[1][1] = 4.0f;
+        t.m[1][2] = 6.0f;
+        return t;
+    }
+
+    Figure MakeFigure(const TransformMatrix &transform)
+    {
+        Figure figure("a<b&\"c\"\\'\n");
+        figure.SetColor(Color(1.0f, 0.5f, 0.0f));
+        figure.AddPoint(0.0f, 0.0f);
+        figure.AddPoint(0.5f, 0.25f);
+        figure.AddPoint(-1.0f, 1.0f);
+        figure.ApplyTransform(transform);
+        return figure;
+    }
+
+    std::string Export(VectorFormat format, const Figure &figure, VectorTransformMode mode)
+    {
+        std::ostringstream output;
+        VectorExportOptions options;
+        options.transformMode = mode;
+        CHECK(WriteVectorFigure(output, format, figure, options));
+        return output.str();
+    }
+
+    const char *SVG_HEADER =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"800\" height=\"800\" viewBox=\"-1 -1 2 2\">\n"
+        "<g transform=\"scale(1,-1)\" fill=\"none\" stroke-linejoin=\"round\" stroke-width=\"2\">\n";
+    const char *SVG_FOOTER = "</g>\n</svg>\n";
+    const char *SVG_TITLE = "<title>a&lt;b&amp;&quot;c&quot;\\&apos;\n</title></polyline>\n";
+    const char *JSON_NAME = "{\"name\":\"a<b&\\\"c\\\"\\\\'\\u000a\",\"color\":[1,0.5,0],\"complete\":false,";
+
+    void CheckSvg()
+    {
+        Figure figure = MakeFigure(MakeAffine());
+
+        std::string applied = Export(VectorFormat::SVG, figure, VectorTransformMode::Apply);
+        CHECK(applied == std::string(SVG_HEADER) +
+                             "<polyline stroke=\"rgb(255,128,0)\" vector-effect=\"non-scaling-stroke\" "
+                             "points=\"5,6 6,8.5 6,7\">" + SVG_TITLE + SVG_FOOTER);
+
+        // Puntos originales y la matriz en el orden de SVG: a b c d e f = m00 m10 m01 m11 m02 m12
+        std::string attribute = Export(VectorFormat::SVG, figure, VectorTransformMode::Attribute);
+        CHECK(attribute == std::string(SVG_HEADER) +
+                               "<polyline stroke=\"rgb(255,128,0)\" vector-effect=\"non-scaling-stroke\" "
+                               "transform=\"matrix(1 3 2 4 5 6)\" points=\"0,0 0.5,0.25 -1,1\">" +
+                               SVG_TITLE + SVG_FOOTER);
+
+        // Sin transformación no hay atributo aunque se pida
+        Figure plain = MakeFigure(TransformMatrix::Identity());
+        plain.SetComplete(true);
+        std::string identity = Export(VectorFormat::SVG, plain, VectorTransformMode::Attribute);
+        CHECK(identity.find("transform=\"matrix") == std::string::npos);
+        CHECK(identity.find("<polygon ") != std::string::npos && identity.find("</polygon>") != std::string::npos);
+    }
+
+    void CheckProjectiveFallsBackToApplied()
+    {
+        // w' = 0.5x + w: no cabe en matrix(), así que se aplica aunque se pida el atributo
+        TransformMatrix projective;
+        projective.m[2][0] = 0.5f;
+        Figure figure("p");
+        figure.AddPoint(0.0f, 0.0f);
+        figure.AddPoint(1.0f, 0.5f);
+        figure.ApplyTransform(projective);
+
+        std::string svg = Export(VectorFormat::SVG, figure, VectorTransformMode::Attribute);
+        CHECK(svg.find("transform=\"matrix") == std::string::npos);
+        CHECK(svg.find("points=\"0,0 0.6666667,0.33333334\"") != std::string::npos);
+        CHECK(svg == Export(VectorFormat::SVG, figure, VectorTransformMode::Apply));
+
+        // JSON guarda la matriz entera, fila proyectiva incluida, con los puntos originales
+        std::string json = Export(VectorFormat::JSON, figure, VectorTransformMode::Attribute);
+        CHECK(json.find("\"transform\":[[1,0,0],[0,1,0],[0.5,0,1]],\"points\":[[0,0],[1,0.5]]") != std::string::npos);
+    }
+
+    void CheckJson()
+    {
+        Figure figure = MakeFigure(MakeAffine());
+
+        std::string applied = Export(VectorFormat::JSON, figure, VectorTransformMode::Apply);
+        CHECK(applied == std::string("{\"format\":\"figures\",\"version\":1,\"transformMode\":\"apply\",\"figures\":[\n") +
+                             JSON_NAME + "\"points\":[[5,6],[6,8.5],[6,7]]}\n]}\n");
+
+        std::string attribute = Export(VectorFormat::JSON, figure, VectorTransformMode::Attribute);
+        CHECK(attribute == std::string("{\"format\":\"figures\",\"version\":1,\"transformMode\":\"attribute\",\"figures\":[\n") +
+                               JSON_NAME + "\"transform\":[[1,2,5],[3,4,6],[0,0,1]],"
+                                           "\"points\":[[0,0],[0.5,0.25],[-1,1]]}\n]}\n");
+
+        // Varias figuras: una por línea, separadas por coma
+        FigureStore store;
+        std::vector<FigureHandle> handles = {store.Add(MakeFigure(MakeAffine())), store.Add(Figure("b"))};
+        std::ostringstream output;
+        CHECK(WriteVectorFigures(output, VectorFormat::JSON, FigureListView(store, handles)));
+        CHECK(output.str().find("]},\n{\"name\":\"b\",\"color\":[1,1,0],\"complete\":false,\"points\":[]}\n]}\n") !=
+              std::string::npos);
+    }
+
+    void CheckDeterministic()
+    {
+        Figure figure = MakeFigure(MakeAffine() * TransformMatrix::Rotation(33.0f));
+        for (int i = 0; i < 1000; ++i)
+            figure.AddPoint(std::sin(i * 0.1f) * 0.7f, std::cos(i * 0.37f) / 3.0f);
+
+        for (VectorFormat format : {VectorFormat::SVG, VectorFormat::JSON})
+        {
+            for (VectorTransformMode mode : {VectorTransformMode::Apply, VectorTransformMode::Attribute})
+            {
+                std::string first = Export(format, figure, mode);
+                CHECK(first == Export(format, figure, mode));
+                // Una copia de la figura da los mismos bytes
+                CHECK(first == Export(format, Figure(figure), mode));
+            }
+        }
+
+        // El archivo tiene los mismos bytes que el stream (binario: sin \r\n)
+        CHECK(ExportVectorFigure(EXPORT_PATH, figure));
+        std::ifstream file(EXPORT_PATH, std::ios::binary);
+        std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        CHECK(written == Export(VectorFormat::SVG, figure, VectorTransformMode::Apply));
+        file.close();
+        std::remove(EXPORT_PATH);
+    }
+
+    std::string FormatFloat(float value, const char *nonFinite = "0")
+    {
+        std::ostringstream output;
+        {
+            TextWriter writer(output);
+            writer.WriteFloat(value, nonFinite);
+        }
+        return output.str();
+    }
+
+    void CheckFloatRoundTrip()
+    {
+        CHECK(FormatFloat(0.0f) == "0" && FormatFloat(-0.0f) == "0");
+        CHECK(FormatFloat(1.0f) == "1" && FormatFloat(-2.5f) == "-2.5");
+        CHECK(FormatFloat(0.1f) == "0.1" && FormatFloat(1.0f / 3.0f) == "0.33333334");
+        CHECK(FormatFloat(std::numeric_limits<float>::infinity(), "null") == "null");
+        CHECK(FormatFloat(std::numeric_limits<float>::quiet_NaN()) == "0");
+
+        const float special[] = {FLT_MAX, -FLT_MAX, FLT_MIN, FLT_EPSILON, 1e-45f, 1.17549421e-38f, 16777216.0f,
+                                 16777217.0f, 1e10f, 123456789.0f, 3.4e38f, 1e-7f, 0.3f, 2.0f / 3.0f};
+        bool ok = true;
+        for (float value : special)
+        {
+            std::string text = FormatFloat(value);
+            ok = ok && std::strtof(text.c_str(), nullptr) == value;
+        }
+        CHECK(ok);
+
+        // Patrones de bits al azar (LCG fijo): todo lo finito vuelve al mismo float
+        uint32_t state = 12345u;
+        size_t checked = 0;
+        for (int i = 0; i < 200000; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            float value;
+            std::memcpy(&value, &state, sizeof(value));
+            if (!std::isfinite(value))
+                continue;
+            std::string text = FormatFloat(value);
+            if (std::strtof(text.c_str(), nullptr) != value)
+            {
+                std::printf("  %s does not read back as %.9g\n", text.c_str(), static_cast<double>(value));
+                ok = false;
+                break;
+            }
+            checked++;
+        }
+        CHECK(ok && checked > 190000);
+    }
+
+    void CheckEscaping()
+    {
+        std::ostringstream output;
+        {
+            TextWriter writer(output);
+            const char text[] = "q\"b\\s/t\tc\x01<&>'";
+            writer.WriteJsonString(text, sizeof(text) - 1);
+            writer.Put('|');
+            writer.WriteXmlText(text, sizeof(text) - 1);
+            writer.Put('|');
+            writer.WriteUnsigned(0);
+            writer.Put('|');
+            writer.WriteUnsigned(UINT64_MAX);
+        }
+        CHECK(output.str() == "\"q\\\"b\\\\s/t\\u0009c\\u0001<&>'\"|"
+                              "q&quot;b\\s/t\tc\x01&lt;&amp;&gt;&apos;|0|18446744073709551615");
+    }
+}
+
+int main()
+{
+    CheckSvg();
+    CheckProjectiveFallsBackToApplied();
+    CheckJson();
+    CheckDeterministic();
+    CheckFloatRoundTrip();
+    CheckEscaping();
+    return testing::Finish("test_vector_exporter");
+}
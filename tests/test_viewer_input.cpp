@@ -0,0 +1,125 @@
+// test_viewer_input.cpp - Synthetic key streams coalesce into one transform per frame
+#include "TestUtil.h"
+#include "../ViewerInput.h"
+#include <cmath>
+
+namespace
+{
+    bool Near(float a, float b, float tolerance = 1e-5f)
+    {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    bool SamePoint(const HomogenVector &a, const HomogenVector &b)
+    {
+        return Near(a.x, b.x) && Near(a.y, b.y) && a.w == b.w;
+    }
+
+    // Mantener modifier pulsada y repetir key count veces (auto-repetición)
+    void Repeat(ViewerInput &input, ViewerKey modifier, ViewerKey key, int count)
+    {
+        input.KeyDown(modifier);
+        for (int i = 0; i < count; ++i)
+            CHECK(input.KeyDown(key) == ViewerAction::Transform);
+        input.KeyUp(modifier);
+    }
+
+    void CheckTranslateBurst()
+    {
+        ViewerInput input;
+        CHECK(!input.HasPendingIntent());
+        Repeat(input, ViewerKey::Translate, ViewerKey::Right, 30);
+        Repeat(input, ViewerKey::Translate, ViewerKey::Down, 10);
+        CHECK(input.HasPendingIntent());
+
+        FrameIntent intent = input.TakeIntent();
+        CHECK(intent.eventCount == 40);
+        CHECK(Near(intent.translateX, 30 * 0.02f));
+        CHECK(Near(intent.translateY, -10 * 0.02f));
+        CHECK(!intent.rotates);
+        HomogenVector moved = intent.transform.Apply(HomogenVector(0.0f, 0.0f, 1.0f));
+        CHECK(Near(moved.x, 0.6f) && Near(moved.y, -0.2f));
+
+        // Lo tomado ya no está pendiente
+        CHECK(!input.HasPendingIntent());
+        CHECK(input.TakeIntent().IsEmpty());
+    }
+
+    void CheckScaleAboutPivot()
+    {
+        ViewerInput input;
+        input.SetPivot(0.4f, -0.3f);
+        Repeat(input, ViewerKey::Scale, ViewerKey::Right, 25);
+        Repeat(input, ViewerKey::Scale, ViewerKey::Up, 5);
+
+        FrameIntent intent = input.TakeIntent();
+        CHECK(Near(intent.scaleX, std::pow(1.01f, 25.0f), 1e-4f));
+        CHECK(Near(intent.scaleY, std::pow(1.01f, 5.0f), 1e-4f));
+        // El pivote no se mueve, con la composición afín y con la de escala
+        HomogenVector pivot(0.4f, -0.3f, 1.0f);
+        CHECK(SamePoint(intent.transform.Apply(pivot), pivot));
+        CHECK(SamePoint(intent.axisAligned.Apply(pivot), pivot));
+    }
+
+    void CheckRotationAccelerates()
+    {
+        ViewerInput input;
+        Repeat(input, ViewerKey::Rotate, ViewerKey::Right, 3);
+        FrameIntent intent = input.TakeIntent();
+        CHECK(intent.rotates);
+        // Pasos de 0.2, 0.4 y 0.6 grados
+        CHECK(Near(intent.rotateDegrees, 1.2f, 1e-4f));
+
+        Repeat(input, ViewerKey::Rotate, ViewerKey::Left, 1);
+        CHECK(Near(input.TakeIntent().rotateDegrees, -0.8f, 1e-4f));
+    }
+
+    void CheckOrderIsKept()
+    {
+        // Trasladar y luego escalar (sin pivote) no es lo mismo que al revés
+        ViewerInput input;
+        Repeat(input, ViewerKey::Translate, ViewerKey::Right, 10);
+        Repeat(input, ViewerKey::Scale, ViewerKey::Right, 10);
+        FrameIntent intent = input.TakeIntent();
+
+        HomogenVector p(0.1f, 0.2f, 1.0f);
+        HomogenVector expected = p;
+        for (int i = 0; i < 10; ++i)
+            expected.x += 0.02f;
+        for (int i = 0; i < 10; ++i)
+            expected.x *= 1.01f;
+        CHECK(SamePoint(intent.transform.Apply(p), expected));
+    }
+
+    void CheckNavigationAndRelease()
+    {
+        ViewerInput input;
+        CHECK(input.KeyDown(ViewerKey::Right) == ViewerAction::NavigateNext);
+        CHECK(input.KeyDown(ViewerKey::Left) == ViewerAction::NavigatePrevious);
+        CHECK(input.KeyDown(ViewerKey::Up) == ViewerAction::None);
+        CHECK(input.KeyDown(ViewerKey::Escape) == ViewerAction::Close);
+        CHECK(input.KeyDown(ViewerKey::Undo) == ViewerAction::Undo);
+        CHECK(input.KeyDown(ViewerKey::Other) == ViewerAction::None);
+        CHECK(!input.HasPendingIntent());
+
+        // Al perder el foco se sueltan los modificadores: la flecha vuelve a navegar
+        input.KeyDown(ViewerKey::Translate);
+        input.ReleaseModifiers();
+        CHECK(input.KeyDown(ViewerKey::Right) == ViewerAction::NavigateNext);
+
+        input.KeyDown(ViewerKey::Scale);
+        input.KeyDown(ViewerKey::Right);
+        input.DiscardIntent();
+        CHECK(!input.HasPendingIntent());
+    }
+}
+
+int main()
+{
+    CheckTranslateBurst();
+    CheckScaleAboutPivot();
+    CheckRotationAccelerates();
+    CheckOrderIsKept();
+    CheckNavigationAndRelease();
+    return testing::Finish("test_viewer_input");
+}